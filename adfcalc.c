@@ -0,0 +1,231 @@
+/****************************************************************************************
+ ****************** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *****************
+ *
+ *  File name: adfcalc.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This file contains the ADF4351 register calculator.  Calculates INT, FRAC,
+ *				MOD, RF divider, and band select clock divider from a target frequency.
+ *
+ *  File scope revision history:
+ *    10-19-26:      Rev 0.0:
+ *                   Initial file creation
+ *
+ *	Uses integer/rational math only (no floating point).  The VCO frequency is reduced to
+ *	INT + FRAC/MOD by the exact remainder of f(vco)/f(pfd) and the GCD of that remainder and
+ *	f(pfd).  This is the same result the ADF PLL application produces for the channels in
+ *	channels.c, so a register set calculated from its own frequency will match word for word.
+ *
+ *	R2, R3, and R5 (and the remaining R1/R4 control bits) come from a template register set
+ *	(normally the currently loaded channel) so that output power, charge pump, and lock-detect
+ *	settings are preserved.
+ *
+ *	The firmware only uses it for the "F" and "FV" cmds (FREQ_EN = 1 in main.c).  Leave this
+ *	file out of the target build when FREQ_EN = 0 (tools/chplan.c uses it on the host).
+ *
+ ***************************************************************************************/
+
+#include "typedef.h"
+#define ADFCALC_INCL
+#include "adfcalc.h"
+
+//------------------------------------------------------------------------------
+// Define Statements
+//------------------------------------------------------------------------------
+
+#define	R1_PRESCL	0x08000000L			// R1 bit 27: prescaler = 8/9
+#define	R1_MODMSK	0x00007ff8L			// R1 MOD field [14:3]
+#define	R2_DBL		0x02000000L			// R2 bit 25: reference doubler
+#define	R2_RDIV2	0x01000000L			// R2 bit 24: reference div by 2
+#define	R4_DIVMSK	0x00700000L			// R4 RF divider select [22:20]
+#define	R4_BSMSK	0x000ff000L			// R4 band select clock divider [19:12]
+
+//-----------------------------------------------------------------------------
+// Local Prototypes
+//-----------------------------------------------------------------------------
+
+U32 get_pfd(U32 r2);
+U32 gcd32(U32 a, U32 b);
+U32 mul_div(U32 a, U16 m, U32 b);
+
+//-----------------------------------------------------------------------------
+// adf_calc() calculates the ADF4351 register set for freq (10 Hz units).
+//	regs[] holds R0 - R5.  On entry, it is the template set.  On exit, R0, R1,
+//	and R4 are updated for the new frequency.  regs[] is not changed on error.
+//	Returns ADF_OK, ADF_APPROX, or an error code (ADF_RANGE, ADF_INTERR)
+//-----------------------------------------------------------------------------
+U8 adf_calc(U32 freq, U32* regs)
+{
+	U8	div;			// RF divider select (divide by 2^div)
+	U8	rtn = ADF_OK;	// return status
+	U16	intn;			// INT
+	U32	pfd;			// PFD frequency
+	U32	fvco;			// VCO frequency
+	U32	frac;			// FRAC
+	U32	mod;			// MOD
+	U32	g;				// temp
+	U32	r1;
+
+	if((freq < RF_MIN) || (freq > RF_MAX)){
+		return ADF_RANGE;
+	}
+	pfd = get_pfd(regs[2]);
+	if(pfd == 0){
+		return ADF_RANGE;
+	}
+	// find the RF divider that puts the VCO in range
+	fvco = freq;
+	for(div = 0; fvco < VCO_MIN; div++){
+		fvco <<= 1;
+	}
+	// INT + FRAC/MOD = fvco/pfd
+	intn = (U16)(fvco / pfd);
+	frac = fvco % pfd;
+	if(frac == 0){
+		mod = 2;										// integer-N, MOD must be >= 2
+	}else{
+		g = gcd32(frac, pfd);
+		frac /= g;
+		mod = pfd / g;
+		if(mod > MOD_MAX){
+			// FRAC/MOD can't be exact, round to the nearest 1/MOD_MAX
+			frac = mul_div(fvco % pfd, MOD_MAX, pfd);	// (fvco % pfd) * MOD_MAX would overflow for PFD > 10.48 MHz
+			mod = MOD_MAX;
+			if(frac == MOD_MAX){
+				frac = 0;
+				intn++;
+			}
+			g = gcd32(frac, mod);
+			if(g > 1){
+				frac /= g;
+				mod /= g;
+			}
+			if(mod < 2) mod = 2;
+			rtn = ADF_APPROX;
+		}
+	}
+	// prescaler: keep template setting unless the VCO is too high for 4/5
+	r1 = regs[1];
+	if(fvco > VCO_P45MAX){
+		r1 |= R1_PRESCL;
+	}
+	if(r1 & R1_PRESCL){
+		if(intn < 75) return ADF_INTERR;				// 8/9 min INT
+	}else{
+		if(intn < 23) return ADF_INTERR;				// 4/5 min INT
+	}
+	// band select clock = pfd/bsdiv <= 125 kHz
+	g = (pfd + BSEL_MAX - 1) / BSEL_MAX;
+	if(g > 255) g = 255;
+	// update registers
+	regs[0] = ((U32)intn << 15) | (frac << 3);
+	regs[1] = (r1 & ~R1_MODMSK) | (mod << 3);
+	regs[4] = (regs[4] & ~(R4_DIVMSK | R4_BSMSK)) | ((U32)div << 20) | (g << 12);
+	return rtn;
+}
+
+//-----------------------------------------------------------------------------
+// adf_freq() returns the RF out frequency (10 Hz units) of the register set
+//	in regs[] (R0 - R5).  Returns 0 if the frequency isn't a whole number of
+//	10 Hz units (or the register set is invalid).
+//-----------------------------------------------------------------------------
+U32 adf_freq(U32* regs)
+{
+	U8	div;			// RF divider select
+	U32	pfd;			// temps
+	U32	intn;
+	U32	frac;
+	U32	mod;
+	U32	fvco;
+	U32	g;
+
+	pfd = get_pfd(regs[2]);
+	intn = (regs[0] >> 15) & 0xffff;
+	frac = (regs[0] >> 3) & 0x0fff;
+	mod = (regs[1] >> 3) & 0x0fff;
+	div = (U8)(regs[4] >> 20) & 0x07;
+	if((pfd == 0) || (mod == 0) || (div > 6)){
+		return 0;
+	}
+	g = gcd32(frac, mod);								// reduce FRAC/MOD so that pfd * FRAC can't overflow
+	frac /= g;
+	mod /= g;
+	if(pfd % mod){
+		return 0;										// pfd * FRAC / MOD must be exact
+	}
+	fvco = (pfd * intn) + ((pfd / mod) * frac);
+	if(fvco & ((1 << div) - 1)){
+		return 0;										// fvco/div must be exact
+	}
+	return fvco >> div;
+}
+
+//-----------------------------------------------------------------------------
+// get_pfd() returns the PFD frequency (10 Hz units) set by R2, or 0 if invalid
+//	PFD = REFIN * (1 + D) / (R * (1 + T))
+//-----------------------------------------------------------------------------
+U32 get_pfd(U32 r2)
+{
+	U16	rcnt;			// R counter
+	U32	pfd;
+
+	rcnt = (U16)(r2 >> 14) & 0x03ff;
+	if(rcnt == 0){
+		return 0;
+	}
+	pfd = REF_FREQ;
+	if(r2 & R2_DBL) pfd <<= 1;
+	if(r2 & R2_RDIV2) rcnt <<= 1;
+	if(pfd % rcnt){
+		return 0;										// PFD must be a whole # of 10 Hz units
+	}
+	return pfd / rcnt;
+}
+
+//-----------------------------------------------------------------------------
+// gcd32() returns the greatest common divisor of a and b
+//-----------------------------------------------------------------------------
+U32 gcd32(U32 a, U32 b)
+{
+	U32	t;
+
+	while(b){
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+//-----------------------------------------------------------------------------
+// mul_div() returns a * m / b, rounded, without a 32 bit overflow of a * m.
+//	a < b < 2^31.  Shift-and-subtract long division, one bit of m per pass.
+//-----------------------------------------------------------------------------
+U32 mul_div(U32 a, U16 m, U32 b)
+{
+	U8	i;
+	U32	q = 0;			// quotient
+	U32	r = 0;			// remainder, always < b
+
+	for(i=16; i!=0; i--){
+		q <<= 1;
+		r <<= 1;
+		if(r >= b){
+			r -= b;
+			q++;
+		}
+		if(m & 0x8000){
+			r += a;
+			if(r >= b){
+				r -= b;
+				q++;
+			}
+		}
+		m <<= 1;
+	}
+	if(r >= (b - r)){
+		q++;											// round to nearest
+	}
+	return q;
+}
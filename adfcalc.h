@@ -0,0 +1,48 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: adfcalc.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the header file for the ADF4351 register calculator.
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:  creation date
+ *
+ *******************************************************************/
+
+//------------------------------------------------------------------------------
+// extern defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// public Function Prototypes
+//------------------------------------------------------------------------------
+
+U8 adf_calc(U32 freq, U32* regs);
+U32 adf_freq(U32* regs);
+
+//------------------------------------------------------------------------------
+// global defines
+//------------------------------------------------------------------------------
+
+// all frequencies are U32 in 10 Hz units (4.4 GHz = 440,000,000)
+#ifndef REF_FREQ
+#define	REF_FREQ	1000000L		// 10 MHz reference osc (host tools may override, see tools/chplan.c)
+#endif
+#define	RF_MIN		3437500L		// 34.375 MHz, min RF out
+#define	RF_MAX		440000000L		// 4400 MHz, max RF out
+#define	VCO_MIN		220000000L		// 2200 MHz, min VCO
+#define	VCO_P45MAX	360000000L		// 3600 MHz, max VCO for 4/5 prescaler
+#define	BSEL_MAX	12500L			// 125 kHz, max band select clock
+#define	MOD_MAX		4095			// max ADF4351 MOD
+
+// adf_calc() return codes
+#define	ADF_OK		0x00			// exact register set
+#define	ADF_APPROX	0x01			// MOD > 4095, FRAC/MOD rounded
+#define	ADF_RANGE	0x80			// freq out of range
+#define	ADF_INTERR	0x81			// INT too small for prescaler
@@ -0,0 +1,275 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: bench.c
+ *
+ *  Module:    Host tool (runs on the ucsim 8051 simulator)
+ *
+ *  Summary:   Cycle bench for the firmware hot paths.  The firmware sources are linked in with
+ *				main() renamed fw_main, and this main() times each case on Timer2, free running
+ *				(reload 0, intr off), so the counts are 8051 machine cycles on the ucsim 8052
+ *				model.  A case makes n calls between two Timer2 reads and reports the cycles per
+ *				call (less the empty loop, arg setup included) as a "name = n" line on the UART.
+ *
+ *				The ISRs are run by setting their intr flag.  They are all low priority and don't
+ *				nest, so the worst case intr latency is the longest ISR plus the longest instr
+ *				(MUL/DIV, 4 cycles) plus the LCALL to the vector.  fsel_isr() (port match) has no
+ *				flag to set on the 8052 model, it is 4 statements.
+ *
+ *				These are the classic 8051's 12 clock machine cycles, the F53x core runs most
+ *				instrs in 1 or 2 SYSCLKs.  Use them to compare builds, not as us.  The SPI status
+ *				waits read as ready (UCSIM_BENCH, hal.h), delay_us() on Timer0 is counted.
+ *				adf_calc() and adf_freq() (the F and FV cmds) are in a FREQ_EN = 1 build.
+ *
+ *  Build:     make -C bench bench (sdcc and ucsim's s51 in the PATH)
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#include "main.h"
+#include "typedef.h"
+#include "c8051F520.h"
+#include "serial.h"
+#include "cwconst.h"
+#include "hal.h"
+#if defined(FREQ_EN) && (FREQ_EN == 1)
+#include "channels.h"
+#include "adfcalc.h"
+#endif
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	N_REP		16				// calls per case
+#define	N_HEX		3				// put_hex() calls (2 chrs each, they must fit in the tx buffer, 7 chrs)
+#define	LAT_INSTR	6				// longest instr (4 cycles) + LCALL to the vector (2)
+#define	N_CALC		4				// adf_calc() and adf_freq() calls
+#define	CALC_FREQ	43228800L		// ch 01, 432.288 MHz (10 Hz units)
+
+#define	T2_GO()		{ TR2 = 0; HAL_T2_WR(0); TR2 = 1; }		// cycle count from 0
+#define	T2_STOP()	TR2 = 0
+
+//------------------------------------------------------------------------------
+// firmware (main.c, serial.c)
+//------------------------------------------------------------------------------
+
+INTERRUPT_PROTO_USING(Timer2_ISR, 5, 2);	// SDCC needs the ISRs visible where main() is
+INTERRUPT_PROTO_USING(ptt_isr, 0, 2);
+INTERRUPT_PROTO_USING(fsel_isr, 14, 2);
+
+U16 calcrc(U8 c, U16 oldcrc);
+U8 convnyb(U8 c);
+U8 getbyte(U8* dataptr);
+void put_hex(U8 dhex);
+void put_u16(U16 dval);
+void send_spi32(U32 plldata);
+void elem_task(void);
+
+extern idata S8	rxd_buff[];
+extern U8	rxd_hptr;
+extern U8	rxd_tptr;
+extern U8	rxd_crcnt;
+extern U8 code* cwptr;
+extern U8	cwmask;
+extern bit	elem_flag;
+extern bit	cw_on;
+extern bit	fsk_enable;
+extern bit	dfcw_enable;
+extern bit	dacmode;
+extern bit	ptt_arm;
+extern bit	ptt_hold;
+extern bit	spi_busy;
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+U16	cal;							// empty loop, cycles per pass
+U16	isr_max;						// longest ISR (cycles)
+#if defined(FREQ_EN) && (FREQ_EN == 1)
+U32	idata calc_regs[6];				// adf_calc() register set (ch 01's, R0 1st)
+#endif
+
+//------------------------------------------------------------------------------
+// Local Prototypes
+//------------------------------------------------------------------------------
+
+U16 rpt(char* name, U8 n);
+
+//-----------------------------------------------------------------------------
+// main()
+//-----------------------------------------------------------------------------
+void main(void){
+	volatile U8	i;
+	U8	b;
+	U16	crc;
+
+	PCA0MD = 0x00;									// WDT off
+	Init_Device();
+	init_serial();
+	ET2 = 0;										// Timer2 is the cycle counter
+	TMR2RLL = 0;
+	TMR2RLH = 0;
+	EA = 1;
+	putss("\nbench\n");
+	while(!txidle());
+	ES0 = 0;										// no UART intr in the timed loops
+
+	T2_GO();										// empty loop
+	for(i = 0; i < N_REP; i++);
+	T2_STOP();
+	cal = HAL_T2_RD() / N_REP;
+
+	crc = 0;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		crc = calcrc(i, crc);
+	}
+	T2_STOP();
+	rpt("calcrc", N_REP);
+
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		b = convnyb('a');
+	}
+	T2_STOP();
+	rpt("convnyb", N_REP);
+
+	for(i = 0; i < N_REP; i++){						// "5A" x N_REP in the rx buffer
+		rxd_buff[2 * i] = '5';
+		rxd_buff[(2 * i) + 1] = 'A';
+	}
+	rxd_tptr = 0;
+	rxd_hptr = 2 * N_REP;
+	rxd_crcnt = 0;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		getbyte(&b);
+	}
+	T2_STOP();
+	rpt("getbyte", N_REP);
+
+	T2_GO();
+	for(i = 0; i < N_HEX; i++){
+		put_hex(i);
+	}
+	T2_STOP();
+	rpt("put_hex", N_HEX);
+
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		send_spi32(0x00580005L);
+	}
+	T2_STOP();
+	rpt("send_spi32", N_REP);
+
+	dacmode = 0;									// the msg in cwconst.c, OOK w/o the DAC ramp
+	fsk_enable = 0;
+	dfcw_enable = 0;
+	cwptr = &diode_matrix[MSG_IDX-1];
+	cwmask = 0;
+	cw_on = 1;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		elem_flag = 1;
+		elem_task();
+	}
+	T2_STOP();
+	rpt("elem_task", N_REP);
+
+#if defined(FREQ_EN) && (FREQ_EN == 1)
+	for(i = 0; i < 6; i++){							// adf_calc() keeps the other reg bits
+		calc_regs[i] = pll_ch_array[6 + i];
+	}
+	T2_GO();
+	for(i = 0; i < N_CALC; i++){
+		adf_calc(CALC_FREQ, calc_regs);
+	}
+	T2_STOP();
+	rpt("adf_calc", N_CALC);
+
+	T2_GO();
+	for(i = 0; i < N_CALC; i++){
+		adf_freq(calc_regs);
+	}
+	T2_STOP();
+	rpt("adf_freq", N_CALC);
+#endif
+
+	// ISRs: the same loop with the flag set but the intr off is the baseline (the
+	//	loops differ only in which bit they set)
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		TF2H = 1;
+	}
+	T2_STOP();
+	cal = HAL_T2_RD() / N_REP;
+	ET2 = 1;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		TF2H = 1;
+	}
+	T2_STOP();
+	ET2 = 0;
+	isr_max = rpt("Timer2_ISR", N_REP);
+
+	rxd_tptr = 0;
+	rxd_hptr = 0;
+	ES0 = 1;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		RI0 = 1;
+	}
+	T2_STOP();
+	ES0 = 0;
+	crc = rpt("rxd_intr", N_REP);
+	if(crc > isr_max) isr_max = crc;
+
+	ptt_arm = 1;									// send the R4 frame
+	ptt_hold = 0;
+	spi_busy = 0;
+	IT0 = 1;
+	EX0 = 1;
+	T2_GO();
+	for(i = 0; i < N_REP; i++){
+		IE0 = 1;
+	}
+	T2_STOP();
+	EX0 = 0;
+	crc = rpt("ptt_isr", N_REP);
+	if(crc > isr_max) isr_max = crc;
+
+	putss("isr_lat_max = ");
+	put_u16(isr_max + LAT_INSTR);
+	putss("\nend\n");
+	ES0 = 1;
+	while(!txidle());
+	__asm
+		.db	0xa5									; invalid instr, s51 stops here
+	__endasm;
+}
+
+//-----------------------------------------------------------------------------
+// rpt() sends "name = cycles per call" for the last case and returns the count.
+//	Waits for the tx buffer to drain with the UART intr on, then turns it off
+//	again for the next case.
+//-----------------------------------------------------------------------------
+U16 rpt(char* name, U8 n){
+	U16	c;
+
+	c = (HAL_T2_RD() / n) - cal;
+	putss(name);
+	putss(" = ");
+	put_u16(c);
+	putss("\n");
+	ES0 = 1;
+	while(!txidle());
+	ES0 = 0;
+	return c;
+}
@@ -0,0 +1,52 @@
+# size.awk: code and RAM use of an SDCC build (bkn.map bkn.mem) against the budgets
+#	awk -v code_max=N -v stack_min=N -f size.awk x.map x.mem
+# Prints "key = value" lines, exits 1 if the code or the stack doesn't fit.
+#	.map area lines: NAME ADDR SIZE = DEC. bytes (ATTR), BSEG is in bits
+#	.mem: "Stack starts at: ... with N bytes available."
+
+FILENAME ~ /\.map$/ && / (bytes|bits) *\(/ {
+	name = $1
+	for(i = 2; i < NF; i++){
+		if($(i + 1) ~ /^(bytes|bits)$/){
+			n = $i
+			sub(/\.$/, "", n)
+			break
+		}
+	}
+	if(name in seen) next
+	seen[name] = 1
+	if(name == "CHSEG" || name == "CWSEG"){
+		tbl += n
+	}else if($NF ~ /CODE/){
+		code += n
+	}else if(name == "BSEG"){
+		bits += n
+	}else if(name ~ /^REG_BANK_/ || name == "BIT_BANK" || name == "DSEG" || name == "OSEG" || name == "DABS"){
+		dat += n
+	}else if(name == "ISEG" || name == "IABS"){
+		idat += n
+	}
+}
+
+FILENAME ~ /\.mem$/ && /bytes available/ {
+	for(i = 1; i < NF; i++){
+		if($(i + 1) == "bytes") stack = $i
+	}
+}
+
+END {
+	ram = dat + int((bits + 7) / 8) + idat
+	fit = (code <= code_max) && (stack >= stack_min)
+	print "sdcc.code = " (code + 0)
+	print "sdcc.code_max = " code_max
+	print "sdcc.tables = " (tbl + 0)
+	print "sdcc.data = " (dat + 0)
+	print "sdcc.bits = " (bits + 0)
+	print "sdcc.idata = " (idat + 0)
+	print "sdcc.ram = " ram
+	print "sdcc.ram_max = 256"
+	print "sdcc.stack = " (stack + 0)
+	print "sdcc.stack_min = " stack_min
+	print "sdcc.fit = " (fit ? "yes" : "no")
+	exit !fit
+}
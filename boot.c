@@ -0,0 +1,252 @@
+/****************************************************************************************
+ ****************** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *****************
+ *
+ *  File name: boot.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   UART bootloader.  Resident in flash sector 0, built as its own target
+ *				(boot.c + flash.c, small model, default startup) and loaded once with C2.
+ *				The app is then built with BOOT_EN = 1 (see main.c) and updated over the
+ *				UART with tools/bootld.c.
+ *
+ *				At reset the bootloader starts the app unless the app asked for an update
+ *				("XB" cmd, BOOT_MAGIC at BOOT_REQ) or the app image fails its length/CRC
+ *				check (APP_INFO).  BOOT_REQ overlays the app's warm restart block, so it
+ *				is only cleared on an update request (the app then cold starts); any
+ *				other reset leaves it for the app.  If the app is good and no host sends
+ *				BL_SYNC for BL_IDLE timeouts (~10 s), a sw reset returns to the app.
+ *				It then polls the UART at BOOT_BAUD (interrupts stay
+ *				off, all vectors forward to the app), erases the app sectors, writes the
+ *				image as it arrives with flash.c, re-reads it for the CRC, and writes
+ *				APP_INFO last.  The channel and msg sectors are not touched.
+ *				There is no room for a 2nd image on this part, so a failed or interrupted
+ *				update can't fall back to the old app: APP_INFO stays erased and the unit
+ *				stays in the bootloader (every reset) until a good image is loaded.
+ *
+ *  File scope revision history:
+ *    10-19-26:      creation date
+ *    10-19-26:      flash, UART, and app start through flash.h/hal.h, so sim/ (sim-boot) runs it
+ *
+ ***************************************************************************************/
+
+#include "typedef.h"
+#include "c8051F520.h"
+#include "flash.h"
+#include "boot.h"
+#include "hal.h"
+
+//------------------------------------------------------------------------------
+// Define Statements
+//------------------------------------------------------------------------------
+
+#define	BL_TMO		400000L			// rx timeout (~1 s of polling)
+#define	BL_IDLE		10				// # rx timeouts with no BL_SYNC before a good app is re-started
+#define	SWRSF		0x10			// RSTSRC sw reset
+#define	T1M			0x08			// CKCON: Timer1 on SYSCLK
+
+// interrupt vectors 0 - 14 (0x0003 + 8n) jump to the same offset in the app
+#define	VEC(n)		0x02, (U8)((APP_ADDR + 3 + (8 * n)) >> 8), (U8)(APP_ADDR + 3 + (8 * n)), \
+					0xff, 0xff, 0xff, 0xff, 0xff
+#if defined HOST_SIM
+#define	VEC_TBL		const U8 boot_vec[]		// host (sim/): not placed, there are no vectors
+#elif defined SDCC
+#define	VEC_TBL		code __at (0x0003) U8 boot_vec[]
+#else
+#define	VEC_TBL		U8 code boot_vec[] _at_ 0x0003
+#endif
+
+//-----------------------------------------------------------------------------
+// Variable Declarations
+//-----------------------------------------------------------------------------
+
+VEC_TBL = { VEC(0), VEC(1), VEC(2), VEC(3), VEC(4), VEC(5), VEC(6), VEC(7), VEC(8),
+			VEC(9), VEC(10), VEC(11), VEC(12), VEC(13),
+			0x02, (U8)((APP_ADDR + 0x73) >> 8), (U8)(APP_ADDR + 0x73) };
+
+LOCATED_VARIABLE_NO_INIT(boot_rq[2], U8, idata, BOOT_REQ);	// "XB" request (app's warm restart block)
+bit	bl_tmo;							// bl_getc() timed out
+
+//------------------------------------------------------------------------------
+// Local Prototypes
+//------------------------------------------------------------------------------
+
+U16 bl_crc(U8 c, U16 crc);
+U16 app_crc(U16 len);
+U8 app_ok(void);
+void bl_putc(U8 c);
+U8 bl_getc(void);
+U16 bl_getw(void);
+void bl_load(void);
+
+//******************************************************************************
+// main()
+//******************************************************************************
+void main(void)
+{
+	bit	stay;
+
+	PCA0MD = 0x00;								// disable watchdog
+	OSCICN = 0xC7;								// 24.5 MHz (f300_init.c), before the app CRC
+	stay = (boot_rq[0] == (U8)(BOOT_MAGIC >> 8)) && (boot_rq[1] == (U8)BOOT_MAGIC);
+	if(stay){
+		boot_rq[0] = 0;							// the app sees a cold start after the update
+		boot_rq[1] = 0;
+	}else{
+		if(app_ok()){
+			HAL_APP_JMP(APP_ADDR);				// start the app (fresh from reset, warm block intact)
+		}
+	}
+	P0MDOUT = 0x10;								// TX push-pull
+	P0SKIP |= 0x30;
+	XBR0 = 0x01;								// UART on the crossbar
+	XBR1 = 0x40;
+	CKCON = T1M;
+	TMOD = 0x20;								// Timer1 8 bit reload
+	TH1 = 0x96;									// SYSCLK / (2 * 106) = 115.5 kbaud
+	TR1 = 1;
+	SCON0 = 0x10;								// rx enabled
+	init_flash();								// VDD monitor on (required for flash writes)
+	while(1){
+		bl_putc('B');							// banner
+		bl_putc('L');
+		bl_putc('\r');
+		bl_putc('\n');
+		bl_load();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// bl_load() waits for BL_SYNC and loads one image.  Resets into the app if good.
+//-----------------------------------------------------------------------------
+void bl_load(void){
+	U8 xdata * fptr;
+	U16	len;
+	U16	i;
+	U16	crc = 0;
+	U8	c;
+	U8	n = 0;
+
+	do{
+		c = bl_getc();
+		if(bl_tmo && (++n == BL_IDLE) && app_ok()){
+			RSTSRC = SWRSF | PORSF;				// no host ("XB" by mistake), back to the app
+		}
+	}while(c != BL_SYNC);
+	len = bl_getw();
+	if(bl_tmo || !len || (len > APP_MAX)){
+		bl_putc(BL_FAIL);
+		return;
+	}
+	for(fptr = FLASH_X(APP_ADDR); fptr < FLASH_X(SECTCH_ADDR); fptr += SECTOR_SIZE){
+		erase_flash(fptr);						// app sectors incl. APP_INFO
+	}
+	bl_putc(BL_ACK);
+	fptr = FLASH_X(APP_ADDR);
+	for(i = 0; i < len; i++){
+		c = bl_getc();
+		if(bl_tmo){
+			bl_putc(BL_FAIL);
+			return;
+		}
+		wr_flash(c, fptr++);
+		crc = bl_crc(c, crc);
+		if(((i & (BL_BLK - 1)) == (BL_BLK - 1)) || (i == (len - 1))){
+			bl_putc(BL_ACK);					// block done, host sends the next
+		}
+	}
+	i = bl_getw();
+	if(bl_tmo || (i != crc) || (app_crc(len) != crc)){
+		bl_putc(BL_FAIL);						// APP_INFO stays erased
+		return;
+	}
+	fptr = FLASH_X(APP_INFO);
+	wr_flash((U8)(len >> 8), fptr++);
+	wr_flash((U8)len, fptr++);
+	wr_flash((U8)(crc >> 8), fptr++);
+	wr_flash((U8)crc, fptr);
+	bl_putc(BL_OK);
+	RSTSRC = SWRSF | PORSF;						// reset into the app
+}
+
+//-----------------------------------------------------------------------------
+// bl_crc() is calcrc() from main.c (xmodem poly 0x1021)
+//-----------------------------------------------------------------------------
+U16 bl_crc(U8 c, U16 crc){
+	U8	i;
+
+	crc ^= (U16)c << 8;
+	for(i = 0; i < 8; ++i){
+		if(crc & 0x8000) crc = (crc << 1) ^ 0x1021;
+		else crc = crc << 1;
+	}
+	return crc;
+}
+
+//-----------------------------------------------------------------------------
+// app_crc() returns the CRC16 of len bytes of app flash
+//-----------------------------------------------------------------------------
+U16 app_crc(U16 len){
+	U8 code * p = FLASH_C(APP_ADDR);
+	U16	crc = 0;
+
+	while(len--){
+		crc = bl_crc(*p++, crc);
+	}
+	return crc;
+}
+
+//-----------------------------------------------------------------------------
+// app_ok() returns 1 if the app image passes its length/CRC check (APP_INFO)
+//-----------------------------------------------------------------------------
+U8 app_ok(void){
+	U8 code * ip = FLASH_C(APP_INFO);
+	U16	len;
+
+	len = ((U16)ip[0] << 8) | ip[1];
+	if(!len || (len > APP_MAX)){
+		return 0;
+	}
+	return app_crc(len) == (((U16)ip[2] << 8) | ip[3]);
+}
+
+//-----------------------------------------------------------------------------
+// bl_putc() sends a chr (polled)
+//-----------------------------------------------------------------------------
+void bl_putc(U8 c){
+
+	HAL_UART_WR(c);
+	while(!TI0);
+	TI0 = 0;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// bl_getc() waits for a chr (polled).  Sets bl_tmo if none within BL_TMO.
+//-----------------------------------------------------------------------------
+U8 bl_getc(void){
+	U32	n = BL_TMO;
+
+	bl_tmo = 0;
+	while(!RI0){
+		if(--n == 0){
+			bl_tmo = 1;
+			return 0;
+		}
+	}
+	RI0 = 0;
+	return HAL_UART_RD();
+}
+
+//-----------------------------------------------------------------------------
+// bl_getw() gets a U16, MS byte 1st
+//-----------------------------------------------------------------------------
+U16 bl_getw(void){
+	U16	w;
+
+	w = (U16)bl_getc() << 8;
+	if(!bl_tmo){
+		w |= bl_getc();
+	}
+	return w;
+}
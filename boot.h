@@ -0,0 +1,44 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: boot.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the header file for the UART bootloader (boot.c) and the
+ *				app side of the update ("XB" cmd, BOOT_EN in main.c).  Include
+ *				after flash.h.
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:  creation date
+ *
+ *******************************************************************/
+
+//------------------------------------------------------------------------------
+// global defines
+//------------------------------------------------------------------------------
+
+// flash map with the bootloader:
+//	0x0000 - 0x01ff		bootloader (sector 0), vectors forward to APP_ADDR + vector
+//	0x0200 - 0x15fb		app (C51 INTVECTOR(0x0200), BL51 CODE(0x0200-0x15FB))
+//	0x15fc - 0x15ff		app info: length (U16), CRC16 (U16), MS byte 1st
+//	0x1600 -			channel and msg sectors (never touched by the bootloader)
+#define	APP_ADDR	0x0200			// app reset vector
+#define	APP_INFO	(SECTCH_ADDR - 4)
+#define	APP_MAX		(APP_INFO - APP_ADDR)
+
+#define	BOOT_REQ	0x80			// idata, 1st 2 bytes of the warm restart block (WARM_ADDR)
+#define	BOOT_MAGIC	0xB007			// "XB": stay in the bootloader after the sw reset
+
+// bootloader protocol (binary, BOOT_BAUD 8N1)
+//	host: BL_SYNC, len (U16), image in BL_BLK byte blocks, CRC16 (U16) of the image
+//	boot: "BL" banner, BL_ACK after the erase and after each block, BL_OK or BL_FAIL
+#define	BOOT_BAUD	115200L			// Timer1 on SYSCLK, TH1 = 0x96
+#define	BL_SYNC		'U'
+#define	BL_ACK		'.'
+#define	BL_OK		'K'
+#define	BL_FAIL		'F'
+#define	BL_BLK		256
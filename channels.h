@@ -1,31 +1,36 @@
-/*************************************************************************
- *********** COPYRIGHT (c) 2017 by Joseph Haas (DBA FF Systems)  *********
- *
- *  File name: channels.h
- *
- *  Module:    Control
- *
- *  Summary:   This is the header file for channels I/O.
- *
- *******************************************************************/
-
-
-/********************************************************************
- *  File scope declarations revision history:
- *    04-29-16 jmh:  creation date
- *
- *******************************************************************/
-
-//------------------------------------------------------------------------------
-// extern defines
-//------------------------------------------------------------------------------
-
-//------------------------------------------------------------------------------
-// public Function Prototypes
-//------------------------------------------------------------------------------
-
-extern U32 code pll_ch_array[];
-
-//------------------------------------------------------------------------------
-// global defines
-//------------------------------------------------------------------------------
+/*************************************************************************
+ *********** COPYRIGHT (c) 2017 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: channels.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the header file for channels I/O.
+ *
+ *******************************************************************/
+
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    04-29-16 jmh:  creation date
+ *    10-19-26:      HOST_SIM maps the array onto the flash model
+ *
+ *******************************************************************/
+
+//------------------------------------------------------------------------------
+// extern defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// public Function Prototypes
+//------------------------------------------------------------------------------
+
+#ifndef HOST_SIM
+extern U32 code pll_ch_array[];
+#else
+#define	pll_ch_array	((U32 *) FLASH_C(CHAN_ADDR))	// host: the channel data lives in the flash model (sim/)
+#endif
+
+//------------------------------------------------------------------------------
+// global defines
+//------------------------------------------------------------------------------
@@ -1,86 +1,87 @@
-/****************************************************************************************
- ****************** COPYRIGHT (c) 2018 by Joseph Haas (DBA FF Systems)  *****************
- *
- *  File name: cwconst.c
- *
- *  Module:    Control
- *
- *  Summary:   This is the default message data stored in FLASH memory (code space)
- *
- *  File scope revision history:
- *    04-20-17 jmh:  Rev 0.0:
- *                   Initial file creation
- *					 This source file holds the message data array in the top sectors of FLASH
- *
- *	To get the diode_matrix[] array to target a specific FLASH address, configure the linker (for Keil,
- *	this is in the options dialog, under BL51 Locate, enter "?CO?CWCONST(0x1800)" into the Code: field)
- *	to set the target address to 0x1800 to allow space for 1024 bytes of message elements.
- *
- ***************************************************************************************/
-#include "typedef.h"
-#include "main.h"
-#include "channels.h"
-	//
-	// constants for CW string support
-	//
-	// diode_matrix[] is an array of dit-length on/off intervals.
-	// terminating semaphore is 0x18 0xFF as this does not represent a valid element
-	// 1st 6 bytes hold key polaraity (U8), speed (U16), and message pause data (U16).
-
-	// W5AFY msg
-	U8 code diode_matrix[] = {
-		0x40,0x06,0x00,0x3C,0x13,0x88,0x19,0x25,0x3D,0x6E,0xAA,0xDB,0xF3,0xFF,
-		0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x5D,0xC2,0xAA,0x17,0x0A,0xE8,0x75,0xDC,
-		0x3A,0xBA,0x1D,0x50,0x00,0x21,0xDC,0x3B,0xBB,0xB8,0x55,0x70,0x18,0xFF
-	};
-
-	// KE0FF bkn
-/*	U8 code diode_matrix[] = {
-		0x40,0x00,0x00,0x3C,0x03,0xE8,
-		25, 37, 61, 110, 170, 219, 243, 255,
-		0x18,0xA0,0x18,0xC0,
-		0x00,0x00,0x00,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x00,0xAB,
-		0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x70,0x87,0x77,0x77,0x0A,0xE8,0x57,0x43,0xAB,0xA1,0xD5,0x00,0x02,0xAE,0x15,0x42,0xBA,0x00,0x00,
-		0x00,0x87,0x70,0xBB,0xBB,0x87,0x77,0x77,0x0E,0xE8,0x77,0x70,0x00,0x2E,0xBA,0x00,0x00,
-		0x18,0xA1,0x18,0xC1,
-		0x00,0x00,0x00,0xFF,0xFF,0xFF,0xFF,
-		0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x00,0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x70,0x87,
-		0x77,0x77,0x0A,0xE8,0x57,0x43,0xAB,0xA1,0xD5,0x00,0x02,0xB8,0x55,0x0A,0xE8,0x00,0x00,0x00,0x87,0x70,0xBB,0xBB,0x87,0x77,0x77,0x0E,0xE8,0x77,
-		0x70,0x00,0x2E,0xBA,0x00,0x00,0x18,0xFF
-	};*/
-
-	// K5LLL bkn
-/*	U8 code diode_matrix[] = {
-
-		0x01,0x04,0x00,0x50,0x27,0x10,
-		0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x0E,0x85,0x54,0x3A,0x87,0x57,0x0E,0xAE,0x87,0x54,0x00,0x00,0x3A,0x87,0x70,0xEE,0xEA,0x1D,
-		0xDD,0xDC,0x3A,0x15,0x70,0x00,0x00,0x00,0x18,0xFF
-	};*/
-
-	// dit stream
-/*	U8 code diode_matrix[] = {
-	0x01,			// key pol
-	0x04,			// ramp time (ms)
-	0x00,0x50,		// dit rate
-	0x00,0x00,		// MSG dly (ms)																				
-	0, 14, 40, 94, 161, 215, 241, 255,	// ramp table
-	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
-	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
-	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
-//	0x00,0x00,
-	0x18,0xFF
-	};
-*/	
-/*	// dash stream
-	U8 code diode_matrix[] = {
-	0x00,			// key pol
-	0x05,			// ramp time (ms)
-	0x00,0x50,		// dit rate
-	0x00,0x00,		// MSG dly (ms)
-	0x18,CW_CHSET|0x09,
-	0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,
-	0x00,0x00,
-	0x18,CW_CHADD|0x01,
-	0x18,CW_CHCLR|0x03,
-	0x18,0xFF
-	};*/
+/****************************************************************************************
+ ****************** COPYRIGHT (c) 2018 by Joseph Haas (DBA FF Systems)  *****************
+ *
+ *  File name: cwconst.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the default message data stored in FLASH memory (code space)
+ *
+ *  File scope revision history:
+ *    04-20-17 jmh:  Rev 0.0:
+ *                   Initial file creation
+ *					 This source file holds the message data array in the top sectors of FLASH
+ *
+ *	To get the diode_matrix[] array to target a specific FLASH address, configure the linker (for Keil,
+ *	this is in the options dialog, under BL51 Locate, enter "?CO?CWCONST(0x1800)" into the Code: field)
+ *	to set the target address to 0x1800 to allow space for 1024 bytes of message elements.
+ *
+ ***************************************************************************************/
+#include "typedef.h"
+#include "main.h"
+#include "channels.h"
+	//
+	// constants for CW string support
+	//
+	// diode_matrix[] is an array of dit-length on/off intervals.
+	// terminating semaphore is 0x18 0xFF as this does not represent a valid element
+	// 1st 6 bytes hold key polaraity (U8), speed (U16), and message pause data (U16).
+	// tools/msgc.c compiles a msg source into this array (the W5AFY msg is tools/w5afy.msg).
+
+	// W5AFY msg
+	U8 code diode_matrix[] = {
+		0x40,0x06,0x00,0x3C,0x13,0x88,0x19,0x25,0x3D,0x6E,0xAA,0xDB,0xF3,0xFF,
+		0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x5D,0xC2,0xAA,0x17,0x0A,0xE8,0x75,0xDC,
+		0x3A,0xBA,0x1D,0x50,0x00,0x21,0xDC,0x3B,0xBB,0xB8,0x55,0x70,0x18,0xFF
+	};
+
+	// KE0FF bkn
+/*	U8 code diode_matrix[] = {
+		0x40,0x00,0x00,0x3C,0x03,0xE8,
+		25, 37, 61, 110, 170, 219, 243, 255,
+		0x18,0xA0,0x18,0xC0,
+		0x00,0x00,0x00,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x00,0xAB,
+		0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x70,0x87,0x77,0x77,0x0A,0xE8,0x57,0x43,0xAB,0xA1,0xD5,0x00,0x02,0xAE,0x15,0x42,0xBA,0x00,0x00,
+		0x00,0x87,0x70,0xBB,0xBB,0x87,0x77,0x77,0x0E,0xE8,0x77,0x70,0x00,0x2E,0xBA,0x00,0x00,
+		0x18,0xA1,0x18,0xC1,
+		0x00,0x00,0x00,0xFF,0xFF,0xFF,0xFF,
+		0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x00,0x00,0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x70,0x87,
+		0x77,0x77,0x0A,0xE8,0x57,0x43,0xAB,0xA1,0xD5,0x00,0x02,0xB8,0x55,0x0A,0xE8,0x00,0x00,0x00,0x87,0x70,0xBB,0xBB,0x87,0x77,0x77,0x0E,0xE8,0x77,
+		0x70,0x00,0x2E,0xBA,0x00,0x00,0x18,0xFF
+	};*/
+
+	// K5LLL bkn
+/*	U8 code diode_matrix[] = {
+
+		0x01,0x04,0x00,0x50,0x27,0x10,
+		0xAB,0x85,0x5C,0x2A,0xE0,0x00,0x75,0x08,0x00,0x1D,0x0E,0x85,0x54,0x3A,0x87,0x57,0x0E,0xAE,0x87,0x54,0x00,0x00,0x3A,0x87,0x70,0xEE,0xEA,0x1D,
+		0xDD,0xDC,0x3A,0x15,0x70,0x00,0x00,0x00,0x18,0xFF
+	};*/
+
+	// dit stream
+/*	U8 code diode_matrix[] = {
+	0x01,			// key pol
+	0x04,			// ramp time (ms)
+	0x00,0x50,		// dit rate
+	0x00,0x00,		// MSG dly (ms)																				
+	0, 14, 40, 94, 161, 215, 241, 255,	// ramp table
+	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
+	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
+	0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,0xAE,
+//	0x00,0x00,
+	0x18,0xFF
+	};
+*/	
+/*	// dash stream
+	U8 code diode_matrix[] = {
+	0x00,			// key pol
+	0x05,			// ramp time (ms)
+	0x00,0x50,		// dit rate
+	0x00,0x00,		// MSG dly (ms)
+	0x18,CW_CHSET|0x09,
+	0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,0x77,
+	0x00,0x00,
+	0x18,CW_CHADD|0x01,
+	0x18,CW_CHCLR|0x03,
+	0x18,0xFF
+	};*/
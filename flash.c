@@ -1,84 +1,88 @@
-/****************************************************************************************
- ****************** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *****************
- *
- *  File name: flash.c
- *
- *  Module:    Control
- *
- *  Summary:   This file contains the flash scratchpad r/w routines.
- *
- *  File scope revision history:
- *    08-11-16 jmh:  Rev 0.0:
- *                   adapted from F120 version
- *
- ***************************************************************************************/
-
-#include "typedef.h"
-#include "c8051F520.h"
-//#include "stdio.h"
-#define FLASH_INCL
-#include "flash.h"
-
-//------------------------------------------------------------------------------
-// Define Statements
-//------------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// Variable Declarations
-//-----------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// flash initialization routine
-//-----------------------------------------------------------------------------
-void init_flash(void)
-{
-	VDDMON = 0xB0;
-	PSCTL = 0x00;
-	RSTSRC |= PORSF; 
-}
+/****************************************************************************************
+ ****************** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *****************
+ *
+ *  File name: flash.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This file contains the flash scratchpad r/w routines.
+ *
+ *  File scope revision history:
+ *    08-11-16 jmh:  Rev 0.0:
+ *                   adapted from F120 version
+ *    10-19-26:      MOVX writes go through HAL_FLASH_WR (hal.h) for the host simulator
+ *    10-19-26:      init_flash() writes RSTSRC (no read-modify-write: the SWRSF flag read back
+ *                   after a software reset would be written back as a reset)
+ *
+ ***************************************************************************************/
 
-
-//-----------------------------------------------------------------------------
-// flash erase routine
-//	erases scratchpad sector pointed to by addr
-//-----------------------------------------------------------------------------
-U8 erase_flash(U8 xdata * addr)
-{
-	U8	EA_save;
-	U8	rtn;
-
-	EA_save = EA;
-	EA = 0;							// interrupts = off
-	FLKEY = 0xA5;					// unlock FLASH
-	FLKEY = 0xF1;
-	rtn = FLKEY;
-	if(rtn != 0x02){
-		rtn |= 0x80;
-	}
-	PSCTL = PSEE|PSWE;				// enable erase/movx
-	*addr = 0xff;					// erase sector
-	PSCTL = 0x00;					// disbale erase
-	EA = EA_save;					// restore intr
-	return rtn;
-}
+#include "typedef.h"
+#include "c8051F520.h"
+//#include "stdio.h"
+#define FLASH_INCL
+#include "flash.h"
+#include "hal.h"
+
+//------------------------------------------------------------------------------
+// Define Statements
+//------------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Variable Declarations
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// flash initialization routine
+//-----------------------------------------------------------------------------
+void init_flash(void)
+{
+	VDDMON = 0xB0;
+	PSCTL = 0x00;
+	RSTSRC = PORSF;					// VDD monitor is a reset source (don't OR: see rev history)
+}
+
+
+//-----------------------------------------------------------------------------
+// flash erase routine
+//	erases scratchpad sector pointed to by addr
+//-----------------------------------------------------------------------------
+U8 erase_flash(U8 xdata * addr)
+{
+	U8	EA_save;
+	U8	rtn;
+
+	EA_save = EA;
+	EA = 0;							// interrupts = off
+	FLKEY = 0xA5;					// unlock FLASH
+	FLKEY = 0xF1;
+	rtn = FLKEY;
+	if(rtn != 0x02){
+		rtn |= 0x80;
+	}
+	PSCTL = PSEE|PSWE;				// enable erase/movx
+	HAL_FLASH_WR(addr, 0xff);		// erase sector
+	PSCTL = 0x00;					// disbale erase
+	EA = EA_save;					// restore intr
+	return rtn;
+}
+
+
+//-----------------------------------------------------------------------------
+// flash write routine
+//	writes byte to scratchpad sector pointed to by addr
+//-----------------------------------------------------------------------------
+void wr_flash(char byte, U8 xdata * addr)
+{
+U8	EA_save;
+
+	EA_save = EA;
+	EA = 0;							// interrupts = off
+	FLKEY = 0xA5;					// unlock FLASH
+	FLKEY = 0xF1;
+	PSCTL = PSWE;					// enable movx
+	HAL_FLASH_WR(addr, byte);		// write data
+	PSCTL = 0x00;					// disable flash wr
+	EA = EA_save;					// restore intr
+}
 
-
-//-----------------------------------------------------------------------------
-// flash write routine
-//	writes byte to scratchpad sector pointed to by addr
-//-----------------------------------------------------------------------------
-void wr_flash(char byte, U8 xdata * addr)
-{
-U8	EA_save;
-
-	EA_save = EA;
-	EA = 0;							// interrupts = off
-	FLKEY = 0xA5;					// unlock FLASH
-	FLKEY = 0xF1;
-	PSCTL = PSWE;					// enable movx
-	*addr = byte;					// write data
-	PSCTL = 0x00;					// disable flash wr
-	EA = EA_save;					// restore intr
-}
 
-
@@ -0,0 +1,91 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: hal.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   Hardware access seam.  The PLL/DAC SPI, latch enables, PCA timer reads,
+ *				UART data register (serial.c), and FLASH writes (flash.c) go through these
+ *				macros so that a host build can route them to simulated peripherals.
+ *				The other SFRs are plain variables in the host build (c8051F520.h).
+ *
+ *				HOST_SIM selects the host hooks.  sim/sim.c supplies them.
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *    10-19-26:      added the UART and FLASH write hooks for sim/
+ *    10-19-26:      UCSIM_BENCH: SPI status reads as ready for bench/
+ *    10-19-26:      HAL_APP_JMP (boot.c app start), sim/ runs the bootloader
+ *
+ *******************************************************************/
+
+#ifndef HAL_H
+#define HAL_H
+
+#ifndef HOST_SIM
+//------------------------------------------------------------------------------
+// C8051F52x target
+//------------------------------------------------------------------------------
+
+#ifndef UCSIM_BENCH
+#define	HAL_SPI_TXRDY()		(SPI0CN & 0x02)			// SPI tx buffer empty
+#define	HAL_SPI_DONE()		(SPI0CN & 0x80)			// SPI xfr done (SPIF)
+#else
+#define	HAL_SPI_TXRDY()		1						// bench/ (ucsim 8052 model): there is no SPI0
+#define	HAL_SPI_DONE()		1						//	to wait on, the cycle counts leave it out
+#endif
+#define	HAL_SPI_CLRF()		SPI0CN &= 0x7f			// clear SPIF
+#define	HAL_SPI_WR(d)		SPI0DAT = (d)			// send SPI byte
+#define	HAL_PLL_LE(x)		nPLL_LE = (x)			// PLL latch enable
+#define	HAL_DAC_CS(x)		KEYOUT = (x)			// DAC /CS (keyout pin in DAC-RAMP mode)
+#define	HAL_PCA_LO()		PCA0L					// read PCA0L 1st (latches PCA0H)
+#define	HAL_PCA_HI()		PCA0H
+#define	HAL_T2_RD()			(((U16)TMR2H << 8) | TMR2L)	// Timer2 count (TR2 clear)
+#define	HAL_T2_WR(v)		{ TMR2L = (U8)(v); TMR2H = (U8)((v) >> 8); }
+#define	HAL_UART_WR(c)		SBUF0 = (c)				// UART tx data
+#define	HAL_UART_RD()		SBUF0					// UART rx data
+#define	HAL_FLASH_WR(a, d)	*(a) = (d)				// MOVX write/erase (PSCTL/FLKEY set by the caller)
+#define	HAL_APP_JMP(a)		((void (code *)(void)) (a))()	// boot.c: start the app
+
+#else
+//------------------------------------------------------------------------------
+// host build: hooks supplied by the simulator.  SPI xfrs complete at once, the
+//	simulator decodes the ADF4351/LTC2630 frames from the byte stream and the LE/CS
+//	edges, and the PCA and Timer2 counts come from its virtual clock.  The UART has separate
+//	tx and rx data registers, and FLASH writes go to the flash model.  The bootloader's app
+//	start (boot.c) ends in the simulator, there is no app in that build (sim-boot).
+//------------------------------------------------------------------------------
+
+void sim_spi_wr(U8 d);
+void sim_pll_le(U8 x);
+void sim_dac_cs(U8 x);
+U8 sim_pca_lo(void);
+U8 sim_pca_hi(void);
+U16 sim_t2_rd(void);
+void sim_t2_wr(U16 v);
+void sim_uart_wr(U8 c);
+U8 sim_uart_rd(void);
+void sim_flash_wr(U8 * a, U8 d);
+void sim_app_jmp(U16 a);
+
+#define	HAL_SPI_TXRDY()		1
+#define	HAL_SPI_DONE()		1
+#define	HAL_SPI_CLRF()
+#define	HAL_SPI_WR(d)		sim_spi_wr(d)
+#define	HAL_PLL_LE(x)		sim_pll_le(x)
+#define	HAL_DAC_CS(x)		sim_dac_cs(x)
+#define	HAL_PCA_LO()		sim_pca_lo()
+#define	HAL_PCA_HI()		sim_pca_hi()
+#define	HAL_T2_RD()			sim_t2_rd()
+#define	HAL_T2_WR(v)		sim_t2_wr(v)
+#define	HAL_UART_WR(c)		sim_uart_wr(c)
+#define	HAL_UART_RD()		sim_uart_rd()
+#define	HAL_FLASH_WR(a, d)	sim_flash_wr((a), (d))
+#define	HAL_APP_JMP(a)		sim_app_jmp(a)
+#endif
+
+#endif
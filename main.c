@@ -1,1507 +1,4248 @@
-/****************************************************************************************
- ****************** COPYRIGHT (c) 2018 by Joseph Haas (DBA FF Systems)  *****************
- *
- *  File name: main.c
- *
- *  Module:    Control
- *
- *  Summary:   This is the main code file for the ADF4351 PLL beacon application
- *
- *  Project scope revision history:
- *
- * !!!! Need to test key ramp timing logic. !!!!
- *
- *    11-19-18 jmh:  Rev 0.26, HWrevA/B/C (release candidate)
- *						Tweaked msg Read cmd to improve readability.
- *    10-07-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
- *						Added 2ms delay before VCO shutdown on channel init. to allow PLL to settle before controlling VCO/RFO
- *						CHdelta is now cleared by all chset commands.
- *						Corrected EOM semaphore.
- *						GPIO and CH cmds tested for ch0/1 and out 0/1.
- *						Fixed ramp in DAC mode (was ramping on every element).
- *						Re-coded PTT logic to incorporate PTTenab register.  An if() statement intercepts nPTT detect just prior
- *							to the PLL ipl2 branch.  This intercept enables the ipl2 branch to reset the PLL based on the current
- *							CH settings and sets PLLenab = 1.  The if() statement that previously intercepted nPTT now intercepts
- *							PLLenab as a wrapper to the original if().  PLLenab = 0 at the end of the wrapper.
- *						Updated beacon spreadsheet to implement new features (GPOUT, DAC, and FSK modes)
- *    09-09-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
- *						Debug of DAC ramp features.  Re-configured delay_halfbit to be a generic delay routine with a 16b
- *							parameter {now called delay_us()}.
- *						SPI flags were not indicating end of xfr as was previously thought.  Implemented several #defines
- *							to pass proper delays through delay_us().
- *						Re-mapped ramp profile to include offset for emitter follower deadband.  E-follower ramp shape is
- *							very close to the expected waveform.
- *						NEED TO REGRESSION TEST ...
- *    09-02-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
- *						Made provisions to support FSK CW.  Set channel is "key down" frequency, the next channel up
- *							is the "key up" frequency.  Sends reg1 & 0 to change frequencies.  PLL config needs to be
- *							such that no other registers change between the two FSK frequencies.  The key polarity byte
- *							in the message array holds the enable for FSK (bit 0x80).  KEY still activates as before, but
- *							there are no ramp timings applied in FSK mode.
- *						Started process to allow a DAC to be used to set the ramp.  Uses KEYOUT output as SPI strobe, and uses
- *							same SPI bits as ADF4351 to drive an SPI DAC.
- *							8 step ramp values, with 0.6V offset:
- *							Index	RAW DAC (8b)	Chart of ramp (1ms per step)
- *													0    ---> V(dac) --->    max
- *							000		25				   *
- *							001		37				    *
- *							010		61				      *
- *							011		110				           *
- *							100		170				                 *
- *							101		219				                      *
- *							110		243				                        *
- *							111		255				                         *
- *													0    ---> V(dac) --->    max
- *						DAC now integrated <TESTING UNDERWAY 9/9/18>.  Set bit 0x40 in the key polarity byte to enable the DAC.
- *							When enabled, the KEYOUT GPIO becomes the DAC strobe (/CS).  Data and clock for the DAC come
- *							from the PLL SPI.  The DAC is intended to drive a non-inverting op-amp to supply ramped 5V to
- *							the GVC buffer, or to a later amplifier stage.  Ramp time is 8ms, with the bulk of the voltage
- *							change happening in about 5ms.
- *							Will look at placing the ramp array (8 DAC values that hold the ramp shape) in the diode matrix
- *							space to allow the array to be tweaked or customized to meet the needs of a particular application.
- *    08-11-18 jmh:  Rev 0.24, HWrevA/B/C (release candidate)
- *						Changed delay_halfbit to use HW timer0 instead of for-loop
- *						converged delay halfbit into a single Fn for BB/HWSPI.  Now, base timer value changes based on
- *							compile directive.
- *    08-10-18 jmh:  Rev 0.23, HWrevA/B/C (release candidate)
- *						Added halfbit delay after PLL init to counteract the RC delay in the REVC PLL CS hardware
- *						Reduced the halfbit delay.  Was about 392 us (measured), reduced to 196 us.
- *    02-17-18 jmh:  Rev 0.22, HWrevA/B/C (release candidate)
- *						Fixed "i" command to re-sample CH inputs
- *						Added "ch add" command to add (or subtract using 2's complement numbers) to the existing
- *							channel#.  Allows relative channel addressing inside CW message.
- *						"ch clr" command clears dela ch if it is greater than the operand.
- *    02-04-18 jmh:  Rev 0.21, HWrevC (release candidate)
- *						Modified to support bit I/O using FSEL4-6
- *						0x18 EOM semaphore modified to support multiple features:
- *							msg format    Description						Spreadsheet syntax
- *							0x18 0xff	= end of message					]%
- *							0x18 0xe0	= add 1 to I/O bits [6:4]			]>
- *							0x18 0xd0   = subtract 1 from I/O bits [6:4]	]<
- *							0x18 0xcx   = set pll ch to "x"					]a-p (a = ch00, p = ch15, not case sensitive)
- *							0x18 0xbx   = add "x" to PLL ch, mask to 4bits	]a-p (a = ch00, p = ch15, not case sensitive)
- *							0x18 0x9x   = if deltach > "x", clr delch		]a-p (a = ch00, p = ch15, not case sensitive)
- *							0x18 0xax   = set I/O bits [6:4] to "x"			]0-7
- *							0x18 0x08   = NOP (bits [2:0] are don't care)	]8-f
- *
- *							The command semaphore must be byte aligned within the message space (which will thus byte align
- *							the operand).  This must be addressed by the external message pre-processor (e.g., the spreadsheet).
- *                      Since only 4 bits are now used to input ch#, the BCD restriction has been bypassed.
- *							This allows 16 channels to be selected with 4 bits.
- *						Changed cwptr increment protocol.  This allows CW_STOP commands to start at the 1st msg byte
- *							and also allows sequential commands in the message stream.
- *						Modified "R" to properly trap EOM (which is now a 2-byte semaphore)
- *						Added haradware SPI and #if construct to select bit-bang or hdwr
- *						Modified message CRC to calculate from the start of the message space, up to and including
- *							the 0xFF that follows the command semaphore.
- *    04-29-17 jmh:  Rev 0.1, HWrevC (release candidate)
- *						Modified to support revC hardware:
- *							inverted LE and LOCK
- *							moved CH01 to 144.1 MHz
- *						CRC check modified to checck only the # channels specified in NUM_CHAN
- *    04-18-17 jmh:  Beacon Rev 0.1 (prototype)
- *						Re-arranged code to set BCD channel on power-up only then turn output on/off
- *							based on PTT status.
- *	  04-20-17 jmh:		Completed CW keying structure.  Keying drives VCO enable for true on/off
- *							keying.  PB7 = digital key out (GND = key) to drive wave-shape control via
- *							buffer power soft on-off.  Digital output goes active essentially when the
- *							PLL output turns on, but leads PLL turn-off by 5ms.
- *						CW string is a "diode matrix" array.  The array is shifted MSb first at the
- *							dit rate.  A "1" bit turns on the output, "0" turns it off.  The length of
- *							the array must be stored in FLASH.  Also, the dit-period is stored in FLASH
- *							to allow it to be uploaded with the CW matrix and channel data.
- *						PTT will force the output on.  This disables serial commands as long as PTT = GND.
- *						Channel load only happens on power up.  Changing the BCD channel # requires a power
- *							cycle or reset.
- *						Temp register feature is not available with this SW version.
- *						Mem Map:
- *						Channel data:	0x1280		U32, ADF4351 register channels (50)
- *						key_polarity:	0x1800		U8,  1 for high key, 0 for low key
- *						dit_time:		0x1801		U16, ms/dit
- *						message_delay:	0x1803		U16, delay from end of CW msg to re-start (ms)
- *						CW String:		0x1805		U8[], bit string of CW elements, sent MSb first
- *    08-12-16 jmh:  Rev 1.0 (release candidate)
- *						PTT and serial functions added to basic ADF4351 upload framework
- *						Updated comments to capture command line features
- *						Updated C and BL configs to get mem allocation to work within the 256 byte limit.
- *							mem model: small
- *							code model: large
- *							specify idata for large RAM buffers and arrays
- *						Finalized FLASH workarounds to address loss of upper 2.5K of FLASH
- *    04-09-16 jmh:  Rev 0000:
- *                   Initial project code copied from GPSDO and cleaned
- *
- ***************************************************************************************/
-
-/****************************************************************************************
- *  File scope revision history:
- *  04-09-16 jmh:	creation date
- *
- ***************************************************************************************/
-
-#define	REVC_HW 	0		// 1 = build for rev C hardware, else set to 0 for rev A or B
-//#define	BB_SPI		1		// If defined, use bit-bang SPI code
-
-#ifdef BB_SPI
-	// BitBangSPI version uses HW timer0 to establish the bit-delay (200us, nominal)
-	// T0 has about 0.5us of delay per timer tic when configured for clock source = SYSCLK/12
-	// define 200us timer delay @24.5MHz/12 timer clock = (65536 - (400*0.5us))
-#define	HAFBIT	65136
-#define SH_DLY	0xfff0
-
-#else
-	// HWSPI version uses HW timer0 to establish quick delay (8us, nominal)
-	// T0 has about 0.5us of delay per timer tic when configured for clock source = SYSCLK/12
-	// define 8us timer delay @24.5MHz/12 timer clock = (65536 - (32*0.5us))
-#define	BYTDLY	0xFFDC
-#define SH_DLY	0xfff0
-#endif
-
-	// delay reg for 1ms = 65536 - (1ms/.5us) = 65536 - 2000 = 63536
-#define	MS_DLY	63536
-
-//--------------------------------------------------------------------------------------
-// main.c
-//      Uses a C8051F531-C-IT processor to program the ADF4351 PLL chip registers.
-//			20 pin TSSOP package.
-// *****
-//		Some housekeeping:
-//		Linker directive "?CO?CHANNELS(0x1680)" must be placed in the CODE SEGMENT command field
-//			of the Keil compiler (configuring for other compiler suites are left as an excercise).
-//			This places the channel data at the fixed FLASH location of 0x1680 which allows for
-//			the containing FLASH sectors to be erased and re-written.  Sectors are 256 bytes, so
-//			there is also 128 bytes of uncommitted FLASH between 0x1600 and 0x167F that are available
-//			for cal or other NV memory features (not currently supported).
-//
-//			When using Keil, "pll_ch = pll_ch_array;" must be placed in main().  Configuring
-//			this arrangement for other compiler suites is left as an excercise.
-//			This allows the SW to access the array at the fixed CODE location of 0x1680.
-//			This issues a warning in V5 of Keil, but not in V4.  Accepting the warning is thus far the only
-//			successful mitigation.
-//
-//			If a clean data build is needed (i.e., no channel data in the object file), "channels.c"
-//			can be removed from the project ("channels.h" header file must still be available to main.c)
-//			The "pll_ch_array" statement in main() illustrated above must be replaced by "pll_ch = (U32 *) CHAN_ADDR;"
-//			This will produce a SW obect that should load over into a part with an existing channel array
-//			without disturbing the array.
-//
-//			SW Updates should be distributed as a SW object and a default channel object to allow
-//			users the option to perform a clean load (load both objects) or just update the SW
-//			(load the SW object only).
-// *****
-//      Up to 16 PLL channels may be stored and recalled using a 4-bit binary input,
-//			GND true.  Channels are stored in top pages of FLASH, starting at 0x1680.  Unprogrammed,
-//			or blank, channels should contain 0xFFFFFFFF for all register entries.
-//
-//			The hardware is configured to use a 16-pin dual-row header
-//			  to input the channel select and PTT lines, C2D lines, and power.
-//			  PTT is used to select between CH00 (PTT = hi) or the channel at the FSEL inputs
-//			  (PTT = low).  If PTT funtion is not desired, it may be tied low.  This allows CH00
-//			  to be used as any other channel.  If PTT is to be used to key the output, CH00 must
-//			  contain a register set that disables the VCO (this is in the default compile load).
-//
-//		UART access supports external programming of channels.  Format is described below.
-//			The programming erases all channels, then loads them one channel at a time.  A PC app
-//			to manage the register input from the user and output to HEX format file
-//			would be helpful (TBD).  An Excel spreadsheet has been written that outputs Intel HEX
-//			or UART channel commands (see below).
-//
-//      The following resources of the F531 are used:
-//      24.000 MHz internal osc
-//
-//      UART: 9600 baud, Simple I/O protocol
-//
-//      Timer0: n/u
-//      Timer1: UART baud rate (9600 baud)
-//      Timer2: Application timer (1ms/tic)
-//
-//      ADC: reads Port1-4 (LMT85) for temperaure
-//
-//      PCA: n/u
-//
-//      SYSTEM NOTES:
-//		16 pin header for I/O (rev A, C):
-//		pin  1: +Vin (5-12V)	pin  2: GND
-//		pin  3: RS-232 TXD		pin  4: +3.3V
-//		pin  5: RS-232 RXD		pin  6: GND
-//		pin  7: /PTT			pin  8: FSEL 0
-//		pin  9: FSEL1			pin 10: FSEL 2
-//		pin 11: FSEL3			pin 12: GPIO_0
-//		pin 13: GPIO_1			pin 14: GPIO_2
-//		pin 15: KEY				pin 16: GND
-//
-//		Channels consist of 16, 32 bit x 6 register values that are sent to the PLL when selected.
-//		Channel data is stored in top FLASH sectors.  System only supports erase
-//			of the entire channel sector mem.  Upload of individual channels is allowed.
-//
-//			Note: this limits available code space to 5.5K (5632 bytes)
-//
-//		UART Command Line Protocol:
-//		EC
-//			Erase all PLL channels
-//			prompts "Erase all, press Y to accept" and waits 5 sec for input.  Any character
-//			other than upper-case "Y", or a delay of more than 5 sec will cause this command to abort.
-//
-//		EM
-//			Erase all message data
-//			prompts "Erase all, press Y to accept" and waits 5 sec for input.  Any character
-//			other than upper-case "Y", or a delay of more than 5 sec will cause this command to abort.
-//
-//		Mxxaaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
-//			Programs channel "xx" (xx is BCD ASCII '00' thru '99') with R0 (A), thru R5 (F) values
-//			Data is represented as ASCII hex
-//			spaces, commas, or tab characters (ASCII 0x08) may be present between channel data characters, but
-//			the line buffer limit is 62 characters, including the command and channel# characters.
-//			If any invalid data is received (non-space, non-numeric, non-hex), the command is aborted (with error message)
-//			Serial buffer is limited to 64 characters (including <CR>).
-//
-//		<<<NOT IMPLEMENTED ON BKN>>> t00aaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
-//			Programs temp channel with R0 (A), thru R5 (F) values.  It has the same syntax requirements
-//			as the "M" command. The temp channel allows a register set to be input to the Orion without
-//			setting it in FLASH.  Once set, the temp command overrides the BCD inputs.  PTT behaves normally
-//			and will not change the temp channel configuration.
-//			Selecting a new BCD channel, or programming a channel with the "M" command will cancel
-//			the temp channel.  The temp channel command must then be be re-entered if needed.
-//
-//		rxx
-//			Read channel "xx" (xx is BCD ASCII '00' thru '16')
-//		<<<NOT IMPLEMENTED ON BKN>>> rr
-//			Read temp channel
-//		r-
-//			Read all channels
-//			Channel data is output in the "M" entry format described above with spaces inserted
-//			between register fields.
-//
-//		<<<NOT IMPLEMENTED ON BKN>>> i
-//			re-send last resister set
-//
-//		z hhhh
-//		zm hhhh
-//			Calc CRC for channel array (m for message array) and compare to HEX value "hhhh".  Display "Pass/Fail"
-//		c
-//		cm
-//			Calc CRC for channel array (m for message array) and display as 4 digit HEX value
-//
-//		e
-//			echo command line.  This is a debug command that will echo the characters on the command line.
-//
-//		Q
-//			Query error status.
-//		QC
-//			Clear errors status.
-//
-//		Caaaaxxyyzz...\r
-//			program CW message string.  This includes the key polarity, dit time, and message delay
-//			params.
-//
-//		R
-//			Read CW message array (ascii hex)
-//
-//		L
-//			read PLL lock status
-//
-//		i
-//			re-init channel/message.  Must be issued following a PLL or message update, or to change channels (not needed
-//			for embedded message channel changes).
-//
-//		All commands are terminated with <CR> ('\r').
-//		Serial port does not echo characters.
-//
-//		Serial port sends power on message when reset.
-//		Serial port outputs current channel selection, CH#, when setting is changed or PTT is cycled.
-//
-//--------------------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// Includes
-//-----------------------------------------------------------------------------
-// compile defines
-//#define F360DK ON
-
-#define IS_MAINC
-#include "main.h"
-#include "typedef.h"
-#include "c8051F520.h"
-#include "serial.h"
-#include "channels.h"
-#include "cwconst.h"
-#include "flash.h"
-
-//-----------------------------------------------------------------------------
-// Definitions
-//-----------------------------------------------------------------------------
-
-//  see init.h for publuc #defines
-
-#define	PBMAX		50			// max channel #s (2-digit BCD input)
-#define	MAX_REG		24			// max bytes in an ADF4351 reg set
-#define	MAX_CHAN	49			// max # bcd channels allowed
-#define	PB_MASK		0x0F		// BCD port valid inputs
-//-----------------------------------------------------------------------------
-// External Variables
-//-----------------------------------------------------------------------------
-
-U8  spi_tmr = 0;
-
-//-----------------------------------------------------------------------------
-// Main Variables
-//-----------------------------------------------------------------------------
-
-// I/O port assignments
-
-sbit PB0		= P1^0;				// (i) button input 0
-sbit PB1		= P1^1;				// (i) button input 1
-sbit PB2		= P1^2;				// (i) button input 2
-sbit KEYOUT		= P1^7;				// (i) button input 7, retasked as CW KEY out
-sbit SCK        = P0^0;				// (o) SPI SCLK
-sbit MISO       = P0^1;				// (i) SPI MISO/LDET
-sbit MOSI       = P0^2;				// (o) SPI MOSI
-sbit nPTT		= P0^3;				// (i) /PTT input
-sbit nPLL_LE	= P0^7;				// (o) SPI LE
-
-#if REVC_HW == 1
-#define	LE_ON	1
-#define	LE_OFF	0
-#else
-#define	LE_ON	0
-#define	LE_OFF	1
-#endif
-
-#if REVC_HW == 1
-#define	PLL_LOCK	0
-#else
-#define	PLL_LOCK	1
-#endif
-
-//-----------------------------------------------------------------------------
-// Local variables
-//-----------------------------------------------------------------------------
-U16 waittimer;						// wait() function timer
-U16 msgtimer;						// msg delay timer
-bit	elem_flag;						// element timer registers for CW output
-bit	cw_on;
-U16	elem_timer;						// 10 ms granularity
-U16	elem_time;
-bit	dacmode;						// set if keyout = LTC2630
-#define	RF_ENAB		0x0020			// reg 4 bit 5 enables RF out
-#define	VCO_DISAB	0x0800			// reg 4 bit 11 disables VCO out
-
-U8	iplTMR; // = TMRIPL;            // timer IPL init flag
-U32 code * pll_ch;					// pointer to base of channel array (initialized in main())
-
-//-----------------------------------------------------------------------------
-// Local Prototypes
-//-----------------------------------------------------------------------------
-
-U8 valid_cw(U8 code * ptr);
-void send_spi32(U32 plldata);
-void delay_us(U16 dly);
-U16 calcrc(U8 c, U16 oldcrc);
-void wait(U16 waitms);
-//void pb_state(U8 imode);
-U32 *get_chan(U8 chanum);
-U8 conv_to_chnum(U8 portbits);
-void put_hex(U8 dhex);
-void put_dec(U8 dhex);
-U8 convnyb(U8 c);
-U8 getbyte(U8* dataptr);
-U8 whitespc(char c);
-void ramp(U8 updn);
-void send_spi8(U8 daccmd, U8 dacdata);
-void setkeyout(U8 updn);
-
-//******************************************************************************
-// main()
-//  The main function inits I/O and process inputs.
-//	sends PLL data to ADF4351 when channel select inputs change
-//
-//******************************************************************************
-void main(void) //using 0
-{
-	char c;				// temp term chr
-	bit	ipl;			// initial loop flag
-	bit	ipl2;			// PLL init flag
-	U8	i;				// loop counter
-	U8	j;				// loop counter
-	U8	k;				// loop counter
-	bit	flag;			// temp flag
-	bit	goteol;			// temp flag
-	U8	PBreg;			// PB memory
-	U8	PBtemp;			// PB temp holding
-	U8	PTTreg;			// PTT memory
-	U8	PTTenab;		// PTT enable latch
-	U8	CHtemp;			// channel temp
-	U8	CHdelta;		// channel temp
-	U8	CHrun;			// dynamic channel temp
-	bit	temp_active;	// temp reg active flag
-	bit loaderr;		// channel pgm error flag
-	bit	fsk_enable;		// holds the fsk enable mode
-	bit	last_key;		// last key status (for FSK)
-	U8	pgm_chnum;		// prog chan temp
-	U8	tempbyte;		// temp
-	U8	tempbyte2;		// temp
-	U8	temp_chan[24];	// temp channel register set (bytes)
-	U16 tempword;		// temp16
-	bit	z_temp;			// "z" cmd flag
-	U16	temp_crc;		// crc temp
-	U16 ii;				// crc temp
-	U32	reg4_32;		// ADF4351 reg 4 holding
-	U32	reg2_32;		// ADF4351 reg 2 holding
-	U32	reg1_32;		// ADF4351 reg 1 holding
-	U32	reg0_32;		// ADF4351 reg 0 holding
-	U32	reg01_32;		// ADF4351 reg 1 holding (FSK "off")
-	U32	reg00_32;		// ADF4351 reg 0 holding (FSK "off")
-	U32* tptr;			// reg pointer
-	U8* cwptr;			// cw pointer
-	U8	cwmask;			// cw bitmask
-	U8 xdata * fptr;	// flash pointer
-	U8 code * rptr;		// flash pointer
-	bit	key_dn;			// RF key (timer)
-	bit	erase_hold;		// erase hold flag
-	
-	// start of main
-	PCA0MD = 0x00;								// disable watchdog
-	// init MCU system
-	Init_Device();								// init MCU
-#ifndef	BB_SPI
-    XBR0      = 0x03;							// enable hdwr SPI on xbar
-    SPI0CN    = 0x01;							// enable hdwr SPI
-#endif
-	SCK = 0;									// init SPI pins
-	MISO = 1;
-	nPLL_LE = LE_OFF;
-	init_flash();								// init FLASH
-	P1 = 0x7F;									// enable port for input
-	PBreg = P1;									// init PB memory
-	PTTreg = ~nPTT;								// force PTT edge det for POR
-	pll_ch = pll_ch_array;						// set array to point to fixed location
-	init_serial();								// init serial module
-	// init module vars
-	iplTMR = TMRIPL;                        	// timer IPL init flag
-	cw_on = 0;									// turn off CW
-	msgtimer = 0;
-	key_dn = 0;
-	EA = 1;
-	wait(50);                               	// 50 ms delay
-	
-#if REVC_HW == 1
-	putss("\nADF4351 Beacon Exctr Ver 0.26, de ke0ff\n");	// send sw version msg to serial port
-#else
-	putss("\nADF4351 Beacon Exctr Ver A0.26, de ke0ff\n");	// send sw version msg to serial port
-#endif
-	put_dec(NUM_CHAN);							// include # channels supported
-	putss(" CH, gnd-true BCD, PTTin low = key down,\n");		// send help screen
-	putss("Serial cmd enabled\n");				// send help screen
-	if(RSTSRC & 0x40){
-		putss("FLERR\n");
-		RSTSRC &= ~0x40;
-	}
-//	KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// make key output inactive
-	KEYOUT = 1;									// make key output inactive (assume DAC ramp mode for now)
-	temp_active = 0;							// de-activate temp reg
-	loaderr = 0;								// init chan error status
-	ipl = 1;									// set initial loop
-	ipl2 = 1;									// init PLL
-	CHrun = 0xff;								// disable dynamic channel
-	last_key = 0;								// init last key memory
-	setkeyout(0xAA);							// init rampdac key mem
-	PTTenab = 0;								// open PTT latch
-
-	// main loop
-	while(1){
-		if(nPTT == 0){
-			ipl2 = 1;												// re-latch CH inputs (reset PLL)
-			CHrun = 0xff;
-			PTTenab = 1;											// enable PTT logic
-		}
-		if(ipl2 == 1){
-			ipl2 = 0;
-			if(CHrun == 0xff){
-				CHrun = 0;											// clear semaphore
-				CHdelta = 0;
-				msgtimer = 0;
-				key_dn = 0;
-				// process PTT/channels
-				PBtemp = (~P1) & PB_MASK;							// convert port to POS logic
-//				CHtemp = conv_to_chnum(PBtemp);						// convert port state to channel#
-				CHtemp = PBtemp & 0x0f;								// convert port state to channel#
-				putss("CH ");										// send status msg (at 9600 baud, this gives us > 10ms of debounce)
-				put_dec(CHtemp);									// print ch#
-				fsk_enable = (U8)diode_matrix[KEY_IDX] & FSK_MASK;	// get fsk mode bit
-				if(fsk_enable){
-					putss("FSK mode\n");
-				}
-				dacmode = (U8)diode_matrix[KEY_IDX] & DAC_MASK;		// get DAC mode bit
-				if(dacmode){
-					send_spi8(DAC_IREF, 0);							// set DAC to use internal ref
-					send_spi8(DAC_SET, 0);							// clear DAC
-					putss("DAC-RAMP enabled\n");
-				}
-				elem_time = ((U16)diode_matrix[DIT_IDX] << 8) | ((U16)diode_matrix[DIT_IDX+1]); // init element timer to slowest value
-				if(elem_time == 0xffff){
-					erase_hold = TRUE;
-					putss("dit time invalid\n");
-					cw_on = 0;
-				}else{
-					// validate message
-					rptr = (U8 code *) SECTCW_ADDR;					// set pointer to start of CW msg
-					rptr += MSG_IDX;
-					if(!valid_cw(rptr)){
-						erase_hold = TRUE;
-						putss("msg invalid\n");
-						cw_on = 0;
-					}else{
-						erase_hold = FALSE;
-					}
-				}
-				elem_timer = 1;
-			}
-			tempbyte2 = (CHtemp + CHdelta) & 0x0f;
-			tptr = get_chan(tempbyte2);								// calc tptr to R5 of correct channel array
-			if(*tptr == 0xffffffff){
-				tptr = get_chan(0);									// default to ch#00 if R5 is 0xffffffff (i.e., ch is empty)
-			}
-			tptr = tptr - 1;
-			reg4_32 = *tptr;										// get R4 value
-			tptr = tptr - 2;
-			reg2_32 = *tptr;										// get R2 value
-			tptr = tptr - 1;
-			reg1_32 = *tptr;										// get R1 value
-			reg01_32 = *(tptr+6);									// get R1 value from next channel
-			tptr = tptr - 1;
-			reg0_32 = *tptr;										// get R0 value
-			reg00_32 = *(tptr+6);									// get R0 value from next channel
-			tptr = tptr + 5;
-			for(i=6;i!=0;i--){
-				send_spi32(*tptr--);								// transfer channel data to PLL
-			}
-			wait(2);
-			if(!fsk_enable){
-				reg4_32 |= RF_ENAB | VCO_DISAB;						// set R4 value
-			}
-			send_spi32(reg4_32);									// keyup
-		}
-		if(!erase_hold){
-			// process PTT
-			// PTT = 1 turns off RF out (reg 4, bit 05 = 0), = 0 turns on RF (reg 4, bit 05 = 1).
-			//	!! channel data must have reg 4, bit 05 = 0 !!
-			if(PTTenab != 0){
-				if(nPTT == 0){
-					PTTenab = 0;									// disable PTT logic
-					cwptr = &diode_matrix[MSG_IDX-1];				// reset cw pointer
-					cwmask = 0;
-					msgtimer = 0;
-					cw_on = 0;
-					send_spi32(reg4_32 & (~VCO_DISAB));				// keydn
-					setkeyout(1);
-	//				KEYOUT = diode_matrix[KEY_IDX] & KEY_MASK;
-					while(nPTT == 0){
-					}
-					cw_on = 1;
-					setkeyout(0);
-	//				KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;
-	//				wait((U16)diode_matrix[RMP_IDX] & 0xff);
-					send_spi32(reg4_32);							// keyup
-					wait(100);										// wait to re-start
-				}
-				PTTenab = 0;
-			}
-			if((msgtimer == 0) && (cw_on == 0)){
-				cwptr = &diode_matrix[MSG_IDX-1];					// reset cw pointer
-				cwmask = 0;
-				cw_on = 1;
-			}
-			if(elem_flag){													// process element edge
-				elem_flag = 0;
-				if(!cwmask){
-					cwmask = 0x80;
-					cwptr += 1;
-					if(*cwptr == CW_STOP){									// CW_STOP = 0x18 is now a command indicator
-						++cwptr;											// point to parameter byte
-						tempbyte = *cwptr;									// get parameter byte (next byte after CW_STOP)
-						switch(tempbyte & 0xf0){							// mask cmd nybble and process switch
-							default:										// unrecognized params process as EOM
-							case CW_EOM:									// end of message
-								setkeyout(0);
-//								KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// turn off keyIO
-								wait((U16)diode_matrix[RMP_IDX] & 0xff);	// delay <ramp_delay> for wave shaping
-								send_spi32(reg4_32);						// transfer channel data to PLL (turn off RF)
-								msgtimer = ((U16)diode_matrix[DLY_IDX] << 8) | ((U16)diode_matrix[DLY_IDX+1] & 0xff);
-								cw_on = 0;
-								break;
-							
-							case CW_IOP:									// I/O++
-								i = P1 & 0x70;								// mask I/O bits
-								i = (i + 0x10) & 0x70;						// add 1 & mask I/O bits
-								P1 = (P1 & 0x8f) | i;						// update I/O
-								break;
-							
-							case CW_IOM:									// I/O--
-								i = P1 & 0x70;								// mask I/O bits
-								i = (i - 0x10) & 0x70;						// subtract 1 & mask I/O bits
-								P1 = (P1 & 0x8f) | i;						// update I/O
-								break;
-							
-							case CW_CHSET:									// set ch
-								CHtemp = tempbyte & 0x0f;					// get ch# (only recognizes lower 4 bits)
-								CHrun = 0;									// make sure semaphore is clear
-								CHdelta = 0;
-								ipl2 = 1;									// reset channel only
-								break;
-							
-							case CW_CHADD:									// add ch
-								CHdelta = (CHdelta + tempbyte) & 0x0f;		// add ch# (only recognizes lower 4 bits)
-								CHrun = 0;									// make sure semaphore is clear
-								ipl2 = 1;									// reset channel only
-								break;
-							
-							case CW_CHCLR:									// clr deltach
-								if(CHdelta > (tempbyte & 0x0f)){
-									CHdelta = 0;							// add ch# (only recognizes lower 4 bits)
-									CHrun = 0;								// make sure semaphore is clear
-									ipl2 = 1;								// reset channel only
-								}
-								break;
-							
-							case CW_IOSET:									// set I/O
-								if((tempbyte & 0x08) == 0){					// if bit 3 set, it is a NOP cmd
-									tempbyte &= 0x07;						// mask I/O bits
-									tempbyte <<= 4;							// align to I/O bits
-									P1 = (P1 & 0x8f) | tempbyte;			// mask off I/O bits and update I/O
-								}
-								break;
-						}
-						cwmask = 0;	 										// clear mask to trigger increment to next msg byte
-					}
-				}
-				if(fsk_enable){													// is FSK mode
-					if(*cwptr & cwmask){										// if element == "1"
-						if(!last_key){
-							setkeyout(1);
-//							KEYOUT = diode_matrix[0] & KEY_MASK;				// turn on keyIO
-							send_spi32(reg1_32);								// transfer FSK "ON" data to PLL
-							send_spi32(reg0_32);								// transfer FSK "ON" data to PLL
-						}
-						last_key = 1;											// update key memory
-					}else{														// else element == "0"
-						if(last_key){
-							setkeyout(0);
-//							KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;	// element = "0", turn off keyIO
-							send_spi32(reg01_32);								// transfer FSK "OFF" data to PLL
-							send_spi32(reg00_32);								// transfer FSK "OFF" data to PLL
-						}
-						last_key = 0;											// update key memory
-					}
-				}else{															// is OOK mode
-					if(*cwptr & cwmask){										// if element == "1"
-						if(dacmode){
-							send_spi32(reg4_32 & (~VCO_DISAB));					// transfer channel data to PLL (use DAC to ramp)
-							setkeyout(1);
-						}else{
-							setkeyout(1);
-							send_spi32(reg4_32 & (~VCO_DISAB));					// transfer channel data to PLL (use RC ramp)
-						}
-//						KEYOUT = diode_matrix[0] & KEY_MASK;					// turn on keyIO
-//						wait(1);
-					}else{														// else element == "0"
-						setkeyout(0);
-//						KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// element = "0", turn off keyIO
-//						wait((U16)diode_matrix[RMP_IDX] & 0xff);				// delay <ramp_delay> for wave shaping
-						send_spi32(reg4_32 & (~RF_ENAB));						// transfer channel data to PLL (turn off RF)
-					}
-				}
-				cwmask >>= 1;												// update cwmask
-			}
-		}
-		// process serial input
-		if(gotcr()){												// wait for a cr ('\r') to be entered
-			z_temp = 0;												// pre-clear "z" flag
-			do{
-				c = getch00();										// skip over leading control chrs
-			}while((c <= ESC) && (c != '\0'));
-			putch(c);
-			switch(c){
-				default:											// invalid command chr
-					do{
-						c = getch00();								// skip to EOL or end of input
-					}while((c != '\r') && (c != '\0'));
-				case '\r':											// empty line
-					break;
-				
-				case 'i':
-					rptr = (U8 code *) SECTCW_ADDR;					// set pointer to start of CW msg
-					rptr += MSG_IDX;
-					if((valid_cw(rptr)) && !((diode_matrix[DIT_IDX] == 0xff) && (diode_matrix[DIT_IDX+1] == 0xff))){
-						putss("\nRe-init");							// post prompt
-						erase_hold = FALSE;							// clear erase hold
-						cwptr = &diode_matrix[MSG_IDX];				// reset cw pointer
-						cwmask = 0x80;
-						msgtimer = 0;
-						cw_on = 1;
-						CHrun = 0xff;
-						ipl2 = 1;									// re-init PLL and dit time
-					}else{
-						putss("msg invalid\n");
-					}
-					break;
-				
-				case 'E':
-					c = getch00();
-					//erase first 3 sectors of FLASH where the channel data lives				
-					while(getch00());								// clean out serial buffer
-					if(c == 'C'){
-						putss("\nErase All PLL data, Press \"Y\" to cont...");		// Are you sure? prompt
-						fptr = (U8 xdata *)SECTCH_ADDR;				// set pointer to 1st sector of ch data
-						j = 1;										// # sect to erase
-					}
-					if(c == 'M'){
-						putss("\nErase CW Message, Press \"Y\" to cont...");		// Are you sure? prompt
-						fptr = (U8 xdata *)SECTCW_ADDR;				// set pointer to 1st sector of msg data
-						j = 3;										// # sect to erase
-					}
-					waittimer = 5000;								// set 5 sec timer
-					while((gotch00() == '\0') && (waittimer != 0)); // wait for user input
-					if(getch00() == 'Y'){							// if timeout, getch00 will return '\0' which will abort
-						putss("\nerasing:");
-						for(i=0; i<j; i++){
-							if(fptr < (FLASH_END - 1)){
-								erase_flash(fptr);					// erase sector
-							}
-							fptr += SECTOR_SIZE;					// set next sector
-							putch('.');								// display progress
-						}
-						putss("Erased!\n");							// announce completion
-						erase_hold = TRUE;							// set erase hold
-						cw_on = 0;
-						send_spi32(reg4_32);						// keyup
-					}else{
-						putss("Aborted.\n");						// abort msg
-					}
-					break;
-				
-				case 'e':
-					// echo terminal buffer
-					do{
-						c = getch00();				 				// get byte
-						putch(c);									// echo
-					}while(c != '\r');								// until cr
-					putch('\n');
-					break;
-				
-				case 'Q':
-					// error querry/clear
-					if(loaderr){									// display error status
-						putss("\nLoad errors\n");
-					}else{
-						putss("\nNO errors\n");
-					}
-					if(gotch00()){
-						if(getch00() == 'C'){
-							putss("Err status cleared\n");
-							loaderr = 0;							// clear error status
-						}
-					}
-					putch('\n');
-					break;
-
-				case 'z':
-					z_temp = 1;										// set "z" cmd flag
-				case 'c':
-					// calc CRC16 on channels
-					c = getch00();									// see if for CW msg
-					temp_crc = 0;
-					tempword = 0;
-					if(c == 'm'){
-						rptr = (U8 code *) SECTCW_ADDR;
-						do{
-							tempbyte = *rptr++;
-							tempword <<= 8;
-							tempword |= (U16)tempbyte & 0x00ff;
-							temp_crc = calcrc(tempbyte,temp_crc);
-						}while((tempword != CW_STOPW) && (rptr < (FLASH_END - 1)));
-					}else{
-						rptr = (U8 code *) CHAN_ADDR;
-						for(ii=0; ii<(24 * NUM_CHAN); ii++){
-							temp_crc = calcrc(*rptr++,temp_crc);
-						}
-					}
-					if(z_temp){										// do CRC compare if true
-						if(c == 'm'){
-							putss(" CMP CW CRC...");
-						}else{
-							putss(" CMP CRC16...");
-						}
-						j = 1;										// preset PASS
-						if(getbyte(&tempbyte)) j = 0;				// 1st CRC byte -- compare data fail
-						if((U8)(temp_crc >> 8) != tempbyte) j = 0;	// crc fail
-						if(getbyte(&tempbyte)) j = 0;				// 2nd CRC byte -- compare data fail
-						if((U8)(temp_crc & 0xff) != tempbyte) j = 0;	// crc fail
-						wait(1000);									// wait 1 sec
-						if(j){
-							putss("\nPASS\n");
-						}else{
-							loaderr = 1;							// set global fail
-							putss("\nFAIL\n");
-						}
-					}else{
-						if(c == 'm'){
-							putss("\nCW CRC = 0x");
-						}else{
-							putss("\nCRC16 = 0x");
-						}
-						put_hex((U8)(temp_crc >> 8));
-						put_hex((U8)(temp_crc & 0xff));
-						putss("\n");
-					}
-					break;
-				
-//				case 't':
-				case 'M':
-					// program reg
-					// syntax: Mxxaaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
-					// First, validate buffered data (xfr to temp array)
-					k = c;											// save cmd chr
-					flag = TRUE;									// default to data good
-					temp_active = 0;								// default to temp = inactive
-					c = getch00();
-					if((c < '0') || (c > '9')){						// check for valid bcd
-						flag = FALSE;
-					}
-					i = (c & 0x0f) << 4;							// ms nyb
-					c = getch00();
-					if((c < '0') || (c > '9')){
-						flag = FALSE;
-					}
-					i |= (c & 0x0f);								// ls nyb
-					pgm_chnum = conv_to_chnum(i);					// convert BCD to hex
-					if(pgm_chnum >= NUM_CHAN){
-						flag = FALSE;								// error
-					}
-					goteol = 0;
-					i = 0;											// init reg counter
-					while(flag && !goteol){
-						goteol = getbyte(&tempbyte); 				// get byte
-						if(!goteol){
-							temp_chan[i++] = tempbyte;
-						}
-						if(i == MAX_REG){
-							goteol = 1;								// force end if 24 bytes
-						}else{
-							if(goteol) flag = FALSE;				// end of data too soon, error
-						}
-					}
-					// Program data to FLASH
-					if(flag && (k == 'M')){
-						fptr = (U8 xdata *) CHAN_ADDR;				// set pointer to 1st ch
-						fptr += 24 * pgm_chnum;						// jump to ch#
-						for(i=0; i<24; i++){
-							wr_flash(temp_chan[i], fptr++);
-						}
-						putss("Chan pgmd!\n");						// announce completion
-					}else{
-						if(flag){
-							temp_active = 1;						// temp channel active
-							putss("Temp reg pgmd\n");				// announce temp reg programmed
-						}else{
-							putss("ERROR!\n");						// announce err
-							loaderr = 1;							// set error
-						}
-					}
-					// Complete
-					break;
-			
-				case 'r':
-					// read reg
-					// syntax: rxx
-					flag = TRUE;
-					goteol = TRUE;
-					putss("\n");
-					c = getch00();
-					if(c == '-'){
-						i = NUM_CHAN;								// send all chnnels
-						j = 0;
-						pgm_chnum = conv_to_chnum(j);				// convert BCD to hex
-					}else{
-						if((c < '0') || (c > '9')){					// check for valid BCD
-							flag = FALSE;
-						}
-						i = (c & 0x0f) << 4;						// ms nyb
-						c = getch00();
-						if((c < '0') || (c > '9')){
-							flag = FALSE;
-						}
-						i |= (c & 0x0f);							// ls nyb
-						pgm_chnum = conv_to_chnum(i);				// convert BCD to hex
-						if(pgm_chnum >= NUM_CHAN){
-							flag = FALSE;							// error
-							pgm_chnum = NUM_CHAN;
-						}
-						i = 1;										// just send 1 chan
-						j = pgm_chnum;
-					}
-					// read data from FLASH
-					if(flag){
-						if(goteol){
-							rptr = (U8 code *) CHAN_ADDR;			// set pointer to 1st ch
-							rptr += 24 * pgm_chnum;					// jump to ch#
-						}
-						do{
-							if(goteol){
-								putch('M');							// pre-amble
-								put_dec(j++);						// print ch#
-								putch(' ');
-							}else{
-								putss("t00 ");						// temp chan preamble
-							}
-							tempbyte = 0;							// use tempbyte to format register fields
-							for(k=0; k<24; k++){
-								if(goteol){
-									put_hex(*rptr++);				// display FLASH data
-								}else{
-									put_hex(temp_chan[k]);			// display temp reg data
-								}
-								if(++tempbyte == 4){
-									putch(' ');						// insert some formatting between 32bit words
-									tempbyte = 0;
-								}
-							}
-							putss("\n");
-						}while(--i != 0);
-					}else{
-						putss("CH_ERR!\n");
-					}
-					break;
-			
-				case 'R':
-					// read CW msg
-					// syntax: R
-					flag = TRUE;
-					goteol = TRUE;
-					putss("\n");
-					j = 28;
-					ii = 0;
-					// read data from FLASH
-					if(flag){
-						rptr = (U8 code *) SECTCW_ADDR;				// set pointer to 1st ch
-						tempbyte = 0;								// init end of message flag
-						tempbyte2 = 0;								// init cmd det flag
-						do{
-							putch('C');								// pre-amble
-							put_hex((U8)(ii >> 8));					// print idx
-							put_hex((U8)(ii & 0xff));
-							putch(' ');
-							do{
-								i = *rptr++;						// get msg byte
-								if(tempbyte2 == CW_STOP){			// if last byte == stop &&
-									if(i == CW_EOM){				// this byte == EOM,
-										tempbyte = CW_STOP;			// end the whole listing
-									}
-								}
-								put_hex(i);							// display msg data
-								if(ii < MSG_IDX){
-									tempbyte2 = 0;					// no CW stop in 1st 5 bytes
-								}else{
-									tempbyte2 = i;					// save current chr for EOM det (requires 2 different chrs to end)
-								}
-								ii++;								// next index
-								j--;
-								if((ii == MSG_IDX) || (j == 0) || (tempbyte == CW_STOP)){
-									putss("\n");					// insert some formatting between lines
-									j = 28;							// reset line byte counter
-								}
-								if(rptr >= (FLASH_END - 1)){
-									tempbyte = CW_STOP;				// end of flash, terminate listing
-								}
-							}while((tempbyte != CW_STOP) && (j != 28) && (ii != MSG_IDX));
-						}while(tempbyte != CW_STOP);
-					}
-					break;
-
-				case 'C':
-					// program message string
-					// syntax: Caaaa xxyyzz...
-					//			aaaa = index to message string
-					//			xx/yy/zz = ASCII hex byte pairs to program
-					flag = TRUE;									// default to data good
-					goteol = getbyte(&i);							// get upper
-					goteol |= getbyte(&j);							// get lower
-					if(goteol){
-						flag = FALSE;								// index error
-					}
-					ii = ((U16)i << 8) | ((U16)j & 0x00ff);			// combine to get index
-					fptr = ((U8 xdata *) SECTCW_ADDR);	 			// set pointer to 1st msg array
-					fptr += ii;										// set index for incoming 
-					while(flag && !goteol){							// program string to flash
-						goteol = getbyte(&j);						// get data
-						if(!goteol){
-							wr_flash(j, fptr);
-/*							if(*fptr != j){
-								flag = FALSE;
-								putss("vfy err sb/is: ");
-								put_hex(j);
-								putss("/");
-								put_hex(*fptr);
-								putss("\n");
-							}*/
-							fptr += 1;
-						}
-						if(fptr == ((U8 xdata *) FLASH_END)){
-							flag = FALSE;							// force end if overrun
-						}
-					}
-					if(flag){
-						putss("Chan pgmd!\n");						// announce completion
-					}else{
-						putss("ERROR!\n");							// announce err
-						loaderr = 1;								// set error
-					}
-					// Complete
-					break;
-			
-				case 'l':
-				case 'L':
-					// read PLL lock bit
-					// syntax: l, return "1" or "0"
-					if(MISO == PLL_LOCK){
-						putss("1\n");
-					}else{
-						putss("0\n");
-					}
-					break;
-
-				case '?':
-					// Help screen
-					putss("\nOrion Help Ver0.26 11-19-18\n");
-					putss("Mnna..f: PGM CH nn\n");
-					putss("EC: erase all CH\t\tEM: erase msg\n");
-					putss("c: disp ch CRC16 (0x1021 poly)\tz hhhh: cmp CRC16\n");
-					putss("cm: disp msg crc \t\tzm hhhh: cmp msg crc\n");
-					putss("rnn: read CH nn\t\t\tr-: read all CH\n");
-					putss("Q: querry errs\t\t\tQC: Clr errs\n");
-					putss("i: re-send CH\t\t\te: echo cmdln\n");
-					putss("Ciiiidd..: Pgm CWmsg @IDX iiii\tL: read PLL lock stat\n");
-					putss("R: read CW msg\n");
-					break;
-			}
-			cleanline();											// clean up rest of current line
-			putss("\nbkn>");										// post prompt
-		}
-	}
-}  // end main()
-
-// *********************************************
-//  *************** SUBROUTINES ***************
-// *********************************************
-
-//-----------------------------------------------------------------------------
-// valid_cw()
-//-----------------------------------------------------------------------------
-//
-// scans CW message space for a CW_STOP.  If none found before end of FLASH,
-//	return FALSE, else TRUE
-//
-U8 valid_cw(U8 code * ptr){
-	U8	i = FALSE;		// temp
-	
-	while((ptr != (FLASH_END - 1)) && !i){
-		if(*ptr++ == CW_STOP){
-			i = TRUE;
-		}
-	}
-	return i;
-}
-
-//-----------------------------------------------------------------------------
-// send_spi32
-//-----------------------------------------------------------------------------
-//
-// sends 32 bit word to ADS4351 via portB bit-bang SPI
-//
-void send_spi32(U32 plldata){
-#ifdef BB_SPI
-	U32	mask;
-
-	nPLL_LE = LE_ON;								// latch enab = low to clock in data
-	for(mask = 0x80000000; mask != 0; mask >>= 1){	// start shifting 32 bits starting at MSb
-		if(mask & plldata) MOSI = 1;				// set MOSI
-		else MOSI = 0;
-		delay_us(HAFBIT);							// delay half clock
-		SCK = 1;									// clock = high
-		delay_us(HAFBIT);							// delay remaining half
-		SCK = 0;									// clock low
-	}
-	delay_us(HAFBIT);								// delay for LE
-	nPLL_LE = LE_OFF;								// latch enab = high to latch data
-	delay_us(HAFBIT);								// pad intra-word xfers by a half bit
-	return;
-	
-#else
-	U8	i;	// loop temps
-	U8	d;
-	union Data32 {	// temp union to parse out 32b word to 8b pieces
-	   U32 l;
-	   U8 b[4];
-	} pllu;  
-
-	pllu.l = plldata;
-	nPLL_LE = LE_ON;								// latch enab = low to clock in data
-	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
-	for(i=0; i < 4; i++){							// shifting 32 bits 8 bits at a time
-		d = (U8)(pllu.b[i]);
-		while(!(SPI0CN & 0x02));					// wait for buffer to clear
-		SPI0DAT = d;
-	}
-	while(!(SPI0CN & 0x02));						// wait for buffer to clear
-	delay_us(BYTDLY);								// delay for LE
-	nPLL_LE = LE_OFF;								// latch enab = high to latch data
-	delay_us(SH_DLY);								// delay for RC pullup on revC CS line
-	return;
-#endif
-}
-
-//-----------------------------------------------------------------------------
-// delay_us
-//-----------------------------------------------------------------------------
-//
-// sets delay for spi SCK and for CS setup/hold
-//
-	// BitBang version uses for-loop to establish ~~200 us delay
-/*void delay_halfbit(void){
-	U16	i;
-	
-	for(i = 0; i < 500;){							// cheezy for-next-loop to set delay for bit-bang-spi
-													// 500 loops is approx 200us
-		i += 1;
-	}
-	return;	
-}*/
-
-void delay_us(U16 dly){								// for HWSPI, this fnd is just used to set reg-reg xfr delay
-
-	TH0 = (dly >> 8);								// prep timer registers for delay
-	TL0 = (dly & 0xFF);
-	TF0 = 0;
-	TR0 = 1;										// start timer
-	while(TF0 == 0);								// loop
-	TR0 = 0;										// stop timer
-	return;	
-}
-
-//-----------------------------------------------------------------------------
-// send_spi8
-//-----------------------------------------------------------------------------
-//
-// sends 8 bit DAC word to LTC2630 DAC via SPI
-//	Uses SPI for clock and data, and KEYOUT for /CS
-//	daccmd is the DAC command word
-//
-void send_spi8(U8 daccmd, U8 dacdata){
-#ifdef BB_SPI
-	U8	bi;			// loop temp
-	U8	mask;
-	U8	temp;
-
-	KEYOUT = 0;										// latch enab = low to clock in data
-	delay_us(SH_DLY);								// delay for LE
-	for(bi=0; bi<3; bi++){
-		temp = 0;
-		if(bi == 0) temp = daccmd;
-		if(bi == 1) temp = dacdata;
-		for(mask = 0x80; mask != 0x00; mask >>= 1){	// start shifting 24 bits starting at MSb
-			if(mask & temp) MOSI = 1;				// set MOSI
-			else MOSI = 0;
-			delay_us(HAFBIT);							// delay half clock
-			SCK = 1;									// clock = high
-			delay_us(HAFBIT);							// delay remaining half
-			SCK = 0;									// clock low
-		}
-	}
-	delay_us(SH_DLY);								// delay for LE
-	KEYOUT = 1;										// latch enab = high to latch data
-	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
-	return;
-	
-#else
-	KEYOUT = 0;										// latch enab = low to clock in data
-	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
-	while(!(SPI0CN & 0x02));						// wait for buffer to clear
-	SPI0DAT = daccmd;								// send cmd
-	while(!(SPI0CN & 0x02));						// wait for buffer to clear
-	SPI0DAT = dacdata;								// send data
-	while(!(SPI0CN & 0x02));						// wait for buffer to clear
-	SPI0CN = SPI0CN & 0x7f;							// clear irq
-	SPI0DAT = 0;									// send pads
-	while(!(SPI0CN & 0x80));						// wait for xfr dne
-	delay_us(BYTDLY);								// delay for LE
-	KEYOUT = 1;										// latch enab = high to latch data
-	delay_us(SH_DLY);								// delay for RC pullup on revC CS line
-	return;
-#endif
-}
-
-//-----------------------------------------------------------------------------
-// ramp() sends data to DAC to do 5ms ramp up (1) or dn (0)
-//	
-//-----------------------------------------------------------------------------
-//
-//	Index	%Full scale		RAW DAC (8b)	Chart of ramp (1ms per step)
-//	000		0				0				*
-//	001		5.3				14				 *
-//	010		15.8			40				    *
-//	011		36.8			94				         *
-//	100		63.1			161				                *
-//	101		84.2			215				                     *
-//	110		94.7			241				                        *
-//	111		100				255				                         *
-
-//U8	code ramp_array[] = { 0, 14, 40,  94, 161, 215, 241, 255};
-//U8	code ramp_array[] = {25, 37, 61, 110, 170, 219, 243, 255};		// ramp table with 0.6V low-end offset
-#define	RAMPLEN 8
-
-void ramp(U8 updn){
-	U8	ramp_idx;			// ramp array index
-	S8	i;					// temp
-	
-	if(updn){
-		for(i=0, ramp_idx=RTBL_IDX; i<RAMPLEN; i++, ramp_idx++){
-			send_spi8(DAC_SET, diode_matrix[ramp_idx]);
-			delay_us(MS_DLY);							// wait 1ms
-		}
-	}else{
-		for(i=0, ramp_idx=RTBLE_IDX-1; i<RAMPLEN; i++, ramp_idx--){
-			send_spi8(DAC_SET, diode_matrix[ramp_idx]);
-			delay_us(MS_DLY);							// wait 1ms
-		}
-	}
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// setkeyout() sets/clears keyout or does DAC ramp according to key mode status
-//	
-//-----------------------------------------------------------------------------
-//
-void setkeyout(U8 updn){
-static	U8	last_updn;			// ramp array index
-
-	if(updn == 0xAA){
-		last_updn = 0;
-		return;
-	}
-	if(dacmode){
-		if(last_updn != updn){
-			ramp(updn);												// perform ramp up or dn
-			last_updn = updn;
-		}
-	}else{
-		if(updn){
-			KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK);			// KEYOUT = tone on
-			delay_us(MS_DLY);
-		}else{
-			KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// KEYOUT = tone off
-			wait((U16)diode_matrix[RMP_IDX] & 0xff);
-		}
-	}
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// calcrc() calculates incremental crcsum using defined poly
-//	(xmodem poly = 0x1021).  oldcrc = 0x0000 for first call, c = data byte
-//-----------------------------------------------------------------------------
-U16 calcrc(U8 c, U16 oldcrc){
-#define	POLY 0x1021	// xmodem polynomial
-
-	U16 crc;
-	U8	i;
-	
-	crc = oldcrc ^ ((U16)c << 8);
-	for (i = 0; i < 8; ++i){
-		if (crc & 0x8000) crc = (crc << 1) ^ POLY; //0x1021;
-		else crc = crc << 1;
-	 }
-	 return crc;
-}
-
-//-----------------------------------------------------------------------------
-// wait() uses ms timer to establish a defined delay
-//-----------------------------------------------------------------------------
-
-void wait(U16 waitms)
-{
-
-    waittimer = waitms/MS_PER_TIC;					// convert ms to timer ticks
-	if(waittimer == 0) waittimer = 1;				// force at least 1 tick
-    while(waittimer != 0);							// wait for timer to expire
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// put_hex
-//-----------------------------------------------------------------------------
-//
-// sends 8b hex to serial port as ASCII
-//
-void put_hex(U8 dhex){
-	char	c;
-	
-	c = (dhex >> 4) + '0';							// convert low nybble to BCD
-	if(c > '9') c += 'A' - '9' - 1;					// if hex, convert to "A" - "F"
-	putch(c);										// send to terminal
-	c = (dhex & 0x0f) + '0';						// repeat above for hi nyb
-	if(c > '9') c += 'A' - '9' - 1;
-	putch(c);
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// put_dec
-//-----------------------------------------------------------------------------
-//
-// sends 8b hex to serial port as decimal ASCII
-//
-void put_dec(U8 dhex){
-	U8		d;		// bcd temp
-	U8 		i;		// temps
-	U8 		j;
-
-	if(dhex > 99){
-		putss(">>");								// error display
-	}else{
-		j = dhex / 10;								// convert to BCD
-		i = dhex - (j * 10);
-		d = (j << 4) | i;
-		put_hex(d);									// display as hex = display as BCD
-	}
-	return;
-}
-
-//--------------------------------------------------------------------------------------
-// getbyte() returns 1 if no EOL is encountered: processes ASCII byte into pointer location.
-//	skips spaces.  Other chars are data error.
-//	returns 1 if EOL or data error
-//--------------------------------------------------------------------------------------
-U8 getbyte(U8* dataptr){
-	U8	c;		// temps
-	U8	cc;
-	U8	temp;
-	U8	rtn = 0;	// default to !goteol rtn
-
-	do{												// 1st nyb, skip spaces & trap EOL
-		c = (U8)getch00();
-	}while(whitespc(c));
-	do{												// 2nd nyb, skip spaces & trap EOL
-		cc = (U8)getch00();
-	}while(whitespc(cc));
-	if((c <= ESC) || (cc <= ESC)){
-		rtn = 1;									// any cntl chr is interpreted as EOL
-	}else{
-		temp = convnyb(c);
-		if(temp > 0x0f) rtn = 2;					// error data
-		c = convnyb(cc);
-		if(c > 0x0f) rtn = 2;						// error data
-	}
-	if(!rtn){
-		*dataptr = (temp << 4) | c;
-	}
-	return rtn;
-}
-
-//--------------------------------------------------------------------------------------
-// whitespc() returns 1 if chr = space, comma, or tab, else returns 0
-//--------------------------------------------------------------------------------------
-U8 whitespc(char c){
-	U8 rtn = 0;	// temp rtn, default false
-
-	switch(c){
-		case ' ':
-		case ',':
-		case '\t':
-			rtn = 1;								// if defined whitespace chr, return true
-			break;
-	}
-	return rtn;
-}
-
-//--------------------------------------------------------------------------------------
-// convnyb() converts ASCII to bin nybble.  returns 0xff if non-hex ascii
-//--------------------------------------------------------------------------------------
-U8 convnyb(U8 c){
-	U8	rtn = 0xff;
-
-	if((c >= 'a') && (c <= 'z')) c -= 'a' - 'A';	// upcase
-	if((c >= '0') && (c <= 'F')){					// 1st validation step
-		rtn = (c - '0');							// passed, convert to BIN
-		if(rtn > 9){
-			rtn -= 'A' - '9' - 1;					// convert letters
-			if(rtn < 0x0a) rtn = 0xff;				// 2nd validation step (if true, fail)
-		}
-	}
-	return rtn;										// return result
-}
-
-//--------------------------------------------------------------------------------------
-// get_chan() returns pointer to R5 of specified channel data
-//--------------------------------------------------------------------------------------
-U32 *get_chan(U8 chanum){
-	U32 *ptemp;
-	
-	ptemp = pll_ch + (6 * chanum) + 5;				// channel pointer is base + #regs * ch# + 5
-	return ptemp;
-}
-
-//--------------------------------------------------------------------------------------
-// conv_to_chnum() converts dual-BCD port bits to channel# (0 = first channel)
-//	if invalid BCD, returns ch#0
-//--------------------------------------------------------------------------------------
-
-U8 conv_to_chnum(U8 portbits){
-	U8	i;				// temp return value
-	U8	r;				// temp regs
-	U8	s;
-	
-	r = portbits & 0x0f;							// get low BCD nyb
-	s = (portbits >> 4) & 0x0f;
-	if((r > 9) || (s > 9)){
-		i = 0;										// bcd error, default to ch#0
-	}else{
-		i = r + (s * 10);							// get integer version of 2 digit BCD
-	}
-//	if(i > MAX_CHAN){
-//		i = 0;										// if channel error, set to 0
-//	}
-	return i;
-}
-
-//-----------------------------------------------------------------------------
-// Timer2_ISR
-//-----------------------------------------------------------------------------
-//
-// Called when timer 2 overflows (NORM mode):
-//      updates app timers @ 10ms rate
-//		rate = (sysclk/12) / (65536 - TH:L)
-//
-//-----------------------------------------------------------------------------
-
-void Timer2_ISR(void) interrupt 5 using 2
-{
-
-    TF2H = 0;                           			// Clear Timer2 interrupt flag
-    if(waittimer != 0){                 			// g.p. delay timer
-        waittimer--;
-    }
-    if(msgtimer != 0){                 				// g.p. delay timer
-        msgtimer--;
-    }
-	if(cw_on){
-		if(--elem_timer == 0){
-			elem_flag = 1;
-			elem_timer = elem_time;
-		}
-	}
-}
-
-#undef IS_MAINC
-//**************
-// End Of File
-//**************
+/****************************************************************************************
+ ****************** COPYRIGHT (c) 2018 by Joseph Haas (DBA FF Systems)  *****************
+ *
+ *  File name: main.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the main code file for the ADF4351 PLL beacon application
+ *
+ *  Project scope revision history:
+ *
+ * !!!! Need to test key ramp timing logic. !!!!
+ *
+ *    10-19-26:      Rev 0.27, HWrevA/B/C
+ *						Added QRSS mode (key polarity byte bit 0x20).  The dit/delay fields count 10 ms tics (up to
+ *							655.34 s dits), and the CPU idles between timer intrs.
+ *						Added DFCW mode (key polarity byte bit 0x10).  A dah ("111" look-ahead) is sent for one dit
+ *							period on the next channel up (the FSK R1/R0 path).
+ *						Added sweep/hop playback ("S", "H", "SB" cmds, SWEEP_EN).  PCA0 is the timing reference.
+ *						Added the ADF4351 register calculator (adfcalc.c) and the "F"/"FV" cmds (FREQ_EN).
+ *						Channel loads wait for lock-detect ("LT" timeout) instead of a fixed 2 ms.
+ *						Added the lock supervisor (lock-detect sampled at 50 ms, channel re-sent on a loss, "LX").
+ *						PTT is on INT0.  The ISR sends the R4 frame, and PTT hold no longer stops the main loop.
+ *						FSEL inputs are debounced by Timer2 and switch the channel at the next element edge.  "K"
+ *							displays the PTT and FSEL latencies.
+ *						main() is a set of run-to-completion tasks, setkeyout() no longer waits ("W" pass time).
+ *						The CPU idles at the end of each pass, and SYSCLK drops to /8 in the msg pause and QRT
+ *							(THROTTLE_EN, "D").
+ *						Added the temp channel ("t", "t-", "rr") and the fine offset ("+", "-", "O").
+ *						Fast boot: the channel is loaded on the 1st pass, and the banner follows the 1st RF.
+ *						Enabled the WDT (PCA module 2).  WARM_EN keeps the msg state in upper idata for a warm
+ *							restart ("X", "XW", "XS").
+ *						Added the event trace ring ("T", "TB", TRC_EN) and tools/trcdec.c.
+ *						Added the "B" benchmark.
+ *						The SPI frames, PLL LE, DAC /CS, and PCA reads go through hal.h.
+ *						Sources build under SDCC as well (typedef.h and c8051F520.h macros, U32_MSB).
+ *						Added tools/msgc.c (msg compiler), tools/chplan.c (channel plans), and tools/progstn.c
+ *							(multi-port programming station).
+ *						Added Intel HEX record input (':' lines) for the channel and msg sectors.
+ *						Added the UART bootloader (boot.c, BOOT_EN, "XB", tools/bootld.c).
+ *						Added multi-drop mode ("@hh" line prefix, "A" cmd).
+ *						Added sim/, a host simulator ("make -C sim test" runs the scenarios and golden SPI traces).
+ *						RAM fit: the diagnostic switches default to 0, the cold globals are in idata, and the tx
+ *							buffer is 8 B.  bench/ checks the budgets.
+ *						Fixed: an FSEL change at an element edge is taken at that edge (was one edge late).
+ *						Fixed: the boot banner no longer delays the 1st element (was 15 ms late).
+ *    11-19-18 jmh:  Rev 0.26, HWrevA/B/C (release candidate)
+ *						Tweaked msg Read cmd to improve readability.
+ *    10-07-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
+ *						Added 2ms delay before VCO shutdown on channel init. to allow PLL to settle before controlling VCO/RFO
+ *						CHdelta is now cleared by all chset commands.
+ *						Corrected EOM semaphore.
+ *						GPIO and CH cmds tested for ch0/1 and out 0/1.
+ *						Fixed ramp in DAC mode (was ramping on every element).
+ *						Re-coded PTT logic to incorporate PTTenab register.  An if() statement intercepts nPTT detect just prior
+ *							to the PLL ipl2 branch.  This intercept enables the ipl2 branch to reset the PLL based on the current
+ *							CH settings and sets PLLenab = 1.  The if() statement that previously intercepted nPTT now intercepts
+ *							PLLenab as a wrapper to the original if().  PLLenab = 0 at the end of the wrapper.
+ *						Updated beacon spreadsheet to implement new features (GPOUT, DAC, and FSK modes)
+ *    09-09-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
+ *						Debug of DAC ramp features.  Re-configured delay_halfbit to be a generic delay routine with a 16b
+ *							parameter {now called delay_us()}.
+ *						SPI flags were not indicating end of xfr as was previously thought.  Implemented several #defines
+ *							to pass proper delays through delay_us().
+ *						Re-mapped ramp profile to include offset for emitter follower deadband.  E-follower ramp shape is
+ *							very close to the expected waveform.
+ *						NEED TO REGRESSION TEST ...
+ *    09-02-18 jmh:  Rev 0.25, HWrevA/B/C (release candidate)
+ *						Made provisions to support FSK CW.  Set channel is "key down" frequency, the next channel up
+ *							is the "key up" frequency.  Sends reg1 & 0 to change frequencies.  PLL config needs to be
+ *							such that no other registers change between the two FSK frequencies.  The key polarity byte
+ *							in the message array holds the enable for FSK (bit 0x80).  KEY still activates as before, but
+ *							there are no ramp timings applied in FSK mode.
+ *						Started process to allow a DAC to be used to set the ramp.  Uses KEYOUT output as SPI strobe, and uses
+ *							same SPI bits as ADF4351 to drive an SPI DAC.
+ *							8 step ramp values, with 0.6V offset:
+ *							Index	RAW DAC (8b)	Chart of ramp (1ms per step)
+ *													0    ---> V(dac) --->    max
+ *							000		25				   *
+ *							001		37				    *
+ *							010		61				      *
+ *							011		110				           *
+ *							100		170				                 *
+ *							101		219				                      *
+ *							110		243				                        *
+ *							111		255				                         *
+ *													0    ---> V(dac) --->    max
+ *						DAC now integrated <TESTING UNDERWAY 9/9/18>.  Set bit 0x40 in the key polarity byte to enable the DAC.
+ *							When enabled, the KEYOUT GPIO becomes the DAC strobe (/CS).  Data and clock for the DAC come
+ *							from the PLL SPI.  The DAC is intended to drive a non-inverting op-amp to supply ramped 5V to
+ *							the GVC buffer, or to a later amplifier stage.  Ramp time is 8ms, with the bulk of the voltage
+ *							change happening in about 5ms.
+ *							Will look at placing the ramp array (8 DAC values that hold the ramp shape) in the diode matrix
+ *							space to allow the array to be tweaked or customized to meet the needs of a particular application.
+ *    08-11-18 jmh:  Rev 0.24, HWrevA/B/C (release candidate)
+ *						Changed delay_halfbit to use HW timer0 instead of for-loop
+ *						converged delay halfbit into a single Fn for BB/HWSPI.  Now, base timer value changes based on
+ *							compile directive.
+ *    08-10-18 jmh:  Rev 0.23, HWrevA/B/C (release candidate)
+ *						Added halfbit delay after PLL init to counteract the RC delay in the REVC PLL CS hardware
+ *						Reduced the halfbit delay.  Was about 392 us (measured), reduced to 196 us.
+ *    02-17-18 jmh:  Rev 0.22, HWrevA/B/C (release candidate)
+ *						Fixed "i" command to re-sample CH inputs
+ *						Added "ch add" command to add (or subtract using 2's complement numbers) to the existing
+ *							channel#.  Allows relative channel addressing inside CW message.
+ *						"ch clr" command clears dela ch if it is greater than the operand.
+ *    02-04-18 jmh:  Rev 0.21, HWrevC (release candidate)
+ *						Modified to support bit I/O using FSEL4-6
+ *						0x18 EOM semaphore modified to support multiple features:
+ *							msg format    Description						Spreadsheet syntax
+ *							0x18 0xff	= end of message					]%
+ *							0x18 0xe0	= add 1 to I/O bits [6:4]			]>
+ *							0x18 0xd0   = subtract 1 from I/O bits [6:4]	]<
+ *							0x18 0xcx   = set pll ch to "x"					]a-p (a = ch00, p = ch15, not case sensitive)
+ *							0x18 0xbx   = add "x" to PLL ch, mask to 4bits	]a-p (a = ch00, p = ch15, not case sensitive)
+ *							0x18 0x9x   = if deltach > "x", clr delch		]a-p (a = ch00, p = ch15, not case sensitive)
+ *							0x18 0xax   = set I/O bits [6:4] to "x"			]0-7
+ *							0x18 0x08   = NOP (bits [2:0] are don't care)	]8-f
+ *
+ *							The command semaphore must be byte aligned within the message space (which will thus byte align
+ *							the operand).  This must be addressed by the external message pre-processor (e.g., the spreadsheet).
+ *                      Since only 4 bits are now used to input ch#, the BCD restriction has been bypassed.
+ *							This allows 16 channels to be selected with 4 bits.
+ *						Changed cwptr increment protocol.  This allows CW_STOP commands to start at the 1st msg byte
+ *							and also allows sequential commands in the message stream.
+ *						Modified "R" to properly trap EOM (which is now a 2-byte semaphore)
+ *						Added haradware SPI and #if construct to select bit-bang or hdwr
+ *						Modified message CRC to calculate from the start of the message space, up to and including
+ *							the 0xFF that follows the command semaphore.
+ *    04-29-17 jmh:  Rev 0.1, HWrevC (release candidate)
+ *						Modified to support revC hardware:
+ *							inverted LE and LOCK
+ *							moved CH01 to 144.1 MHz
+ *						CRC check modified to checck only the # channels specified in NUM_CHAN
+ *    04-18-17 jmh:  Beacon Rev 0.1 (prototype)
+ *						Re-arranged code to set BCD channel on power-up only then turn output on/off
+ *							based on PTT status.
+ *	  04-20-17 jmh:		Completed CW keying structure.  Keying drives VCO enable for true on/off
+ *							keying.  PB7 = digital key out (GND = key) to drive wave-shape control via
+ *							buffer power soft on-off.  Digital output goes active essentially when the
+ *							PLL output turns on, but leads PLL turn-off by 5ms.
+ *						CW string is a "diode matrix" array.  The array is shifted MSb first at the
+ *							dit rate.  A "1" bit turns on the output, "0" turns it off.  The length of
+ *							the array must be stored in FLASH.  Also, the dit-period is stored in FLASH
+ *							to allow it to be uploaded with the CW matrix and channel data.
+ *						PTT will force the output on.  This disables serial commands as long as PTT = GND.
+ *						Channel load only happens on power up.  Changing the BCD channel # requires a power
+ *							cycle or reset.
+ *						Temp register feature is not available with this SW version.
+ *						Mem Map:
+ *						Channel data:	0x1280		U32, ADF4351 register channels (50)
+ *						key_polarity:	0x1800		U8,  1 for high key, 0 for low key
+ *						dit_time:		0x1801		U16, ms/dit
+ *						message_delay:	0x1803		U16, delay from end of CW msg to re-start (ms)
+ *						CW String:		0x1805		U8[], bit string of CW elements, sent MSb first
+ *    08-12-16 jmh:  Rev 1.0 (release candidate)
+ *						PTT and serial functions added to basic ADF4351 upload framework
+ *						Updated comments to capture command line features
+ *						Updated C and BL configs to get mem allocation to work within the 256 byte limit.
+ *							mem model: small
+ *							code model: large
+ *							specify idata for large RAM buffers and arrays
+ *						Finalized FLASH workarounds to address loss of upper 2.5K of FLASH
+ *    04-09-16 jmh:  Rev 0000:
+ *                   Initial project code copied from GPSDO and cleaned
+ *
+ ***************************************************************************************/
+
+/****************************************************************************************
+ *  File scope revision history:
+ *  04-09-16 jmh:	creation date
+ *
+ ***************************************************************************************/
+
+// Build switches.  PLL_set_bkn.uvproj (no C51 Defines) is the release build, every switch as set
+//	here: sim-min runs it (sim/) and make -C bench sizes it (bench/results.txt).  The diagnostic
+//	switches (SWEEP_EN, TRC_EN, STATS_EN, FREQ_EN, WARM_EN) are off in it, each one alone is over
+//	the 256 B RAM budget.  sim (sim/Makefile FWFLAGS) builds them all on, make -C bench DEFS=-Dxx=1
+//	sizes one.
+#define	REVC_HW 	0		// 1 = build for rev C hardware, else set to 0 for rev A or B
+#ifndef SWEEP_EN
+#define	SWEEP_EN	0		// 1 = include sweep/hop playback cmds (S, H), 0 = omit to save code space and RAM
+#endif
+#define	THROTTLE_EN	1		// 1 = drop SYSCLK to SYSCLK/8 during msg pause and QRT, 0 = always full speed
+#ifndef TRC_EN
+#define	TRC_EN		0		// 1 = include the event trace ring ("T" cmd), 0 = omit to save RAM and code space
+#endif
+#ifndef STATS_EN
+#define	STATS_EN	0		// 1 = include the diagnostic stats and benches (W, D, K, B, LT log cmds), 0 = omit
+#endif
+#ifndef FREQ_EN
+#define	FREQ_EN		0		// 1 = include the register calculator cmds (F, FV, adfcalc.c), 0 = omit
+#endif
+#ifndef WARM_EN
+#define	WARM_EN		0		// 1 = keep the msg state in upper idata for a warm restart (16 B), 0 = cold starts
+#endif
+#ifndef BOOT_EN
+#define	BOOT_EN		0		// 1 = build to run under the UART bootloader (boot.c, "XB"), see housekeeping
+#endif
+//#define	BB_SPI		1		// If defined, use bit-bang SPI code
+
+#ifdef BB_SPI
+	// BitBangSPI version uses HW timer0 to establish the bit-delay (200us, nominal)
+	// T0 has about 0.5us of delay per timer tic when configured for clock source = SYSCLK/12
+	// define 200us timer delay @24.5MHz/12 timer clock = (65536 - (400*0.5us))
+#define	HAFBIT	65136
+#define SH_DLY	0xfff0
+
+#else
+	// HWSPI version uses HW timer0 to establish quick delay (8us, nominal)
+	// T0 has about 0.5us of delay per timer tic when configured for clock source = SYSCLK/12
+	// define 8us timer delay @24.5MHz/12 timer clock = (65536 - (32*0.5us))
+#define	BYTDLY	0xFFDC
+#define SH_DLY	0xfff0
+#endif
+
+	// delay reg for 1ms = 65536 - (1ms/.5us) = 65536 - 2000 = 63536
+#define	MS_DLY	63536
+
+//--------------------------------------------------------------------------------------
+// main.c
+//      Uses a C8051F531-C-IT processor to program the ADF4351 PLL chip registers.
+//			20 pin TSSOP package.
+// *****
+//		Some housekeeping:
+//		Linker directive "?CO?CHANNELS(0x1680)" must be placed in the CODE SEGMENT command field
+//			of the Keil compiler (configuring for other compiler suites are left as an excercise).
+//			This places the channel data at the fixed FLASH location of 0x1680 which allows for
+//			the containing FLASH sectors to be erased and re-written.  Sectors are 256 bytes, so
+//			there is also 128 bytes of uncommitted FLASH between 0x1600 and 0x167F that are available
+//			for cal or other NV memory features (not currently supported).
+//
+//			When using Keil, "pll_ch = pll_ch_array;" must be placed in main().  Configuring
+//			this arrangement for other compiler suites is left as an excercise.
+//			This allows the SW to access the array at the fixed CODE location of 0x1680.
+//			This issues a warning in V5 of Keil, but not in V4.  Accepting the warning is thus far the only
+//			successful mitigation.
+//
+//			If a clean data build is needed (i.e., no channel data in the object file), "channels.c"
+//			can be removed from the project ("channels.h" header file must still be available to main.c)
+//			The "pll_ch_array" statement in main() illustrated above must be replaced by "pll_ch = (U32 *) CHAN_ADDR;"
+//			This will produce a SW obect that should load over into a part with an existing channel array
+//			without disturbing the array.
+//
+//			SW Updates should be distributed as a SW object and a default channel object to allow
+//			users the option to perform a clean load (load both objects) or just update the SW
+//			(load the SW object only).
+//
+//			UART bootloader (BOOT_EN = 1): boot.c is a separate target (boot.c + flash.c) loaded once with C2
+//			into sector 0.  The app is then linked at APP_ADDR (C51 INTVECTOR(0x0200), BL51 CODE(0x0200-0x15FB)
+//			plus the "?CO?CHANNELS(0x1680)" entry), which leaves 5116 bytes for the app, so SWEEP_EN and/or
+//			TRC_EN may need to be 0.  "XB" resets into the bootloader, and tools/bootld.c sends the image
+//			(115.2 kbaud, CRC checked) and writes the length/CRC record at APP_INFO.  Channel and msg
+//			sectors are kept.  A failed update leaves the unit in the bootloader until a good image is sent.
+//			"make -C bench boot" checks its size against sector 0, sim-boot (sim/) runs it.
+// *****
+//      Up to 16 PLL channels may be stored and recalled using a 4-bit binary input,
+//			GND true.  Channels are stored in top pages of FLASH, starting at 0x1680.  Unprogrammed,
+//			or blank, channels should contain 0xFFFFFFFF for all register entries.
+//
+//			The hardware is configured to use a 16-pin dual-row header
+//			  to input the channel select and PTT lines, C2D lines, and power.
+//			  PTT is used to select between CH00 (PTT = hi) or the channel at the FSEL inputs
+//			  (PTT = low).  If PTT funtion is not desired, it may be tied low.  This allows CH00
+//			  to be used as any other channel.  If PTT is to be used to key the output, CH00 must
+//			  contain a register set that disables the VCO (this is in the default compile load).
+//
+//		UART access supports external programming of channels.  Format is described below.
+//			The programming erases all channels, then loads them one channel at a time.  A PC app
+//			to manage the register input from the user and output to HEX format file
+//			would be helpful (TBD).  An Excel spreadsheet has been written that outputs Intel HEX
+//			or UART channel commands (see below).  tools/chplan.c and tools/msgc.c also write upload
+//			scripts, and tools/progstn.c runs them on several units at once.
+//
+//      The following resources of the F531 are used:
+//      24.000 MHz internal osc (throttled to /8 during the msg pause and QRT, see THROTTLE_EN)
+//
+//      UART: 9600 baud, Simple I/O protocol
+//
+//      Timer0: n/u
+//      Timer1: UART baud rate (9600 baud)
+//      Timer2: Application timer (1ms/tic)
+//
+//      ADC: reads Port1-4 (LMT85) for temperaure
+//
+//      PCA: free running @ SYSCLK/12, used as the timing reference for lock and sweep measurements
+//			Module 2 is the WDT (32 ms at full clock).  Timer2 kicks it while main() checks in (WDT_MS).
+//
+//		STARTUP.A51 must keep IDATALEN = 0x80.  The warm restart state block (WARM_EN = 1) is at 0x80 (upper
+//			idata) and must not be cleared at reset.  "XB" (BOOT_EN = 1) passes its request to the bootloader
+//			in the same 2 bytes with either setting.
+//
+//      SYSTEM NOTES:
+//		16 pin header for I/O (rev A, C):
+//		pin  1: +Vin (5-12V)	pin  2: GND
+//		pin  3: RS-232 TXD		pin  4: +3.3V
+//		pin  5: RS-232 RXD		pin  6: GND
+//		pin  7: /PTT			pin  8: FSEL 0
+//		pin  9: FSEL1			pin 10: FSEL 2
+//		pin 11: FSEL3			pin 12: GPIO_0
+//		pin 13: GPIO_1			pin 14: GPIO_2
+//		pin 15: KEY				pin 16: GND
+//
+//		Channels consist of 16, 32 bit x 6 register values that are sent to the PLL when selected.
+//		Channel data is stored in top FLASH sectors.  System only supports erase
+//			of the entire channel sector mem.  Upload of individual channels is allowed.
+//
+//			Note: this limits available code space to 5.5K (5632 bytes)
+//
+//		UART Command Line Protocol:
+//		EC
+//			Erase all PLL channels
+//			prompts "Erase all, press Y to accept" and waits 5 sec for input.  Any character
+//			other than upper-case "Y", or a delay of more than 5 sec will cause this command to abort.
+//
+//		EM
+//			Erase all message data
+//			prompts "Erase all, press Y to accept" and waits 5 sec for input.  Any character
+//			other than upper-case "Y", or a delay of more than 5 sec will cause this command to abort.
+//
+//		Mxxaaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
+//			Programs channel "xx" (xx is BCD ASCII '00' thru '99') with R0 (A), thru R5 (F) values
+//			Data is represented as ASCII hex
+//			spaces, commas, or tab characters (ASCII 0x08) may be present between channel data characters, but
+//			the line buffer limit is 62 characters, including the command and channel# characters.
+//			If any invalid data is received (non-space, non-numeric, non-hex), the command is aborted (with error message)
+//			Serial buffer is limited to 64 characters (including <CR>).
+//
+//		t00aaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
+//			Programs temp channel with R0 (A), thru R5 (F) values.  It has the same syntax requirements
+//			as the "M" command. The temp channel allows a register set to be input to the Orion without
+//			setting it in FLASH.  Once set, the temp command overrides the BCD inputs.  PTT behaves normally
+//			and will not change the temp channel configuration.
+//			The temp channel is applied immediately.  If R2-R5 match the loaded register set, only R1/R0 are
+//			sent and the message keeps running, else the channel is re-loaded.  FSK/DFCW use the temp channel
+//			for both tones.  Selecting a new BCD channel, or programming a channel with the "M" command will
+//			cancel the temp channel.
+//		t-
+//			Cancel the temp channel and re-load the BCD selected channel.
+//
+//		rxx
+//			Read channel "xx" (xx is BCD ASCII '00' thru '16')
+//		rr
+//			Read temp channel
+//		r-
+//			Read all channels
+//			Channel data is output in the "M" entry format described above with spaces inserted
+//			between register fields.
+//
+//		<<<NOT IMPLEMENTED ON BKN>>> i
+//			re-send last resister set
+//
+//		z hhhh
+//		zm hhhh
+//			Calc CRC for channel array (m for message array) and compare to HEX value "hhhh".  Display "Pass/Fail"
+//		c
+//		cm
+//			Calc CRC for channel array (m for message array) and display as 4 digit HEX value.  The channel
+//			CRC runs over each U32 MS byte 1st (the "M" and HEX byte order), so it matches chplan on any build.
+//
+//		e
+//			echo command line.  This is a debug command that will echo the characters on the command line.
+//
+//		Q
+//			Query error status.
+//		QC
+//			Clear errors status.
+//
+//		Caaaaxxyyzz...\r
+//			program CW message string.  This includes the key polarity, dit time, and message delay
+//			params.
+//
+//		:nnaaaattdd..ddcc
+//			Intel HEX record (as the spreadsheet, chplan, and msgc ".hex" files), so an image can be pasted
+//			at line rate with no re-formatting.  No spaces: every chr after the ':' must be hex.  The record
+//			is checked in the rx buffer (hex chrs and checksum) before anything is written.  Data records
+//			(tt = 00) must lie in the channel or message sectors (SECTCH_ADDR up to FLASH_END) and are read
+//			back after the write.  Type 02/04 (extended address) must be 0, 03/05 are ignored.  The sectors
+//			must be erased first ("EC"/"EM").  Channel array bytes are MS byte 1st, as "M", and a
+//			little-endian build (SDCC, host) stores each U32 native.
+//			Bad records display "ERROR!" and set the load error.  The EOF record (tt = 01) displays the #
+//			data records and errors since the last EOF.  A 16 byte record is 44 chrs with the CR and a
+//			64 chr line fits up to 25 data bytes.  Measured with tools/progstn on the sim pty (9600 baud):
+//			a 16 ch chplan image loads in 1.16 s as HEX vs 1.20 s as "M" lines, the W5AFY msg in 0.19 s
+//			vs 0.17 s as "C" lines, and a whole unit (erases and "z" delays) takes 3.8 s vs 3.9 s.
+//
+//		R
+//			Read CW message array (ascii hex)
+//
+//		L
+//			read PLL lock status
+//
+//		i
+//			re-init channel/message.  Must be issued following a PLL or message update, or to change channels (not needed
+//			for embedded message channel changes).
+//
+//		S ssss nn dddd
+//		SL ssss nn dddd
+//			Linear sweep from the current channel.  ssss = FRAC step (hex, 2's complement), nn = # steps (hex),
+//			dddd = dwell per step (hex ms).  Only R0 is sent at each step.  "SL" waits for lock-detect after
+//			each step.
+//			The message is suspended during the sweep, and the current channel is re-loaded when it ends.
+//		H dddd cc cc ...
+//		HL dddd cc cc ...
+//			Hop through the listed channels (hex, up to 16) with dddd ms dwell.  R1/R0 are sent if R2-R5 of the
+//			next channel match the current channel, else the full channel is loaded.  "HL" waits for lock-detect.
+//		SB ssss nn
+//			Sweep benchmark.  Runs nn steps back-to-back with lock-detect gating and reports SPI time, lock time
+//			(min/avg/max), and step rate.
+//		S-
+//			Stop sweep/hop.
+//
+//		Fxx ffff.fffff
+//		Ft ffff.fffff
+//			Program channel "xx" (BCD ASCII, as "M" cmd), or the temp reg ("t"), by frequency (MHz, 10 Hz resolution).
+//			INT, FRAC, MOD, RF divider, and band select divider are calculated on-chip.  All other register bits
+//			are copied from the currently loaded channel.  Displays the calc time and the register set.
+//		FV
+//			Verify: re-calculates every programmed channel from its own frequency.  PASS if the calculated set
+//			gives the same frequency (a FRAC/MOD that reduces is calculated as the reduced pair, so the words can
+//			differ), else FAIL and the channel error flag is set.  Then displays the max calc time.
+//			F and FV need FREQ_EN = 1 (and adfcalc.c in the build).  tools/chplan.c runs the same calculator on
+//			the host.
+//
+//		+[nn]
+//		-[nn]
+//			Fine offset.  Moves R0 up/down by nn (hex, default = 1) FRAC steps.  Only R0 is sent, so keying is
+//			not disturbed.  The offset is kept (RAM only) and applied to every channel load.  Displays the
+//			total offset and the command to R0 latch time (us).
+//		O
+//			Clear fine offset.
+//
+//		LT
+//		LT hhhh m
+//			Display the lock-detect timeout, the last 4 channel loads (from-to ch and lock time in us), and
+//			the avg/max lock time vs. the fixed 2 ms settle used previously.  "hhhh" sets the timeout (us,
+//			hex, max 7530 = 30 ms) and clears the stats.  m = 1 holds the RF off if lock is not seen, m = 0
+//			(default) keys anyway.
+//		LX
+//			Simulate a lock loss (sends R2 with the power-down bit set).  While the VCO is powered up, the lock
+//			supervisor samples lock-detect every 50 ms.  Two unlocked samples in a row is a lock loss, and the
+//			cached channel is re-sent (at most once per sec).  LX needs STATS_EN = 1.
+//
+//		K
+//		KC
+//			Display (KC = clear) the last/max PTT edge to R4 latch latency (us), and the last/max FSEL input edge
+//			to new channel load latency (ms).  FSEL changes are debounced for 20 ms, and then switch at the next
+//			element edge (or at once if the msg is idle or PTT is held).  The ISR frame takes about 40 us
+//			at 1 MHz SCK.  If the edge lands in a main() SPI frame, the frame is sent on the next Timer2 tic
+//			(< 1 ms).  If it lands in a channel load, it waits for the load (< lock timeout + 1 ms).
+//
+//		W
+//		WC
+//			Display (WC = clear after display) the max main loop pass time (us).  Keyout delays, DAC ramps, the
+//			erase confirm, flash erase, and the "z" result delay no longer block the loop.
+//
+//		D
+//		DC
+//		DT
+//			Display the idle fraction (% of 1 ms tics that found the CPU in idle mode) and the % of time at the
+//			throttled clock (SYSCLK/8, during the msg pause and QRT).  DC clears the counters, DT toggles the
+//			clock throttle.
+//
+//		X
+//		XC
+//			Display (XC = clear) the reset source (RSTSRC at reset), the # of warm restarts by reset source, and
+//			the reset to 1st RF time (us).  A warm restart skips the msg/dit validation, re-loads the saved channel,
+//			and resumes the msg at the next element (or the remaining msg pause).  Warm restarts need WARM_EN = 1,
+//			else X shows the reset source and time only.
+//		XW
+//		XS
+//			Force a WDT reset (hangs with intr off) or a sw reset, to test the warm restart.
+//		XB
+//			(BOOT_EN = 1) sw reset into the UART bootloader for a firmware update (tools/bootld.c).  If
+//			no update starts within ~10 s, the bootloader resets back into the app (cold start).
+//
+//		B
+//			Benchmark.  Displays SYSCLK, SPI0CKR, and REVC_HW, then times (PCA) and displays:
+//				spi32	100 PLL frames (the current keyup R4), us per frame incl. LE timing
+//				dac8	100 DAC frames at the keyup level (DAC-RAMP mode only)
+//				flwr	8 flash byte writes (0xff to a blank byte in the spare area at 0x1600, no change)
+//				crc		one CRC16 pass over the channel array
+//				erase	the last sector erase time (ms) from "EC"/"EM" (no spare sector to erase here)
+//				ser		serial chrs/sec for 48 chrs
+//			Only runs with the key up (VCO off, PTT released, no keyout transition), else displays "RF on",
+//			and with no msg running (msg done, or "E" erase hold), else displays "msg on".
+//
+//		T
+//		TB
+//		TC
+//			Dump the event trace ring (last 16 events, oldest first), or clear it (TC).  "T" sends one record per
+//			line, "ee mm tttt" = event, ms count (low 8b), PCA count (hex).  "TB" sends "TB", the # of records,
+//			then 4 binary bytes per record.  Event = type (bits 7-5) and data (bits 4-0):
+//				0x00 keyout (1 = dn)		0x20 SPI frame (reg#, R4: 0x08 = VCO on, 0x10 = RF on)
+//				0x40 ch load (ch#)			0x60 lock (1 = lock, 0 = no lock/lost)
+//				0x80 PTT (1 = dn)			0xa0 CLI cmd (chr & 0x1f)
+//				0xc0 FSEL edge (inputs)		0xe0 SYSCLK (1 = /8)
+//			tools/trcdec.c decodes a capture of either format into a timing chart.
+//
+//		A
+//		A hh
+//		A-
+//			Display, set (hh = 01 - FE, hex), or clear the multi-drop unit ID.  The ID is logged in the spare bytes
+//			of the channel sector (UNIT_ID_ADDR, the last of UNIT_ID_N bytes is current), so it can be changed
+//			without an erase.  "EC" keeps the ID and compacts the log.  A full log displays "ERROR!".
+//		@hh cmd
+//			Addressed (multi-drop) mode.  With an ID set, a unit only runs lines that start with "@hh" (its ID) or
+//			"@00" (broadcast), and tx is muted except while it runs a line addressed to it (incl. the "EC"/"EM"
+//			confirm and the "z" result), so several units can share one bus and only the polled unit answers.
+//			Broadcast lines run on every unit (with or without an ID) with tx muted.  The host must pace them
+//			(no prompt comes back), then poll each unit ("@hh Q").  A bad broadcast line or "z" FAIL sets that
+//			unit's load error.  "@hh" alone returns a prompt (ping).
+//			The "EC"/"EM" confirm is an addressed line as well ("@hh Y").  With an ID set, the TX pin (P0.4) is
+//			open-drain, so idle units release a shared TX line (one pull-up), or it can drive an RS-485 driver
+//			with auto-direction.  "A" can't be broadcast.
+//
+//		All commands are terminated with <CR> ('\r').
+//		Serial port does not echo characters.
+//
+//		Serial port sends power on message when reset.
+//		Serial port outputs current channel selection, CH#, when setting is changed or PTT is cycled.
+//
+//--------------------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+// compile defines
+//#define F360DK ON
+
+#define IS_MAINC
+#include "main.h"
+#include "typedef.h"
+#include "c8051F520.h"
+#include "serial.h"
+#include "channels.h"
+#include "cwconst.h"
+#include "flash.h"
+#include "adfcalc.h"
+#include "hal.h"
+#if BOOT_EN == 1
+#include "boot.h"
+#endif
+
+//-----------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------
+
+//  see init.h for publuc #defines
+
+#define	PBMAX		50			// max channel #s (2-digit BCD input)
+#define	MAX_REG		24			// max bytes in an ADF4351 reg set
+#define	MAX_CHAN	49			// max # bcd channels allowed
+#define	PB_MASK		0x0F		// BCD port valid inputs
+//-----------------------------------------------------------------------------
+// Main Variables
+//-----------------------------------------------------------------------------
+
+// I/O port assignments
+
+SBIT(PB0, 0x90, 0);				// (i) button input 0
+SBIT(PB1, 0x90, 1);				// (i) button input 1
+SBIT(PB2, 0x90, 2);				// (i) button input 2
+SBIT(KEYOUT, 0x90, 7);				// (i) button input 7, retasked as CW KEY out
+SBIT(SCK, 0x80, 0);				// (o) SPI SCLK
+SBIT(MISO, 0x80, 1);				// (i) SPI MISO/LDET
+SBIT(MOSI, 0x80, 2);				// (o) SPI MOSI
+SBIT(nPTT, 0x80, 3);				// (i) /PTT input
+SBIT(nPLL_LE, 0x80, 7);				// (o) SPI LE
+
+#if REVC_HW == 1
+#define	LE_ON	1
+#define	LE_OFF	0
+#else
+#define	LE_ON	0
+#define	LE_OFF	1
+#endif
+
+#if REVC_HW == 1
+#define	PLL_LOCK	0
+#else
+#define	PLL_LOCK	1
+#endif
+
+//-----------------------------------------------------------------------------
+// Local variables
+//-----------------------------------------------------------------------------
+U16 msgtimer;						// msg delay timer
+bit	elem_flag;						// element timer registers for CW output
+bit	cw_on;
+U8 code* cwptr;						// cw pointer
+U8	cwmask;							// cw bitmask
+bit	fsk_enable;						// holds the fsk enable mode
+bit	dfcw_enable;					// holds the DFCW enable mode
+bit	last_key;						// last key status (for FSK)
+bit	last_tone;						// last DFCW tone (0 = dit/set channel, 1 = dah/next channel)
+bit	ipl2;							// PLL init flag
+U8	CHtemp;							// channel temp
+U8	CHdelta;						// channel temp
+bit	CHrun;							// msg (re)start at the next channel load
+bit	ptt_on;							// PTT hold state
+bit	erase_hold;						// erase hold flag
+bit	cli_run;						// a CLI cmd or a status msg is running (tx_wait() may run the msg)
+U16	elem_timer;						// element timer (msg_scale ms tics, 655.34 s max in QRSS mode)
+U16	elem_time;
+U8	elem_pre;						// element timer prescaler (counts ms per elem_timer tic)
+U8	msgpre;							// msg delay prescaler (counts ms per msgtimer tic)
+U8	msg_scale;						// msgtimer prescale value (1 = normal, QRSS_SCALE = slow mode)
+bit	dacmode;						// set if keyout = LTC2630
+#define	KEY_IDLE	0				// key task states
+#define	KEY_DLY		1				// keyout delay, then send queued RF frames
+#define	KEY_RAMP	2				// DAC ramp, then send queued RF frames
+#define	KEYQ_LEN	2				// max # queued RF frames
+#define	KF_R4		0				// key_frame() codes: R4 (as loaded)
+#define	KF_R4_OFF	1				// R4, RF off
+#define	KF_R4_ON	2				// R4, VCO on
+#define	KF_R1		3				// R1/R0, FSK "ON" tone
+#define	KF_R0		4
+#define	KF_R01		5				// R1/R0, FSK "OFF" tone
+#define	KF_R00		6
+#define	KF_R4_LK	7				// R4, VCO on once locked (DFCW tone change)
+U8	key_st;							// key task state
+U8	keytimer;						// key task timer (ms)
+U8	key_nq;							// # queued RF frames
+U8	idata keyq[KEYQ_LEN];		// RF frames (KF_xx) to send at the end of the keyout transition
+U8	ramp_cnt;						// DAC ramp steps remaining
+bit	ramp_up;						// DAC ramp direction
+#define	CLI_IDLE	0				// CLI task states
+#define	CLI_EYES	1				// erase: waiting for "Y"
+#define	CLI_ERASE	2				// erase: one sector per pass
+#define	CLI_ZDLY	3				// CRC compare: result delay
+U8	cli_st;							// CLI task state
+#define	ID_NONE		0xff			// unit_id: not addressed (also an erased ID log)
+#define	TXD_PP		0x10			// P0MDOUT: TX (P0.4) push-pull
+U8	idata unit_id;				// multi-drop unit ID
+bit	adr_all;						// current line is a broadcast ("@00")
+U16	idata hex_n;				// HEX data records since the last EOF record
+U8	idata hex_e;				// HEX bad records since the last EOF record
+U16	clitimer;						// CLI task timer (ms)
+#if STATS_EN == 1
+U16	loop_t0;						// main loop pass start (PCA tics)
+U16	loop_max;						// max main loop pass time (PCA tics)
+U8	loop_ms;						// main loop pass time (ms)
+#endif
+#define	CLK_LOMIN	20				// min msgtimer count to throttle the clock
+bit	cpu_idle;						// set while the CPU is in idle mode
+bit	clk_lo;							// set if SYSCLK is throttled
+bit	clk_en;							// clock throttle enable
+#if STATS_EN == 1
+U16	duty_tot;						// # Timer2 tics
+U16	duty_idle;						// # Timer2 tics that woke the CPU from idle
+U16	duty_lo;						// # Timer2 tics at the throttled clock
+#else
+U8	duty_tot;						// Timer2 tic count (the reload dither uses the 2 LSbs)
+#endif
+#define	XSTR(s)		STR(s)			// stringify a #define value
+#define	STR(s)		#s
+#define	BOOT_TMO	2000			// banner is sent anyway if no RF within this time (ms)
+bit	boot_run;						// boot timer running (until the 1st RF)
+U16	boot_ms;						// reset to 1st RF (ms)
+#if STATS_EN == 1
+U16	boot_pca;						// reset to 1st RF (PCA tics, valid if boot_ms < 32)
+#endif
+char code* idata boot_ptr;		// banner output pointer
+U8	idata boot_seq;				// banner line #
+#if REVC_HW == 1
+char code boot_ver[] = "\nADF4351 Beacon Exctr Ver 0.26, de ke0ff\n";	// sw version msg
+#else
+char code boot_ver[] = "\nADF4351 Beacon Exctr Ver A0.26, de ke0ff\n";	// sw version msg
+#endif
+char code boot_hlp[] = XSTR(NUM_CHAN) " CH, gnd-true BCD, PTTin low = key down,\nSerial cmd enabled\n";
+#if WARM_EN == 1
+char code boot_warm[] = "\nWARM restart\n";
+#endif
+
+#define	WDT_MS		3000			// main() must check in within this time or the WDT is starved (ms)
+#define	WDT_CPL		0xff			// PCA0CPL2: WDT timeout = 256 * WDT_CPL PCA tics (32 ms)
+#define	WDTE		0x40			// PCA0MD WDT enable
+#define	PINRSF		0x01			// RSTSRC reset source flags
+#define	WDTRSF		0x08
+#define	SWRSF		0x10
+#define	FERROR		0x40
+#define	WARM_MAGIC	0x5AA5			// state block valid marker
+#define	WARM_ADDR	0x80			// state block in upper idata (STARTUP.A51 only clears IDATALEN = 0x80 bytes)
+#define	WARM_SAVE	250				// state save period during the msg pause (ms)
+#define	WARM_CW		0x01			// warm.io: cw_on
+#if WARM_EN == 1
+typedef struct {
+	U16	magic;						// WARM_MAGIC
+	U8	ch;							// CHtemp
+	U8	delta;						// CHdelta
+	U16	pos;						// next msg element (offset into diode_matrix[])
+	U8	mask;						// next msg element (bit mask)
+	U8	io;							// msg I/O bits (P1[6:4]) | WARM_CW
+	U16	msgtimer;					// msg pause remaining
+	U8	n_wdt;						// # WDT resets
+	U8	n_bod;						// # brown-out resets (POR flag set, RAM intact)
+	U8	n_pin;						// # pin/sw/other resets
+	U8	n_fle;						// # flash error resets
+	U16	crc;						// CRC of the above
+} WARM_ST;
+LOCATED_VARIABLE_NO_INIT(warm, WARM_ST, idata, WARM_ADDR);	// warm restart state (not cleared by reset)
+U8	warm_tmr;						// state save timer (ms)
+#define	WARM_CLR()	warm.magic = 0	// invalidate the state block (msg being re-written)
+#else
+#define	WARM_CLR()
+#endif
+U8	idata rst_src;				// RSTSRC at reset
+bit	warm_go;						// warm restart, restore the msg state at the 1st channel load
+bit	warm_rst;						// this start was a warm restart
+U16	wdt_ms;							// time since main() checked in (ms)
+
+#if STATS_EN == 1
+#define	BM_N		100				// bench loop count (SPI, DAC)
+#define	BM_NFL		8				// bench loop count (flash byte write)
+#define	BM_SER		48				// bench # chrs (serial)
+U16	bm_t0;							// bench start time (PCA tics)
+U16	bm_erase;						// last sector erase time (us, from "EC"/"EM")
+#endif
+
+
+#if TRC_EN == 1
+#define	TRC_LEN		16				// # trace records (power of 2)
+#define	TRC_NONE	0xff			// empty record
+#define	TRC_KEY		0x00			// event types (bits 7-5), data in bits 4-0:
+#define	TRC_SPI		0x20			//	keyout: 1 = dn, 0 = up
+#define	TRC_CH		0x40			//	SPI: reg# | 0x08 VCO on | 0x10 RF on (R4 only)
+#define	TRC_LOCK	0x60			//	ch load: ch# (0x0f = temp reg);  lock: 1 = lock, 0 = no lock/lost
+#define	TRC_PTT		0x80			//	PTT: 1 = dn, 0 = up
+#define	TRC_CMD		0xa0			//	CLI cmd: cmd chr & 0x1f
+#define	TRC_FSEL	0xc0			//	FSEL edge: FSEL port bits (gnd-true)
+#define	TRC_CLK		0xe0			//	SYSCLK: 1 = /8, 0 = full
+idata U8	trc_ev[TRC_LEN];		// trace records: event
+idata U8	trc_ms[TRC_LEN];		//	Timer2 ms count (low 8b)
+idata U8	trc_th[TRC_LEN];		//	PCA count (SYSCLK/12 tics)
+idata U8	trc_tl[TRC_LEN];
+U8	trc_idx;						// next trace record
+U8	trc_tic;						// free running ms count
+bit	trc_on;							// trace enabled (cleared while dumping)
+bit	trc_ld;							// channel load running, its SPI frames are not traced
+// TRC() is in-line so that the reg banked ISRs can use it (no calls).  It is about 36
+//	cycles (1.5 us at 24.5 MHz).  It holds off the ISRs: a PCA0L read between another's
+//	PCA0L/H reads would re-latch PCA0H.  main() uses TRC_M().
+#define	TRC(e)		if(trc_on){ U8 trc_ea = EA; EA = 0; \
+						trc_tl[trc_idx] = HAL_PCA_LO(); trc_th[trc_idx] = HAL_PCA_HI(); \
+						trc_ms[trc_idx] = trc_tic; trc_ev[trc_idx] = (e); \
+						trc_idx = (trc_idx + 1) & (TRC_LEN - 1); EA = trc_ea; }
+#define	TRC_M(e)	trc_put(e)
+#define	TRC_LD(b)	trc_ld = (b)	// one TRC_CH record stands for the six frames of a ch load
+#else
+#define	TRC(e)
+#define	TRC_M(e)
+#define	TRC_LD(b)
+#endif
+#define	RF_ENAB		0x0020			// reg 4 bit 5 enables RF out
+#define	VCO_DISAB	0x0800			// reg 4 bit 11 disables VCO out
+U32	reg4_32;						// ADF4351 reg 4 holding (R2, R3, R5 are read at chan_ptr)
+U32	idata reg1_32;				// ADF4351 reg 1 holding
+U32	reg0_32;						// ADF4351 reg 0 holding
+U32	idata reg01_32;				// ADF4351 reg 1 holding (FSK "off")
+U32	idata reg00_32;				// ADF4351 reg 0 holding (FSK "off")
+U32* chan_ptr;						// pointer to R0 of the register set loaded in the PLL
+S16	idata fine_ofs;				// fine offset (FRAC steps) applied to R0 at each channel load
+
+#define	LOCK_TMO	10200			// default lock-detect timeout (5 ms in PCA tics)
+#define	LOCK_FAIL	0xffff			// lock_wait() timeout return
+#define	LOCK_FIXED	2000			// legacy fixed channel settle (us), for comparison
+#define	LOCK_LOG	4				// # channel pair lock times kept (power of 2)
+U16	idata lock_tmo;				// lock-detect timeout (PCA tics)
+bit	lock_mute;						// fallback: 1 = hold RF off if no lock, 0 = key anyway
+#if STATS_EN == 1
+U8	lk_last;						// last channel loaded (0x0f = temp reg)
+U8	lk_idx;							// lock log index
+U8	lk_pair[LOCK_LOG];				// lock log channel pairs (from = high nyb, to = low nyb)
+U16	lk_time[LOCK_LOG];				// lock log times (PCA tics, LOCK_FAIL = no lock)
+U16	lk_n;							// # channel loads
+U8	lk_fail;						// # channel loads that did not lock
+U16	lk_max;							// max lock time (PCA tics)
+U32	lk_sum;							// sum of lock times (PCA tics)
+#endif
+
+#define	LKSUP_MS	50				// lock supervisor sample period (ms)
+#define	LKSUP_SETTLE 10				// 1st sample delay after the VCO is powered up (ms)
+#define	LKSUP_MISS	2				// # consecutive unlocked samples to declare lock loss
+#define	LKSUP_HOLD	20				// min # samples between register re-sends (rate limit)
+bit	vco_on;							// set if the last R4 sent has the VCO powered up
+bit	lk_lost;						// lock loss in progress
+U8	lksup_tmr;						// lock supervisor sample timer (ms)
+U8	lksup_hold;						// re-send rate limit (samples)
+U8	lk_miss;						// consecutive unlocked samples
+
+#define	PTT_RST		100				// msg re-start delay after PTT release (ms)
+#define	IN0PL		0x08			// IT01CF INT0 polarity bit (1 = active high)
+bit	spi_busy;						// set while main() is sending an SPI frame
+bit	ptt_hold;						// set while main() is loading the PLL (PTT frames are deferred)
+bit	ptt_arm;						// PTT frames enabled
+bit	ptt_dn;							// PTT state (from INT0 ISR)
+bit	ptt_evt;						// PTT edge event (from INT0 ISR)
+bit	ptt_pend;						// PTT frame deferred
+bit	ptt_retry;						// invalid msg init re-tried for this PTT press (cleared at release)
+#if STATS_EN == 1
+U16	ptt_t0;							// PTT edge time (PCA tics)
+U16	ptt_lat;						// last PTT edge to R4 latch latency (PCA tics)
+U16	ptt_max;						// max PTT latency (PCA tics)
+#endif
+
+#define	FSEL_DB		20				// FSEL input debounce (ms)
+#define	EMAT		0x80			// EIE1 port match intr enable
+bit	fsel_chg;						// FSEL inputs changed and are stable (from Timer2)
+U8	fsel_db;						// FSEL debounce timer (ms)
+#if STATS_EN == 1
+bit	fsel_run;						// FSEL switch latency timer running
+U16	fsel_ms;						// FSEL edge to channel load timer (ms)
+U16	fsel_lat;						// last FSEL switch latency (ms)
+U16	fsel_max;						// max FSEL switch latency (ms)
+#endif
+
+#if SWEEP_EN == 1
+#define	SWP_OFF		0				// sweep modes
+#define	SWP_LIN		1				// linear FRAC sweep
+#define	SWP_HOP		2				// hop table playback
+#define	MAX_HOP		16				// max # hop table entries
+U8	swp_mode;						// sweep mode
+bit	swp_gate;						// lock-detect gating enable
+bit	swp_full;						// next step needs a full channel load
+U8	swp_cnt;						// steps remaining
+U8	swp_idx;						// hop table index
+U8	hop_tbl[MAX_HOP/2];				// hop channel list (2 ch per byte, high nyb first)
+U16	swp_dwell;						// dwell per step (ms)
+U16	swptimer;						// dwell timer
+S16	swp_step;						// FRAC step (linear sweep)
+U32	swp_r0;							// R0 for next step
+U32	swp_r1;							// R1 for next step
+U32* swp_ptr;						// R0 of next hop channel
+#endif
+
+U32 code * idata pll_ch;		// pointer to base of channel array (initialized in main())
+
+//-----------------------------------------------------------------------------
+// Local Prototypes
+//-----------------------------------------------------------------------------
+
+INTERRUPT_PROTO_USING(Timer2_ISR, 5, 2);
+INTERRUPT_PROTO_USING(ptt_isr, 0, 2);
+INTERRUPT_PROTO_USING(fsel_isr, 14, 2);
+U8 valid_cw(U8 code * ptr);
+U8 dfcw_dah(U8 code* ptr, U8 mask);
+U32 add_frac(U32 r0, U16 r1, S16 step);
+U8 retune(U32* p);
+U16 lock_wait(void);
+U16 chan_load(U32* p, U32 r0);
+void lock_rpt(void);
+#if STATS_EN == 1
+void lock_log(U8 ch, U16 tlock);
+#endif
+void lksup_rec(void);
+U16 get_pca(void);
+U16 pca_us(U16 tics);
+void put_u16(U16 dval);
+#if FREQ_EN == 1
+void put_freq(U32 freq);
+U8 getfreq(U32* fptr);
+#endif
+#if SWEEP_EN == 1
+void swp_next(void);
+U16 swp_emit(void);
+U8 swp_bench(void);
+#endif
+void send_spi32(U32 plldata);
+void delay_us(U16 dly);
+U16 calcrc(U8 c, U16 oldcrc);
+//void pb_state(U8 imode);
+U32 *get_chan(U8 chanum);
+U8 conv_to_chnum(U8 portbits);
+void put_hex(U8 dhex);
+void put_dec(U8 dhex);
+U8 convnyb(U8 c);
+U8 getbyte(U8* dataptr);
+U8 hex_chk(void);
+U8 addr_chk(void);
+U8 id_get(void);
+U8 id_put(U8 id);
+void id_port(void);
+U8 whitespc(char c);
+void ramp_step(void);
+void key_frame(U8 kf);
+U32 kf_word(U8 kf);
+void key_flush(void);
+void key_task(void);
+void elem_task(void);
+void clk_set(U8 lo);
+void send_spi8(U8 daccmd, U8 dacdata);
+#if STATS_EN == 1
+#endif
+void setkeyout(U8 updn);
+#if WARM_EN == 1
+U16 warm_crc(void);
+U8 warm_chk(void);
+void warm_save(U8 ch, U8 delta, U8 code* ptr, U8 mask);
+#endif
+void warm_rpt(void);
+void boot_rpt(void);
+#if STATS_EN == 1
+void bm_start(void);
+U32 bm_stop(void);
+void bm_put(char* s, U8 n, U32 tics);
+void bench(void);
+#endif
+#if TRC_EN == 1
+void trc_put(U8 e);
+U8 trc_spi(U32 d);
+void trc_dump(U8 bin);
+#endif
+
+//******************************************************************************
+// main()
+//  The main function inits I/O and process inputs.
+//	sends PLL data to ADF4351 when channel select inputs change
+//
+//******************************************************************************
+void main(void) //using 0
+{
+	char c;				// temp term chr
+	bit	ipl;			// initial loop flag
+	U8	i;				// loop counter
+	U8	j;				// loop counter
+	U8	k;				// loop counter
+	bit	flag;			// temp flag
+	bit	goteol;			// temp flag
+	bit	r_chg;			// "t" cmd: R2, R3, or R5 differ from the loaded set
+	bit	fsel_sw;		// FSEL channel switch in progress
+	bit	ch_rpt;			// msg start, send the "CH" status msg after the load
+	bit	temp_active;	// temp reg active flag
+	bit loaderr;		// channel pgm error flag
+	bit	qrss_mode;		// holds the QRSS slow-speed mode
+	U8	tempbyte;		// temp
+	U8	tempbyte2;		// temp (PB inputs, channel #)
+	U8	idata temp_chan[24];	// temp channel register set (bytes)
+	U16 tempword;		// temp16
+	bit	z_temp;			// "z" cmd flag
+#if FREQ_EN == 1
+	U32	freq;			// frequency temp (10 Hz units)
+#endif
+	U16 ii;				// crc temp
+#if STATS_EN == 1
+	U16	cmd_t0;			// cmd start time (PCA tics)
+#endif
+	U32* tptr;			// reg pointer
+	U8 xdata * fptr;	// flash pointer
+	U8 code * rptr;		// flash pointer
+	bit	key_dn;			// RF key (timer)
+	
+	// start of main
+	PCA0MD = 0x00;								// disable watchdog
+	rst_src = RSTSRC;							// save reset source
+	// init MCU system
+	Init_Device();								// init MCU
+#ifndef	BB_SPI
+    XBR0      = 0x03;							// enable hdwr SPI on xbar
+    SPI0CN    = 0x01;							// enable hdwr SPI
+#endif
+	SCK = 0;									// init SPI pins
+	MISO = 1;
+	HAL_PLL_LE(LE_OFF);
+	init_flash();								// init FLASH
+	P1 = 0x7F;									// enable port for input
+	pll_ch = pll_ch_array;						// set array to point to fixed location
+	init_serial();								// init serial module
+	// init module vars
+	cw_on = 0;									// turn off CW
+	msgtimer = 0;
+	spi_busy = 0;								// init PTT intr state
+	ptt_hold = 0;
+	ptt_arm = 0;
+	ptt_dn = 0;
+	ptt_evt = 0;
+	ptt_pend = 0;
+	ptt_retry = 0;
+	fsel_chg = 0;								// init FSEL port match
+	fsel_db = 0;
+#if STATS_EN == 1
+	ptt_lat = 0;
+	ptt_max = 0;
+	fsel_run = 0;
+	fsel_lat = 0;
+	fsel_max = 0;
+#endif
+	P1MASK = PB_MASK;							// port match on the FSEL inputs
+	P1MAT = P1;
+	EIE1 |= EMAT;
+	msg_scale = 1;
+	msgpre = 1;
+	qrss_mode = 0;
+	key_dn = 0;
+#if SWEEP_EN == 1
+	swp_mode = SWP_OFF;							// no sweep
+#endif
+	boot_ms = 0;								// time to 1st RF
+	boot_run = 1;
+	EA = 1;
+	// fast boot: the PLL is loaded and the msg started on the 1st pass of the main loop.
+	//	The banner is sent in the background after the 1st RF (see "boot banner" below).
+//	KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// make key output inactive
+	KEYOUT = 1;									// make key output inactive (assume DAC ramp mode for now)
+	temp_active = 0;							// de-activate temp reg
+	fine_ofs = 0;								// no fine offset
+	lock_tmo = LOCK_TMO;						// init lock-detect timeout
+	lock_mute = 0;								// key anyway if no lock
+	vco_on = 0;									// init lock supervisor
+	lk_lost = 0;
+	lksup_tmr = LKSUP_MS;
+	lksup_hold = 0;
+	lk_miss = 0;
+#if STATS_EN == 1
+	lk_last = 0;								// init lock log and stats
+	lk_idx = 0;
+	lk_n = 0;
+	lk_fail = 0;
+	lk_max = 0;
+	lk_sum = 0;
+#endif
+	loaderr = 0;								// init chan error status
+	ipl = 1;									// set initial loop
+	ipl2 = 1;									// init PLL
+	CHrun = 1;								// msg start at the 1st channel load
+	last_key = 0;								// init last key memory
+	key_st = KEY_IDLE;							// init key task
+	key_nq = 0;
+	setkeyout(0xAA);							// init rampdac key mem
+	cli_st = CLI_IDLE;							// init CLI task
+	hex_n = 0;									// init HEX record counts
+	hex_e = 0;
+	unit_id = id_get();							// multi-drop unit ID
+	id_port();
+	tx_mute(unit_id != ID_NONE);				// addressed units are silent until polled
+	adr_all = 0;
+	cpu_idle = 0;								// init low power
+	clk_lo = 0;
+	clk_en = THROTTLE_EN;
+	duty_tot = 0;
+#if STATS_EN == 1
+	duty_idle = 0;
+	duty_lo = 0;
+	loop_max = 0;
+	loop_ms = 0;
+	loop_t0 = get_pca();
+#endif
+	ptt_on = 0;									// PTT released
+	fsel_sw = 0;
+	ch_rpt = 0;
+	boot_ptr = boot_ver;						// banner
+	boot_seq = 0;
+	wdt_ms = 0;
+	warm_go = 0;
+#if WARM_EN == 1
+	warm_tmr = WARM_SAVE;
+	if(warm_chk()){
+		// RAM state survived the reset: resume the msg w/o re-validation
+		if(rst_src & WDTRSF){
+			warm.n_wdt++;
+		}else if(rst_src & FERROR){
+			warm.n_fle++;
+		}else if(rst_src & PORSF){
+			warm.n_bod++;
+		}else{
+			warm.n_pin++;
+		}
+		warm.crc = warm_crc();
+		warm_go = 1;
+		boot_ptr = boot_warm;					// short banner
+		boot_seq = 1;
+	}else{
+		warm.magic = 0;							// cold start
+		warm.n_wdt = 0;
+		warm.n_bod = 0;
+		warm.n_pin = 0;
+		warm.n_fle = 0;
+	}
+#endif
+	warm_rst = warm_go;
+#if STATS_EN == 1
+	bm_erase = 0;								// no erase timed yet
+#endif
+#if TRC_EN == 1
+	for(i=0; i<TRC_LEN; i++){
+		trc_ev[i] = TRC_NONE;					// clear trace
+	}
+	trc_idx = 0;
+	trc_on = 1;
+#endif
+	PCA0CPL2 = WDT_CPL;							// WDT timeout
+	PCA0MD |= WDTE;								// enable WDT (Timer2 kicks it while main() checks in)
+
+	// main loop
+	// Each section below is a run-to-completion task.  Anything that has to wait (keyout
+	//	ramps, erase confirm, flash erase, CRC result) keeps its state and a timer, and
+	//	yields back to the loop instead of spinning.
+	while(1){
+		wdt_ms = 0;													// check in with the WDT
+#if STATS_EN == 1
+		tempword = get_pca();										// main loop pass time
+		if(loop_ms > 31){
+			loop_max = 0xffff;										// PCA wraps at 32 ms
+		}else{
+			if(((tempword - loop_t0) > loop_max) && !clk_lo){
+				loop_max = tempword - loop_t0;
+			}
+		}
+		loop_t0 = tempword;
+		loop_ms = 0;
+#endif
+		// clock throttle: SYSCLK/8 during the msg pause and QRT.  Anything else that needs
+		//	doing (PTT, FSEL, serial input, etc.) restores the full clock first.
+		if(clk_en && !ptt_on && !ptt_evt && !fsel_chg && !ipl2 && (cli_st == CLI_IDLE) && (key_st == KEY_IDLE) &&
+#if SWEEP_EN == 1
+		   (swp_mode == SWP_OFF) &&
+#endif
+		   !gotch00() && (erase_hold || (!cw_on && (msgtimer > CLK_LOMIN)))){
+			if(!clk_lo){
+				clk_set(1);
+			}
+		}else{
+			if(clk_lo){
+				clk_set(0);
+			}
+		}
+		// process PTT
+		// PTT = 1 turns off RF out (reg 4, bit 05 = 0), = 0 turns on RF (reg 4, bit 05 = 1).
+		//	!! channel data must have reg 4, bit 05 = 0 !!
+		// The R4 keydn/keyup frames are sent by the INT0 ISR, this just manages the hold state
+		if(ptt_evt){
+			ptt_evt = 0;
+			if(ptt_dn && !ptt_on){
+				ptt_on = 1;											// PTT pressed, hold msg
+				cw_on = 0;
+				msgtimer = 0;
+				tempbyte2 = (~P1) & PB_MASK & 0x0f;
+#if SWEEP_EN == 1
+				if((tempbyte2 != CHtemp) || CHdelta || temp_active || (swp_mode != SWP_OFF)){
+					swp_mode = SWP_OFF;								// PTT cancels sweep
+#else
+				if((tempbyte2 != CHtemp) || CHdelta || temp_active){
+#endif
+					ipl2 = 1;										// re-latch CH inputs (reset PLL)
+					CHrun = 1;
+				}
+				key_nq = 0;											// drop queued msg RF frames
+				key_flush();										// finish the msg's keyout transition
+				setkeyout(1);
+			}
+			if(!ptt_dn && ptt_on){
+				ptt_on = 0;											// PTT released
+				key_flush();
+				setkeyout(0);
+				msgpre = msg_scale;									// re-start msg after PTT_RST ms
+				msgtimer = PTT_RST / msg_scale;
+				cw_on = 0;
+			}
+		}
+		if(!ptt_arm && (nPTT == 0) && !ptt_retry){
+			ptt_retry = 1;											// msg/dit invalid, PTT re-tries init
+			ipl2 = 1;												//	(once per press)
+			CHrun = 1;
+		}
+		// key task (after the PTT edge, so that a pending key-up can't follow the ISR's keydn)
+		key_task();
+		if(ch_rpt){
+			ch_rpt = 0;											// msg start status, the pass after the load so
+			cli_run = 1;										//	that the tx buffer can't hold up the RF (the
+			putss("CH ");										//	msg runs while it waits, tx_wait())
+			put_dec(CHtemp);
+			if(fsk_enable){
+				putss("FSK mode\n");
+			}
+			if(dfcw_enable){
+				putss("DFCW mode\n");
+			}
+			if(dacmode){
+				putss("DAC-RAMP enabled\n");
+			}
+			if(qrss_mode){
+				putss("QRSS mode\n");
+			}
+			cli_run = 0;
+		}
+		// process FSEL change (at element edge if the msg is running)
+		if(fsel_chg && (elem_flag || !cw_on || ptt_on || erase_hold)){
+			fsel_chg = 0;
+			tempbyte2 = (~P1) & PB_MASK & 0x0f;
+			if((tempbyte2 != CHtemp) || CHdelta || temp_active){
+				CHtemp = tempbyte2;									// new channel
+				CHdelta = 0;
+				temp_active = 0;									// cancels temp reg
+#if SWEEP_EN == 1
+				swp_mode = SWP_OFF;									// and sweep
+#endif
+				CHrun = 0;
+				ipl2 = 1;											// load channel, msg keeps running
+				fsel_sw = 1;										// flag FSEL switch for the "CH" msg and latency stats
+			}
+#if STATS_EN == 1
+			else{
+				fsel_run = 0;										// no change (bounce)
+			}
+#endif
+		}
+#ifdef BB_SPI
+		if(ptt_pend){
+			ptt_pend = 0;											// bit-bang SPI, ISR can't send the PTT frame
+			if(ptt_dn){
+				send_spi32(reg4_32 & (~VCO_DISAB));					// keydn
+			}else{
+				send_spi32(reg4_32);								// keyup
+			}
+		}
+#endif
+		if(ipl2 == 1){
+			ipl2 = 0;
+			ptt_hold = 1;											// defer PTT frames until the PLL is loaded
+			if(clk_lo){
+				clk_set(0);											// lock timing needs the full clock
+			}
+			key_nq = 0;												// queued RF frames are stale
+			if(CHrun){
+				CHrun = 0;											// clear semaphore
+				key_dn = 0;
+				if(warm_go){
+#if WARM_EN == 1
+					CHtemp = warm.ch;								// warm restart, channel from the state block
+					CHdelta = warm.delta;
+#endif
+				}else{
+					CHdelta = 0;
+					msgtimer = 0;
+					// process PTT/channels
+					tempbyte2 = (~P1) & PB_MASK;						// convert port to POS logic
+//					CHtemp = conv_to_chnum(tempbyte2);					// convert port state to channel#
+					CHtemp = tempbyte2 & 0x0f;							// convert port state to channel#
+				}
+				ch_rpt = 1;											// "CH" status msg after the load
+				fsk_enable = (U8)diode_matrix[KEY_IDX] & FSK_MASK;	// get fsk mode bit
+				dfcw_enable = (U8)diode_matrix[KEY_IDX] & DFCW_MASK;	// get DFCW mode bit
+				if(dfcw_enable){
+					fsk_enable = 0;									// DFCW keys as OOK, FSK regs select the dah tone
+				}
+				dacmode = (U8)diode_matrix[KEY_IDX] & DAC_MASK;		// get DAC mode bit
+				if(dacmode){
+					send_spi8(DAC_IREF, 0);							// set DAC to use internal ref
+					send_spi8(DAC_SET, 0);							// clear DAC
+				}
+				qrss_mode = (U8)diode_matrix[KEY_IDX] & QRSS_MASK;	// get QRSS mode bit
+				msg_scale = 1;										// default to ms dit/delay fields
+				if(qrss_mode){
+					msg_scale = QRSS_SCALE;							// dit/delay fields are in QRSS_SCALE ms units
+				}
+				tempword = ((U16)diode_matrix[DIT_IDX] << 8) | ((U16)diode_matrix[DIT_IDX+1]); // slowest element timer
+				EA = 0;												// don't let Timer2 see a partial update
+				elem_time = tempword;
+				elem_timer = 1;
+				elem_pre = 1;
+				EA = 1;
+				if(tempword == 0xffff){
+					erase_hold = TRUE;
+					putss("dit time invalid\n");
+					cw_on = 0;
+				}else if(warm_go){
+					erase_hold = FALSE;								// msg was valid when the state was saved
+#if WARM_EN == 1
+					cwptr = (U8 code*)diode_matrix + warm.pos;			// resume at the next element
+					cwmask = warm.mask;
+					msgpre = msg_scale;
+					msgtimer = warm.msgtimer;
+					cw_on = warm.io & WARM_CW;
+					P1 = (P1 & 0x8f) | (warm.io & 0x70);			// msg I/O bits
+#endif
+				}else{
+					// validate message
+					rptr = FLASH_C(SECTCW_ADDR);					// set pointer to start of CW msg
+					rptr += MSG_IDX;
+					if(!valid_cw(rptr)){
+						erase_hold = TRUE;
+						putss("msg invalid\n");
+						cw_on = 0;
+					}else{
+						erase_hold = FALSE;
+					}
+				}
+				warm_go = 0;
+			}
+			if(temp_active){
+				tptr = (U32*)temp_chan + 5;							// temp reg overrides the channel select
+				tempbyte2 = 0x0f;									// temp reg id for the lock log
+			}else{
+				tempbyte2 = (CHtemp + CHdelta) & 0x0f;
+				tptr = get_chan(tempbyte2);							// calc tptr to R5 of correct channel array
+				if(*tptr == 0xffffffff){
+					tptr = get_chan(0);								// ch#00 if R5 is 0xffffffff (ch is empty)
+				}
+			}
+			chan_ptr = tptr - 5;									// save loaded channel
+			tptr = tptr - 1;
+			reg4_32 = *tptr;										// get R4 value
+			tptr = tptr - 3;
+			reg1_32 = *tptr;										// get R1 value
+			reg01_32 = *(tptr+6);									// get R1 value from next channel
+			tptr = tptr - 1;
+			reg0_32 = *tptr;										// get R0 value
+			reg00_32 = *(tptr+6);									// get R0 value from next channel
+			if(temp_active){
+				reg01_32 = reg1_32;									// temp reg has no next ch, one FSK/DFCW tone
+				reg00_32 = reg0_32;
+			}
+			if(fine_ofs){
+				reg0_32 = add_frac(reg0_32, reg1_32, fine_ofs);		// apply fine offset
+				reg00_32 = add_frac(reg00_32, reg01_32, fine_ofs);
+			}
+			TRC_M(TRC_CH | tempbyte2);								// load start (its R5-R0 frames aren't traced)
+			tempword = chan_load(chan_ptr, reg0_32);				// transfer channel data to PLL, wait for lock
+#if STATS_EN == 1
+			lock_log(tempbyte2, tempword);
+#endif
+			TRC_M(TRC_LOCK | (tempword != LOCK_FAIL));
+			if(lk_lost && (tempword != LOCK_FAIL)){
+				lksup_rec();										// re-send recovered the lock
+			}
+			if(!fsk_enable){
+				reg4_32 |= RF_ENAB | VCO_DISAB;						// set R4 value
+			}
+			if((tempword == LOCK_FAIL) && lock_mute){
+				reg4_32 &= ~RF_ENAB;								// no lock, hold RF off until the next channel load
+				putss("no lock\n");
+			}
+			send_spi32(reg4_32);									// keyup
+			if(ptt_on){
+				send_spi32(reg4_32 & (~VCO_DISAB));					// PTT is held, keydn
+			}
+			ptt_hold = 0;
+			if(fsel_sw){
+				fsel_sw = 0;
+#if STATS_EN == 1
+				fsel_run = 0;										// FSEL switch done
+				tempword = fsel_ms;
+				fsel_lat = tempword;
+				if(tempword > fsel_max){
+					fsel_max = tempword;
+				}
+#endif
+				putss("CH ");
+				put_dec(CHtemp);
+				putss("\n");
+			}
+			last_tone = 0;											// set channel (dit tone) is loaded
+		}
+#if SWEEP_EN == 1
+		if(swp_mode != SWP_OFF){
+			// process sweep/hop step
+			if(swptimer == 0){
+				swptimer = swp_dwell;								// start dwell
+				swp_emit();											// send pre-computed step to PLL
+				if(--swp_cnt == 0){
+					swp_mode = SWP_OFF;								// done, re-load current channel
+					ipl2 = 1;
+					putss("swp done\n");
+				}else{
+					swp_next();										// calc next step during the dwell
+				}
+			}
+		}else
+#endif
+		if(!erase_hold && !ptt_on){
+			if((msgtimer == 0) && (cw_on == 0)){
+				cwptr = &diode_matrix[MSG_IDX-1];					// reset cw pointer
+				cwmask = 0;
+				cw_on = 1;
+			}
+			if(elem_flag && !fsel_chg){										// process element edge (an FSEL change
+				elem_task();												//	takes it on the next pass, as a load)
+			}
+#if WARM_EN == 1
+			if(!cw_on && (warm_tmr == 0)){
+				warm_tmr = WARM_SAVE;
+				warm_save(CHtemp, CHdelta, cwptr, cwmask);					// msg pause remaining
+			}
+#endif
+		}
+		if(erase_hold){
+			ptt_arm = 0;
+		}else{
+			if(!ptt_arm){
+				ptt_arm = 1;										// enable PTT frames
+				IE0 = 1;											// and sample the PTT input
+			}
+		}
+		// lock supervisor
+		if(lksup_tmr == 0){
+			lksup_tmr = LKSUP_MS;
+			if(lksup_hold){
+				lksup_hold--;
+			}
+#if SWEEP_EN == 1
+			if(vco_on && (swp_mode == SWP_OFF)){
+#else
+			if(vco_on){
+#endif
+				if(MISO == PLL_LOCK){
+					lk_miss = 0;
+					if(lk_lost){
+						lksup_rec();								// lock came back on its own
+						TRC_M(TRC_LOCK | 1);
+					}
+				}else{
+					if(lk_miss < LKSUP_MISS){
+						lk_miss++;
+					}
+					if(lk_miss == LKSUP_MISS){
+						if(!lk_lost){
+							lk_lost = 1;							// lock loss event
+							TRC_M(TRC_LOCK | 0);
+						}
+						if(!lksup_hold){
+							lksup_hold = LKSUP_HOLD;
+							ipl2 = 1;								// re-send cached channel (msg keeps running)
+						}
+					}
+				}
+			}
+		}
+		// process serial input
+		// a cmd only starts with the tx buffer empty, so a reply that fits in it never waits
+		if((cli_st == CLI_IDLE) && txidle() && gotcr() && addr_chk()){	// wait for a cr ('\r') (for this unit)
+			if(clk_lo){
+				clk_set(0);											// run cmds at the full clock
+			}
+			cli_run = 1;											// msg edges run while a report waits (tx_wait())
+#if STATS_EN == 1
+			cmd_t0 = get_pca();										// cmd start time for retune latency
+#endif
+			z_temp = 0;												// pre-clear "z" flag
+			do{
+				c = getch00();										// skip over leading control chrs
+			}while((c <= ESC) && (c != '\0'));
+			putch(c);
+			if((c != '\r') && (c != '\0')){
+				TRC_M(TRC_CMD | (c & 0x1f));
+			}
+			switch(c){
+				default:											// invalid command chr
+					do{
+						c = getch00();								// skip to EOL or end of input
+					}while((c != '\r') && (c != '\0'));
+				case '\r':											// empty line
+					break;
+				
+				case 'i':
+					rptr = FLASH_C(SECTCW_ADDR);					// set pointer to start of CW msg
+					rptr += MSG_IDX;
+					if((valid_cw(rptr)) && !((diode_matrix[DIT_IDX] == 0xff) && (diode_matrix[DIT_IDX+1] == 0xff))){
+						putss("\nRe-init");							// post prompt
+						erase_hold = FALSE;							// clear erase hold
+						cwptr = &diode_matrix[MSG_IDX];				// reset cw pointer
+						cwmask = 0x80;
+						msgtimer = 0;
+						cw_on = 1;
+						CHrun = 1;
+						ipl2 = 1;									// re-init PLL and dit time
+					}else{
+						putss("msg invalid\n");
+					}
+					break;
+				
+				case 'E':
+					c = getch00();
+					//erase first 3 sectors of FLASH where the channel data lives				
+					while(getch00());								// clean out serial buffer
+					if(c == 'C'){
+						putss("\nErase All PLL data, Press \"Y\" to cont...");		// Are you sure? prompt
+						fptr = FLASH_X(SECTCH_ADDR);				// set pointer to 1st sector of ch data
+						j = 1;										// # sect to erase
+					}
+					if(c == 'M'){
+						putss("\nErase CW Message, Press \"Y\" to cont...");		// Are you sure? prompt
+						fptr = FLASH_X(SECTCW_ADDR);				// set pointer to 1st sector of msg data
+						j = 3;										// # sect to erase
+					}
+					if((c != 'C') && (c != 'M')){
+						putss("ERROR!\n");
+						break;
+					}
+					clitimer = 5000;								// set 5 sec timer
+					cli_st = CLI_EYES;								// wait for user input (CLI task, below)
+					break;
+				
+				case 'e':
+					// echo terminal buffer
+					do{
+						c = getch00();				 				// get byte
+						putch(c);									// echo
+					}while(c != '\r');								// until cr
+					putch('\n');
+					break;
+				
+				case 'Q':
+					// error querry/clear
+					if(loaderr){									// display error status
+						putss("\nLoad errors\n");
+					}else{
+						putss("\nNO errors\n");
+					}
+					if(gotch00()){
+						if(getch00() == 'C'){
+							putss("Err status cleared\n");
+							loaderr = 0;							// clear error status
+						}
+					}
+					putch('\n');
+					break;
+
+				case 'z':
+					z_temp = 1;										// set "z" cmd flag
+				case 'c':
+					// calc CRC16 on channels
+					c = getch00();									// see if for CW msg
+					ii = 0;											// CRC
+					tempword = 0;
+					if(c == 'm'){
+						rptr = FLASH_C(SECTCW_ADDR);
+						do{
+							tempbyte = *rptr++;
+							tempword <<= 8;
+							tempword |= (U16)tempbyte & 0x00ff;
+							ii = calcrc(tempbyte,ii);
+						}while((tempword != CW_STOPW) && (rptr < FLASH_C(FLASH_END - 1)));
+					}else{
+						rptr = FLASH_C(CHAN_ADDR);
+						for(tempword=0; tempword<(24 * NUM_CHAN); tempword++){
+							ii = calcrc(rptr[tempword ^ U32_MSB],ii);	// MS byte 1st (as "M", HEX, and chplan)
+						}
+					}
+					if(z_temp){										// do CRC compare if true
+						if(c == 'm'){
+							putss(" CMP CW CRC...");
+						}else{
+							putss(" CMP CRC16...");
+						}
+						j = 1;										// preset PASS
+						if(getbyte(&tempbyte)) j = 0;				// 1st CRC byte -- compare data fail
+						if((U8)(ii >> 8) != tempbyte) j = 0;	// crc fail
+						if(getbyte(&tempbyte)) j = 0;				// 2nd CRC byte -- compare data fail
+						if((U8)(ii & 0xff) != tempbyte) j = 0;	// crc fail
+						clitimer = 1000;							// wait 1 sec (CLI task, below)
+						cli_st = CLI_ZDLY;
+					}else{
+						if(c == 'm'){
+							putss("\nCW CRC = 0x");
+						}else{
+							putss("\nCRC16 = 0x");
+						}
+						put_hex((U8)(ii >> 8));
+						put_hex((U8)(ii & 0xff));
+						putss("\n");
+					}
+					break;
+				
+#if FREQ_EN == 1
+				case 'F':
+					// program reg by frequency
+					// syntax: Fxx ffff.fffff, Ft ffff.fffff, FV
+					flag = TRUE;									// default to data good
+					c = getch00();
+					tptr = (U32*)temp_chan;							// Keil U32 is big-endian, same byte order as "M" cmd
+					if(c == 'V'){
+						// verify channel array against calculator
+						putss("\n");
+						ii = 0;										// max calc time
+						for(j=0; j<NUM_CHAN; j++){
+							rptr = (U8 code *) get_chan(j);
+							if(*((U32 code *)rptr) != 0xffffffff){
+								rptr -= 5 * 4;						// R0 of ch
+								for(i=0; i<24; i++){
+									temp_chan[i] = rptr[i];			// copy to temp
+								}
+								freq = adf_freq(tptr);
+								putss("CH");
+								put_dec(j);
+								putch(' ');
+								put_freq(freq);
+								tempword = get_pca();
+								tempbyte = adf_calc(freq, tptr);
+								tempword = get_pca() - tempword;
+								if(tempword > ii) ii = tempword;
+								if(adf_freq(tptr) != freq){			// same freq (a FRAC/MOD that reduces
+									tempbyte = ADF_RANGE;			//	gives other R0/R1 words)
+								}
+								if(freq && !tempbyte){
+									putss(" PASS\n");
+								}else{
+									loaderr = 1;
+									putss(" FAIL\n");
+								}
+							}
+						}
+						putss("calc us max: ");
+						put_u16(pca_us(ii));
+						putss("\n");
+						break;
+					}
+					if(c == 't'){
+						tempbyte2 = 0xff;							// temp reg
+					}else{
+						if((c < '0') || (c > '9')){					// check for valid bcd
+							flag = FALSE;
+						}
+						i = (c & 0x0f) << 4;						// ms nyb
+						c = getch00();
+						if((c < '0') || (c > '9')){
+							flag = FALSE;
+						}
+						i |= (c & 0x0f);							// ls nyb
+						tempbyte2 = conv_to_chnum(i);				// convert BCD to hex
+						if(tempbyte2 >= NUM_CHAN){
+							flag = FALSE;							// error
+						}
+					}
+					if(getfreq(&freq)){
+						flag = FALSE;
+					}
+					if(flag){
+						for(i=0; i<6; i++){
+							tptr[i] = chan_ptr[i];					// template = loaded ch (adf_calc() keeps R2/R3/R5)
+						}
+						tempword = get_pca();
+						tempbyte = adf_calc(freq, tptr);			// calc regs
+						tempword = get_pca() - tempword;
+						if(tempbyte & ADF_RANGE){
+							flag = FALSE;
+						}
+					}
+					if(flag){
+						putss("\ncalc us: ");
+						put_u16(pca_us(tempword));
+						if(tempbyte == ADF_APPROX){
+							putss(" (approx)");
+						}
+						putss("\n");
+						for(i=0; i<24; i++){
+							put_hex(temp_chan[i ^ U32_MSB]);		// display reg set
+							if((i & 0x03) == 0x03){
+								putch(' ');
+							}
+						}
+						putss("\n");
+						if(tempbyte2 == 0xff){
+							temp_active = 1;						// temp channel active
+							putss("Temp reg pgmd\n");				// announce temp reg programmed
+							if(retune(tptr)){
+								ipl2 = 1;							// R2-R5 changed, full channel load
+							}
+#if STATS_EN == 1
+							else{
+								tempword = get_pca() - cmd_t0;
+								putss("rt us: ");					// cmd to R0 latch latency
+								put_u16(pca_us(tempword));
+								putss("\n");
+							}
+#endif
+						}else{
+							fptr = FLASH_X(CHAN_ADDR);			// set pointer to 1st ch
+							fptr += 24 * tempbyte2;					// jump to ch#
+							for(i=0; i<24; i++){
+								wr_flash(temp_chan[i], fptr++);
+							}
+							putss("Chan pgmd!\n");					// announce completion
+						}
+					}else{
+						putss("ERROR!\n");							// announce err
+						loaderr = 1;								// set error
+					}
+					break;
+#endif
+
+				case 't':
+				case 'M':
+					// program reg
+					// syntax: Mxxaaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff
+					//		   t00aaaaaaaabbbbbbbbccccccccddddddddeeeeeeeeffffffff, t-
+					// First, validate buffered data (xfr to temp array)
+					k = c;											// save cmd chr
+					flag = TRUE;									// default to data good
+					if(temp_active){
+						ipl2 = 1;									// temp reg is cancelled (or replaced), re-load
+					}
+					temp_active = 0;								// default to temp = inactive
+					c = getch00();
+					if((k == 't') && (c == '-')){
+						putss("\nTemp reg off\n");					// cancel temp reg
+						break;
+					}
+					if((c < '0') || (c > '9')){						// check for valid bcd
+						flag = FALSE;
+					}
+					i = (c & 0x0f) << 4;							// ms nyb
+					c = getch00();
+					if((c < '0') || (c > '9')){
+						flag = FALSE;
+					}
+					i |= (c & 0x0f);								// ls nyb
+					tempbyte2 = conv_to_chnum(i);					// convert BCD to hex
+					if(tempbyte2 >= NUM_CHAN){
+						flag = FALSE;								// error
+					}
+					goteol = 0;
+					r_chg = 0;
+					i = 0;											// init reg counter
+					while(flag && !goteol){
+						goteol = getbyte(&tempbyte); 				// get byte
+						if(!goteol){
+							if((i >= 8) && ((i < 16) || (i >= 20)) && (((U8*)chan_ptr)[i ^ U32_MSB] != tempbyte)){
+								r_chg = 1;							// R2/R3/R5 vs the loaded set (before a temp reg)
+							}
+							temp_chan[(i++) ^ U32_MSB] = tempbyte;	// MS byte 1st
+						}
+						if(i == MAX_REG){
+							goteol = 1;								// force end if 24 bytes
+						}else{
+							if(goteol) flag = FALSE;				// end of data too soon, error
+						}
+					}
+					// Program data to FLASH
+					if(flag && (k == 'M')){
+						fptr = FLASH_X(CHAN_ADDR);				// set pointer to 1st ch
+						fptr += 24 * tempbyte2;						// jump to ch#
+						for(i=0; i<24; i++){
+							wr_flash(temp_chan[i], fptr++);
+						}
+						putss("Chan pgmd!\n");						// announce completion
+					}else{
+						if(flag){
+							temp_active = 1;						// temp channel active
+							putss("Temp reg pgmd\n");				// announce temp reg programmed
+							if(r_chg || retune((U32*)temp_chan)){
+								ipl2 = 1;							// R2-R5 changed, full channel load
+							}else{
+								ipl2 = 0;							// R0/R1 only, keying is not disturbed
+#if STATS_EN == 1
+								tempword = get_pca() - cmd_t0;
+								putss("rt us: ");					// cmd to R0 latch latency
+								put_u16(pca_us(tempword));
+								putss("\n");
+#endif
+							}
+						}else{
+							putss("ERROR!\n");						// announce err
+							loaderr = 1;							// set error
+						}
+					}
+					// Complete
+					break;
+			
+				case 'r':
+					// read reg
+					// syntax: rxx, rr, r-
+					flag = TRUE;
+					goteol = TRUE;
+					putss("\n");
+					c = getch00();
+					if(c == 'r'){
+						i = 1;										// send temp chan
+						goteol = FALSE;
+						flag = temp_active;
+					}else if(c == '-'){
+						i = NUM_CHAN;								// send all chnnels
+						j = 0;
+						tempbyte2 = conv_to_chnum(j);				// convert BCD to hex
+					}else{
+						if((c < '0') || (c > '9')){					// check for valid BCD
+							flag = FALSE;
+						}
+						i = (c & 0x0f) << 4;						// ms nyb
+						c = getch00();
+						if((c < '0') || (c > '9')){
+							flag = FALSE;
+						}
+						i |= (c & 0x0f);							// ls nyb
+						tempbyte2 = conv_to_chnum(i);				// convert BCD to hex
+						if(tempbyte2 >= NUM_CHAN){
+							flag = FALSE;							// error
+							tempbyte2 = NUM_CHAN;
+						}
+						i = 1;										// just send 1 chan
+						j = tempbyte2;
+					}
+					// read data from FLASH
+					if(flag){
+						if(goteol){
+							rptr = FLASH_C(CHAN_ADDR);			// set pointer to 1st ch
+							rptr += 24 * tempbyte2;					// jump to ch#
+						}
+						do{
+							if(goteol){
+								putch('M');							// pre-amble
+								put_dec(j++);						// print ch#
+								putch(' ');
+							}else{
+								putss("t00 ");						// temp chan preamble
+							}
+							tempbyte = 0;							// use tempbyte to format register fields
+							for(k=0; k<24; k++){
+								if(goteol){
+									put_hex(rptr[k ^ U32_MSB]);		// display FLASH data
+								}else{
+									put_hex(temp_chan[k ^ U32_MSB]);	// display temp reg data
+								}
+								if(++tempbyte == 4){
+									putch(' ');						// insert some formatting between 32bit words
+									tempbyte = 0;
+								}
+							}
+							if(goteol){
+								rptr += 24;							// next ch
+							}
+							putss("\n");
+						}while(--i != 0);
+					}else{
+						putss("CH_ERR!\n");
+					}
+					break;
+			
+				case 'R':
+					// read CW msg
+					// syntax: R
+					flag = TRUE;
+					goteol = TRUE;
+					putss("\n");
+					j = 28;
+					ii = 0;
+					// read data from FLASH
+					if(flag){
+						rptr = FLASH_C(SECTCW_ADDR);				// set pointer to 1st ch
+						tempbyte = 0;								// init end of message flag
+						tempbyte2 = 0;								// init cmd det flag
+						do{
+							putch('C');								// pre-amble
+							put_hex((U8)(ii >> 8));					// print idx
+							put_hex((U8)(ii & 0xff));
+							putch(' ');
+							do{
+								i = *rptr++;						// get msg byte
+								if(tempbyte2 == CW_STOP){			// if last byte == stop &&
+									if(i == CW_EOM){				// this byte == EOM,
+										tempbyte = CW_STOP;			// end the whole listing
+									}
+								}
+								put_hex(i);							// display msg data
+								if(ii < MSG_IDX){
+									tempbyte2 = 0;					// no CW stop in 1st 5 bytes
+								}else{
+									tempbyte2 = i;					// save current chr for EOM det (requires 2 different chrs to end)
+								}
+								ii++;								// next index
+								j--;
+								if((ii == MSG_IDX) || (j == 0) || (tempbyte == CW_STOP)){
+									putss("\n");					// insert some formatting between lines
+									j = 28;							// reset line byte counter
+								}
+								if(rptr >= FLASH_C(FLASH_END - 1)){
+									tempbyte = CW_STOP;				// end of flash, terminate listing
+								}
+							}while((tempbyte != CW_STOP) && (j != 28) && (ii != MSG_IDX));
+						}while(tempbyte != CW_STOP);
+					}
+					break;
+
+				case 'C':
+					// program message string
+					// syntax: Caaaa xxyyzz...
+					//			aaaa = index to message string
+					//			xx/yy/zz = ASCII hex byte pairs to program
+					flag = TRUE;									// default to data good
+					goteol = getbyte(&i);							// get upper
+					goteol |= getbyte(&j);							// get lower
+					if(goteol){
+						flag = FALSE;								// index error
+					}
+					ii = ((U16)i << 8) | ((U16)j & 0x00ff);			// combine to get index
+					fptr = FLASH_X(SECTCW_ADDR);	 			// set pointer to 1st msg array
+					fptr += ii;										// set index for incoming 
+					WARM_CLR();										// no warm restart into a msg being re-written
+					while(flag && !goteol){							// program string to flash
+						goteol = getbyte(&j);						// get data
+						if(!goteol){
+							wr_flash(j, fptr);
+/*							if(*fptr != j){
+								flag = FALSE;
+								putss("vfy err sb/is: ");
+								put_hex(j);
+								putss("/");
+								put_hex(*fptr);
+								putss("\n");
+							}*/
+							fptr += 1;
+						}
+						if(fptr == FLASH_X(FLASH_END)){
+							flag = FALSE;							// force end if overrun
+						}
+					}
+					if(flag){
+						putss("Chan pgmd!\n");						// announce completion
+					}else{
+						putss("ERROR!\n");							// announce err
+						loaderr = 1;								// set error
+					}
+					// Complete
+					break;
+
+				case ':':
+					// Intel HEX record
+					// syntax: :nnaaaattdd..ddcc (no spaces)
+					//			nn = # data bytes, aaaa = address, tt = type, cc = checksum
+					k = hex_chk();									// # record bytes, 0 = bad
+					flag = TRUE;									// default to data good
+					goteol = getbyte(&j);							// # data bytes
+					goteol |= getbyte(&tempbyte);					// address
+					goteol |= getbyte(&tempbyte2);
+					goteol |= getbyte(&i);							// type
+					if(goteol || (k != j + 5)){
+						flag = FALSE;								// bad chr, checksum, or count
+						i = 0xff;
+					}
+					ii = ((U16)tempbyte << 8) | ((U16)tempbyte2 & 0x00ff);
+					switch(i){
+						case 0x00:									// data
+							if((ii < SECTCH_ADDR) || (ii > (FLASH_END - j))){
+								flag = FALSE;						// outside the ch/msg sectors
+								break;
+							}
+							if((ii + j) > SECTCW_ADDR){
+								WARM_CLR();							// no warm restart into a msg being re-written
+							}
+							while(j--){
+								getbyte(&tempbyte);
+								tempword = ii++;
+#if U32_MSB != 0
+								if((tempword >= CHAN_ADDR) && (tempword < (CHAN_ADDR + (24 * NUM_CHAN)))){
+									tempword ^= U32_MSB;			// HEX is MS byte 1st, ch U32s are native (as "M")
+								}
+#endif
+								wr_flash(tempbyte, FLASH_X(tempword));
+								if(*FLASH_C(tempword) != tempbyte){
+									flag = FALSE;					// not erased
+								}
+							}
+							if(flag && (hex_n != 0xffff)) hex_n++;
+							break;
+
+						case 0x01:									// EOF
+							putss("\nHEX recs: ");
+							put_u16(hex_n);
+							putss(" err: ");
+							put_u16((U16)hex_e);
+							putss("\n");
+							hex_n = 0;
+							hex_e = 0;
+							break;
+
+						case 0x02:									// extended segment/linear address
+						case 0x04:
+							goteol = getbyte(&tempbyte);
+							goteol |= getbyte(&tempbyte2);
+							if(goteol || (j != 2) || tempbyte || tempbyte2){
+								flag = FALSE;						// only the 1st 64K
+							}
+							break;
+
+						case 0x03:									// start address (ignored)
+						case 0x05:
+							break;
+
+						default:
+							flag = FALSE;
+							break;
+					}
+					if(!flag){
+						if(hex_e != 0xff) hex_e++;
+						loaderr = 1;								// set error
+						putss("ERROR!\n");							// announce err
+					}
+					break;
+
+#if SWEEP_EN == 1
+				case 'S':
+				case 'H':
+					// sweep/hop
+					// syntax: S[L] ssss nn dddd, H[L] dddd cc cc.., SB ssss nn, S-
+					k = c;											// save cmd chr
+					flag = TRUE;									// default to data good
+					c = getch00();									// get option
+					swp_mode = SWP_OFF;								// stop any current sweep
+					swp_gate = (c == 'L') || (c == 'B');			// lock-gate option
+					if(c == '-'){
+						ipl2 = 1;									// re-load current channel
+						putss("\nswp stop\n");
+						break;
+					}
+					if(k == 'S'){
+						if(getbyte(&i) || getbyte(&j)) flag = FALSE;	// step
+						swp_step = (S16)(((U16)i << 8) | (U16)j);
+						if(getbyte(&swp_cnt)) flag = FALSE;			// # steps
+						swp_r0 = reg0_32;							// start from current channel
+						swp_r1 = reg1_32;
+						swp_full = 0;
+						swp_mode = SWP_LIN;
+					}
+					if(c != 'B'){
+						if(getbyte(&i) || getbyte(&j)) flag = FALSE;	// dwell
+						swp_dwell = ((U16)i << 8) | (U16)j;
+					}
+					if(k == 'H'){
+						swp_cnt = 0;
+						while(!getbyte(&tempbyte) && (swp_cnt < MAX_HOP)){
+							if(tempbyte >= NUM_CHAN) flag = FALSE;
+							if(swp_cnt & 0x01){
+								hop_tbl[swp_cnt >> 1] |= tempbyte & 0x0f;	// low nyb
+							}else{
+								hop_tbl[swp_cnt >> 1] = tempbyte << 4;	// high nyb
+							}
+							swp_cnt++;
+						}
+						swp_idx = 0;
+						swp_mode = SWP_HOP;
+					}
+					if(!flag || (swp_cnt == 0)){
+						swp_mode = SWP_OFF;
+						putss("ERROR!\n");							// announce err
+						break;
+					}
+					swp_next();										// calc 1st step
+					send_spi32((reg4_32 | RF_ENAB) & (~VCO_DISAB));	// RF on for the sweep
+					if(c == 'B'){
+						swp_bench();								// run benchmark and report
+						swp_mode = SWP_OFF;
+						ipl2 = 1;									// re-load current channel
+					}else{
+						swptimer = 0;								// 1st step on next pass
+						putss("\nswp\n");
+					}
+					break;
+#endif
+
+				case '+':
+				case '-':
+				case 'O':
+					// fine offset
+					// syntax: +[nn], -[nn], O (clear)
+					if(c == 'O'){
+						tempword = (U16)(-fine_ofs);				// back to nominal
+					}else{
+						if(getbyte(&tempbyte)){
+							tempbyte = 1;							// default = 1 FRAC step
+						}
+						tempword = (U16)tempbyte;
+						if(c == '-'){
+							tempword = (U16)(-(S16)tempword);
+						}
+					}
+					fine_ofs += (S16)tempword;
+					reg0_32 = add_frac(reg0_32, reg1_32, (S16)tempword);	// offset both tones
+					reg00_32 = add_frac(reg00_32, reg01_32, (S16)tempword);
+					if((fsk_enable && !last_key) || (dfcw_enable && last_tone)){
+						send_spi32(reg00_32);						// FSK "off"/DFCW dah tone is active
+					}else{
+						send_spi32(reg0_32);
+					}
+#if STATS_EN == 1
+					tempword = get_pca() - cmd_t0;
+#endif
+					putss("\nofs ");
+					if(fine_ofs < 0){
+						putch('-');
+						put_u16((U16)(-fine_ofs));
+					}else{
+						put_u16((U16)fine_ofs);
+					}
+#if STATS_EN == 1
+					putss(" rt us: ");								// cmd to R0 latch latency
+					put_u16(pca_us(tempword));
+#endif
+					putss("\n");
+					break;
+
+#if STATS_EN == 1
+				case 'K':
+					// PTT latency
+					// syntax: K, KC (clear)
+					c = getch00();
+					EX0 = 0;										// ISR owns the stats
+					if(c == 'C'){
+						ptt_lat = 0;
+						ptt_max = 0;
+						fsel_lat = 0;
+						fsel_max = 0;
+					}
+					tempword = ptt_lat;
+					ii = ptt_max;
+					EX0 = 1;
+					putss("\nptt us last/max: ");
+					put_u16(pca_us(tempword));
+					putch('/');
+					put_u16(pca_us(ii));
+					putss("\nfsel ms last/max: ");
+					put_u16(fsel_lat);
+					putch('/');
+					put_u16(fsel_max);
+					putss("\n");
+					break;
+
+#endif
+				case 'D':
+					// duty/idle fraction
+					// syntax: D, DC (clear), DT (toggle clock throttle)
+					c = getch00();
+					if(c == 'T'){
+						clk_en = !clk_en;
+					}
+#if STATS_EN == 1
+					EA = 0;											// ISR owns the counters
+					tempword = duty_tot;
+					ii = duty_idle;
+					EA = 1;
+					if(tempword == 0) tempword = 1;
+					putss("\nidle %: ");
+					put_u16((U16)(((U32)ii * 100L) / (U32)tempword));
+					EA = 0;											// 2nd snapshot, the tot/lo pair is from one instant
+					tempword = duty_tot;
+					ii = duty_lo;
+					if(c == 'C'){
+						duty_tot = 0;
+						duty_idle = 0;
+						duty_lo = 0;
+					}
+					EA = 1;
+					if(tempword == 0) tempword = 1;
+					putss("  lo clk %: ");
+					put_u16((U16)(((U32)ii * 100L) / (U32)tempword));
+#endif
+					if(!clk_en){
+						putss("  (throttle off)");
+					}
+					putss("\n");
+					break;
+
+#if STATS_EN == 1
+				case 'W':
+					// worst case main loop pass time
+					// syntax: W, WC (clear)
+					putss("\nloop us max: ");
+					if(loop_max == 0xffff){
+						putss(">32000");
+					}else{
+						put_u16(pca_us(loop_max));
+					}
+					putss("\n");
+					if(getch00() == 'C'){
+						loop_max = 0;
+					}
+					break;
+#endif
+
+				case 'A':
+					// multi-drop unit ID
+					// syntax: A (display), A hh (set, 01 - FE), A- (clear)
+					c = peekch(0);
+					if(c != '\r'){
+						if(c == '-'){
+							tempbyte = 0;							// logged as 00
+						}else{
+							if(getbyte(&tempbyte) || (tempbyte == 0) || (tempbyte == ID_NONE)){
+								putss("ERROR!\n");
+								break;
+							}
+						}
+						if(adr_all || id_put(tempbyte)){
+							putss("ERROR!\n");						// broadcast, or log full ("EC" compacts it)
+							break;
+						}
+						unit_id = id_get();
+						id_port();
+					}
+					putss("\nID ");
+					if(unit_id == ID_NONE){
+						putss("none\n");
+					}else{
+						put_hex(unit_id);
+						putss("\n");
+					}
+					break;
+
+				case 'X':
+					// reset/warm restart stats
+					// syntax: X, XC (clear), XW (force WDT rst), XS (force sw rst), XB (bootloader)
+					c = getch00();
+					if(c == 'W'){
+						putss("\nWDT rst\n");
+						while(!txidle());
+						EA = 0;										// hang, starve the WDT
+						while(!EA);									//	(a loop the host sim can time, EA stays 0)
+					}
+					if(c == 'S'){
+						putss("\nsw rst\n");
+						while(!txidle());
+						RSTSRC = SWRSF | PORSF;						// keep the VDD monitor enabled
+					}
+#if BOOT_EN == 1
+					if(c == 'B'){
+						putss("\nboot\n");
+						while(!txidle());
+						EA = 0;
+						((U8 idata *) BOOT_REQ)[0] = (U8)(BOOT_MAGIC >> 8);	// update request (over warm.magic)
+						((U8 idata *) BOOT_REQ)[1] = (U8)BOOT_MAGIC;
+						RSTSRC = SWRSF | PORSF;
+					}
+#endif
+					warm_rpt();
+					boot_rpt();
+#if WARM_EN == 1
+					if(c == 'C'){
+						warm.n_wdt = 0;
+						warm.n_bod = 0;
+						warm.n_pin = 0;
+						warm.n_fle = 0;
+						warm.crc = warm_crc();
+					}
+#endif
+					break;
+
+#if TRC_EN == 1
+				case 'T':
+					// event trace dump (oldest first)
+					// syntax: T (hex), TB (binary), TC (clear)
+					c = getch00();
+					if(c == 'C'){
+						trc_on = 0;
+						for(i=0; i<TRC_LEN; i++){
+							trc_ev[i] = TRC_NONE;
+						}
+						trc_on = 1;
+						putss("\n");
+					}else{
+						trc_dump(c == 'B');
+					}
+					break;
+#endif
+
+#if STATS_EN == 1
+				case 'B':
+					// on-board benchmark (SPI, DAC, flash, CRC, serial)
+					// syntax: B
+					if(vco_on || ptt_on || (key_st != KEY_IDLE)){
+						putss("\nRF on\n");						// only with the key up
+					}else if(cw_on && !erase_hold){
+						putss("\nmsg on\n");						// and not in the middle of a msg
+					}else{
+						bench();
+					}
+					break;
+#endif
+
+
+				case 'l':
+				case 'L':
+					// read PLL lock bit
+					// syntax: l, return "1" or "0"
+					//		   LT [hhhh m], LX
+					c = getch00();
+					if(c == 'T'){
+						if(!getbyte(&i) && !getbyte(&j)){
+							tempword = ((U16)i << 8) | (U16)j;		// timeout (us)
+							if((tempword == 0) || (tempword > 30000)){
+								putss("ERROR!\n");					// PCA wraps at 32 ms
+								break;
+							}
+							lock_tmo = (U16)(((U32)tempword * 204L) / 100L);	// us to PCA tics
+							lock_mute = 0;
+							if(!getbyte(&tempbyte)){
+								lock_mute = tempbyte & 0x01;		// fallback mode
+							}
+#if STATS_EN == 1
+							lk_n = 0;								// clear stats
+							lk_fail = 0;
+							lk_max = 0;
+							lk_sum = 0;
+#endif
+						}
+						lock_rpt();
+						break;
+					}
+#if STATS_EN == 1
+					if(c == 'X'){
+						send_spi32(chan_ptr[2] | 0x20);				// simulate lock loss (R2 power-down)
+						putss("\nR2 PD\n");
+						break;
+					}
+#endif
+					if(MISO == PLL_LOCK){
+						putss("1\n");
+					}else{
+						putss("0\n");
+					}
+					break;
+
+				case '?':
+					// Help screen
+					putss("\nOrion Help Ver0.26 11-19-18\n");
+					putss("Mnna..f: PGM CH nn\n");
+					putss("EC: erase all CH\t\tEM: erase msg\n");
+					putss("c: disp ch CRC16 (0x1021 poly)\tz hhhh: cmp CRC16\n");
+					putss("cm: disp msg crc \t\tzm hhhh: cmp msg crc\n");
+					putss("rnn: read CH nn\t\t\tr-: read all CH\n");
+					putss("t00a..f: temp reg\t\tt-: temp reg off\n");
+					putss("rr: read temp reg\t\tO: clr fine ofs\n");
+					putss("+[nn]/-[nn]: fine ofs (FRAC)\n");
+					putss("Q: querry errs\t\t\tQC: Clr errs\n");
+					putss("i: re-send CH\t\t\te: echo cmdln\n");
+					putss("Ciiiidd..: Pgm CWmsg @IDX iiii\tL: read PLL lock stat\n");
+					putss("R: read CW msg\n");
+					putss(":nnaaaatt..cc: Intel HEX record\n");
+					putss("A [hh]: unit ID [set]\t\tA-: clr ID\n");
+					putss("@hh cmd: addressed cmd\t\t@00 cmd: broadcast\n");
+					putss("LT [hhhh m]: lock stats [set tmo us, m=1 mute]\n");
+#if STATS_EN == 1
+					putss("LX: sim lock loss\n");
+					putss("K: PTT/FSEL latency\t\tKC: clr latency\n");
+					putss("W: max loop time\t\tWC: clr loop time\n");
+					putss("D: idle/lo clk %\t\tDC: clr  DT: tog throttle\n");
+#else
+					putss("DT: tog throttle\n");
+#endif
+					putss("X: rst stats\t\t\tXC: clr  XW/XS: WDT/sw rst\n");
+#if BOOT_EN == 1
+					putss("XB: bootloader (fw update)\n");
+#endif
+#if TRC_EN == 1
+					putss("T: trace dump\t\t\tTB: binary  TC: clr\n");
+#endif
+#if STATS_EN == 1
+					putss("B: benchmark (key up)\n");
+#endif
+#if FREQ_EN == 1
+					putss("Fnn f.f: PGM CH nn @ MHz\tFt f.f: temp reg @ MHz\n");
+					putss("FV: verify CH vs calc\n");
+#endif
+#if SWEEP_EN == 1
+					putss("S[L] ssss nn dddd: sweep\tH[L] dddd cc..: hop\n");
+					putss("SB ssss nn: sweep bench\tS-: stop sweep\n");
+#endif
+					break;
+			}
+			if(cli_st == CLI_IDLE){
+				cleanline();										// clean up rest of current line
+				putss("\nbkn>");									// post prompt
+				tx_mute(unit_id != ID_NONE);						// addressed units go quiet again
+			}
+			cli_run = 0;
+		}else if(cli_st != CLI_IDLE){
+			// CLI/flash task, deferred cmd states
+			switch(cli_st){
+				default:
+					cli_st = CLI_IDLE;
+					break;
+
+				case CLI_EYES:
+					c = '\0';
+					if((unit_id != ID_NONE) || (peekch(0) == '@')){
+						if(gotcr() && addr_chk()){					// addressed confirm line ("@hh Y")
+							c = getch00();
+						}
+					}else{
+						if(gotch00()){
+							c = getch00();
+						}
+					}
+					if(c){
+						if(c == 'Y'){
+							putss("\nerasing:");
+							erase_hold = TRUE;						// set erase hold
+							cw_on = 0;
+							WARM_CLR();								// no warm restart into a msg being re-written
+							key_flush();
+							send_spi32(reg4_32);					// keyup
+							cli_st = CLI_ERASE;
+						}else{
+							cli_st = CLI_IDLE;
+						}
+					}else{
+						if(clitimer == 0){
+							cli_st = CLI_IDLE;						// timeout
+						}
+					}
+					if(cli_st == CLI_IDLE){
+						putss("Aborted.\n");						// abort msg
+					}
+					break;
+
+				case CLI_ERASE:
+					if(fptr < FLASH_X(FLASH_END - 1)){
+						PCA0MD &= ~WDTE;							// sector erase stalls the CPU past the WDT timeout
+#if STATS_EN == 1
+						bm_start();
+						erase_flash(fptr);							// erase one sector per pass
+						bm_erase = (U16)((bm_stop() * 49L) / 100L);	// us, for "B"
+#else
+						erase_flash(fptr);							// erase one sector per pass
+#endif
+						PCA0MD |= WDTE;
+						if((fptr == FLASH_X(UNIT_ID_ADDR)) && (unit_id != ID_NONE)){
+							wr_flash(unit_id, fptr);				// keep the unit ID (1st log byte)
+						}
+					}
+					fptr += SECTOR_SIZE;							// set next sector
+					putch('.');										// display progress
+					if(--j == 0){
+						putss("Erased!\n");							// announce completion
+						cli_st = CLI_IDLE;
+					}
+					break;
+
+				case CLI_ZDLY:
+					if(clitimer == 0){
+						if(j){
+							putss("\nPASS\n");
+						}else{
+							loaderr = 1;							// set global fail
+							putss("\nFAIL\n");
+						}
+						cli_st = CLI_IDLE;
+					}
+					break;
+			}
+			if(cli_st == CLI_IDLE){
+				cleanline();										// clean up rest of current line
+				putss("\nbkn>");									// post prompt
+				tx_mute(unit_id != ID_NONE);						// addressed units go quiet again
+			}
+		}
+		if(ipl){
+			// boot banner (background, after the 1st RF)
+			if(!boot_run || erase_hold || (boot_ms > BOOT_TMO)){
+				boot_ptr = (char code*)putsnb(boot_ptr);			// send what fits in the tx buffer
+				if((*boot_ptr == '\0') && ((boot_seq == 0) || txidle())){	// putss() reports, tx buffer drains 1st
+					switch(boot_seq++){
+						case 0:
+							boot_ptr = boot_hlp;
+							break;
+
+						case 1:
+							cli_run = 1;							// the msg runs while these wait (tx_wait())
+							if(RSTSRC & 0x40){
+								putss("FLERR\n");
+								RSTSRC &= ~0x40;
+							}
+							boot_rpt();								// reset to 1st RF
+							cli_run = 0;
+							boot_run = 0;
+							ipl = 0;								// banner done
+							break;
+					}
+				}
+			}
+		}
+		if(!ipl2 && !elem_flag && !ptt_evt && !fsel_chg && (cli_st != CLI_ERASE) && ((key_st == KEY_IDLE) || keytimer)){
+			cpu_idle = 1;
+			PCON |= 0x01;											// idle until the next intr (Timer2, UART, PTT, FSEL)
+			PCON = PCON;											// dummy 3-cycle instr after idle
+			cpu_idle = 0;
+		}
+	}
+}  // end main()
+
+// *********************************************
+//  *************** SUBROUTINES ***************
+// *********************************************
+
+//-----------------------------------------------------------------------------
+// valid_cw()
+//-----------------------------------------------------------------------------
+//
+// scans CW message space for a CW_STOP.  If none found before end of FLASH,
+//	return FALSE, else TRUE
+//
+U8 valid_cw(U8 code * ptr){
+	U8	i = FALSE;		// temp
+	
+	while((ptr != FLASH_C(FLASH_END - 1)) && !i){
+		if(*ptr++ == CW_STOP){
+			i = TRUE;
+		}
+	}
+	return i;
+}
+
+//-----------------------------------------------------------------------------
+// dfcw_dah()
+//-----------------------------------------------------------------------------
+//
+// returns TRUE if the element that starts at ptr/mask is a dah ("111"), else FALSE.
+//	Looks ahead across a byte boundary, but not into an embedded command.
+//
+U8 dfcw_dah(U8 code* ptr, U8 mask){
+	U8	i;
+	U8	rtn = TRUE;		// temp
+
+	for(i=0; (i<2) && rtn; i++){
+		mask >>= 1;
+		if(!mask){
+			mask = 0x80;
+			ptr += 1;
+			if(*ptr == CW_STOP){
+				rtn = FALSE;						// element ends at an embedded cmd
+			}
+		}
+		if(!(*ptr & mask)){
+			rtn = FALSE;							// element ends in less than 3 bits
+		}
+	}
+	return rtn;
+}
+
+//-----------------------------------------------------------------------------
+// add_frac()
+//-----------------------------------------------------------------------------
+//
+// returns R0 with "step" added to FRAC.  FRAC over/underflow is carried into INT
+//	using the MOD value from r1 (R1's low word).  R0 control bits [2:0] are always 0.
+//
+U32 add_frac(U32 r0, U16 r1, S16 step){
+	S16	mod;		// MOD from R1
+	S16	frac;		// FRAC from R0
+
+	mod = (S16)((r1 >> 3) & 0x0fff);
+	frac = (S16)((r0 >> 3) & 0x0fff);
+	r0 = (U16)(r0 >> 15);							// INT (r0 is reused)
+	if(mod == 0) mod = 1;							// trap erased/invalid MOD
+	while(step >= mod){								// reduce step to less than MOD
+		step -= mod;
+		r0++;
+	}
+	while(step <= -mod){
+		step += mod;
+		r0--;
+	}
+	frac += step;
+	if(frac >= mod){								// carry into INT
+		frac -= mod;
+		r0++;
+	}
+	if(frac < 0){									// borrow from INT
+		frac += mod;
+		r0--;
+	}
+	return ((U32)(U16)r0 << 15) | ((U32)frac << 3);
+}
+
+//-----------------------------------------------------------------------------
+// retune() live re-tunes the PLL to the temp register set at p (R0).  If R4 matches the
+//	cached R4 (apart from the keying bits), only R1 (if changed) and R0 are sent so that keying is not disturbed.
+//	The caller checks R2, R3, and R5 against the loaded set (p may be the loaded set, so they can't be
+//	compared here).  The fine offset is applied to R0.  returns TRUE if a full channel load is needed.
+//-----------------------------------------------------------------------------
+U8 retune(U32* p){
+
+	if((p[4] ^ reg4_32) & ~(RF_ENAB | VCO_DISAB)){
+		return TRUE;									// R4 differs in more than the keying bits
+	}
+	chan_ptr = p;
+	if(p[1] != reg1_32){
+		send_spi32(p[1]);								// MOD changed, send R1 (latched by R0 write)
+	}
+	reg1_32 = p[1];										// temp reg has no next channel, FSK/DFCW tones are the same
+	reg01_32 = reg1_32;
+	reg0_32 = p[0];
+	if(fine_ofs){
+		reg0_32 = add_frac(reg0_32, reg1_32, fine_ofs);
+	}
+	reg00_32 = reg0_32;
+	send_spi32(reg0_32);
+	return FALSE;
+}
+
+//-----------------------------------------------------------------------------
+// lock_wait()
+//-----------------------------------------------------------------------------
+//
+// waits for PLL lock-detect (MISO = PLL_LOCK).  returns # PCA tics to lock,
+//	or LOCK_FAIL if no lock within lock_tmo PCA tics.
+//
+U16 lock_wait(void){
+	U16	t0;			// start time
+
+	t0 = get_pca();
+	wdt_ms = 0;										// benches call this back-to-back
+	do{
+		if(MISO == PLL_LOCK){
+			return get_pca() - t0;
+		}
+	}while((U16)(get_pca() - t0) < lock_tmo);
+	return LOCK_FAIL;
+}
+
+//-----------------------------------------------------------------------------
+// elem_task() processes a msg element edge (elem_flag, set by Timer2_ISR): steps
+//	the msg bit stream and starts the keyout transition and RF frames.  Called by
+//	main(), and by tx_wait() while a CLI report waits on the UART.
+//-----------------------------------------------------------------------------
+void elem_task(void){
+	U8	k;			// DFCW RF on frame
+	U8	tempbyte;	// msg cmd parameter, temp
+
+	elem_flag = 0;
+	key_flush();												// finish last keyout transition
+	if(!cwmask){
+		cwmask = 0x80;
+		cwptr += 1;
+		if(*cwptr == CW_STOP){									// CW_STOP = 0x18 is now a command indicator
+			++cwptr;											// point to parameter byte
+			tempbyte = *cwptr;									// get parameter byte (next byte after CW_STOP)
+			switch(tempbyte & 0xf0){							// mask cmd nybble and process switch
+				default:										// unrecognized params process as EOM
+				case CW_EOM:									// end of message
+					setkeyout(0);								// delay <ramp_delay> for wave shaping
+//								KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// turn off keyIO
+					key_frame(KF_R4);							// transfer channel data to PLL (turn off RF)
+					msgpre = msg_scale;							// msgtimer counts in msg_scale ms tics
+					msgtimer = ((U16)diode_matrix[DLY_IDX] << 8) | ((U16)diode_matrix[DLY_IDX+1] & 0xff);
+					cw_on = 0;
+					if(last_key || !(dfcw_enable || fsk_enable)){
+						key_flush();							// the "0" element below keys down again
+					}
+					break;
+				
+				case CW_IOP:									// I/O++
+					tempbyte = P1 & 0x70;						// mask I/O bits
+					tempbyte = (tempbyte + 0x10) & 0x70;		// add 1 & mask I/O bits
+					P1 = (P1 & 0x8f) | tempbyte;				// update I/O
+					break;
+				
+				case CW_IOM:									// I/O--
+					tempbyte = P1 & 0x70;						// mask I/O bits
+					tempbyte = (tempbyte - 0x10) & 0x70;		// subtract 1 & mask I/O bits
+					P1 = (P1 & 0x8f) | tempbyte;				// update I/O
+					break;
+				
+				case CW_CHSET:									// set ch
+					CHtemp = tempbyte & 0x0f;					// get ch# (only recognizes lower 4 bits)
+					CHrun = 0;									// make sure semaphore is clear
+					CHdelta = 0;
+					ipl2 = 1;									// reset channel only
+					break;
+				
+				case CW_CHADD:									// add ch
+					CHdelta = (CHdelta + tempbyte) & 0x0f;		// add ch# (only recognizes lower 4 bits)
+					CHrun = 0;									// make sure semaphore is clear
+					ipl2 = 1;									// reset channel only
+					break;
+				
+				case CW_CHCLR:									// clr deltach
+					if(CHdelta > (tempbyte & 0x0f)){
+						CHdelta = 0;							// add ch# (only recognizes lower 4 bits)
+						CHrun = 0;								// make sure semaphore is clear
+						ipl2 = 1;								// reset channel only
+					}
+					break;
+				
+				case CW_IOSET:									// set I/O
+					if((tempbyte & 0x08) == 0){					// if bit 3 set, it is a NOP cmd
+						tempbyte &= 0x07;						// mask I/O bits
+						tempbyte <<= 4;							// align to I/O bits
+						P1 = (P1 & 0x8f) | tempbyte;			// mask off I/O bits and update I/O
+					}
+					break;
+			}
+			cwmask = 0;	 										// clear mask to trigger increment to next msg byte
+		}
+	}
+	if(dfcw_enable){												// is DFCW mode
+		if(*cwptr & cwmask){										// if element == "1"
+			if(!last_key){											// start of element, select dit or dah tone
+				k = KF_R4_ON;
+				if(dfcw_dah(cwptr, cwmask)){						// dah = "111", send as one dit period on the dah tone
+					if(!last_tone){
+						send_spi32(reg01_32);						// transfer dah tone data to PLL (RF is off)
+						send_spi32(reg00_32);
+						last_tone = 1;
+						k = KF_R4_LK;								// RF on waits for lock (below)
+					}
+					for(tempbyte=0; tempbyte<2; tempbyte++){		// consume the rest of the dah
+						cwmask >>= 1;
+						if(!cwmask){
+							cwmask = 0x80;
+							cwptr += 1;
+						}
+					}
+				}else{
+					if(last_tone){
+						send_spi32(reg1_32);						// transfer dit tone data to PLL
+						send_spi32(reg0_32);
+						last_tone = 0;
+						k = KF_R4_LK;
+					}
+				}
+				if(k == KF_R4_LK){
+					send_spi32(reg4_32 & ~(VCO_DISAB | RF_ENAB));	// VCO on, RF off: lock during the keyout delay
+				}
+				if(dacmode){										// turn on RF as OOK mode
+					key_frame(k);									// (use DAC to ramp)
+					setkeyout(1);
+				}else{
+					setkeyout(1);
+					key_frame(k);									// (use RC ramp)
+				}
+			}
+			last_key = 1;											// update key memory
+		}else{														// else element == "0"
+			if(last_key){
+				setkeyout(0);
+				key_frame(KF_R4_OFF);					// transfer channel data to PLL (turn off RF)
+			}
+			last_key = 0;											// update key memory
+		}
+	}else if(fsk_enable){											// is FSK mode
+		if(*cwptr & cwmask){										// if element == "1"
+			if(!last_key){
+				setkeyout(1);
+//							KEYOUT = diode_matrix[0] & KEY_MASK;				// turn on keyIO
+				key_frame(KF_R1);									// transfer FSK "ON" data to PLL
+				key_frame(KF_R0);									// transfer FSK "ON" data to PLL
+			}
+			last_key = 1;											// update key memory
+		}else{														// else element == "0"
+			if(last_key){
+				setkeyout(0);
+//							KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;	// element = "0", turn off keyIO
+				key_frame(KF_R01);								// transfer FSK "OFF" data to PLL
+				key_frame(KF_R00);								// transfer FSK "OFF" data to PLL
+			}
+			last_key = 0;											// update key memory
+		}
+	}else{															// is OOK mode
+		if(*cwptr & cwmask){										// if element == "1"
+			if(dacmode){
+				send_spi32(reg4_32 & (~VCO_DISAB));					// transfer channel data to PLL (use DAC to ramp)
+				setkeyout(1);
+			}else{
+				setkeyout(1);
+				key_frame(KF_R4_ON);					// transfer channel data to PLL (use RC ramp)
+			}
+//						KEYOUT = diode_matrix[0] & KEY_MASK;					// turn on keyIO
+//						wait(1);
+		}else{														// else element == "0"
+			setkeyout(0);
+//						KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// element = "0", turn off keyIO
+//						wait((U16)diode_matrix[RMP_IDX] & 0xff);				// delay <ramp_delay> for wave shaping
+			key_frame(KF_R4_OFF);						// transfer channel data to PLL (turn off RF)
+		}
+	}
+	cwmask >>= 1;												// update cwmask
+#if WARM_EN == 1
+	warm_save(CHtemp, CHdelta, cwptr, cwmask);					// next element, for a warm restart
+#endif
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// tx_wait() is called by putch() while it waits for room in the tx buffer.  A CLI
+//	report longer than the buffer holds its main loop pass for about 1 ms per chr,
+//	so the key task and the msg element edges are run from here.  Only while a cmd (or
+//	a status msg) runs, and not while PTT, a channel load, an erase, or a sweep owns the PLL.
+//-----------------------------------------------------------------------------
+void tx_wait(void){
+
+	if(!cli_run || ptt_on || ptt_evt || ipl2 || erase_hold){
+		return;
+	}
+#if SWEEP_EN == 1
+	if(swp_mode != SWP_OFF){
+		return;
+	}
+#endif
+	cli_run = 0;										// no re-entry
+	key_task();
+	if(elem_flag){
+		elem_task();
+	}
+	cli_run = 1;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// chan_load() sends the register set at p (R0) to the PLL, R5 first, using r0 in place
+//	of p[0].  returns # PCA tics to lock, or LOCK_FAIL
+//-----------------------------------------------------------------------------
+U16 chan_load(U32* p, U32 r0){
+	U8	i;
+
+	TRC_LD(1);
+	for(i=5; i!=0; i--){
+		send_spi32(p[i]);								// R5 - R1
+	}
+	send_spi32(r0);
+	TRC_LD(0);
+	return lock_wait();
+}
+
+//-----------------------------------------------------------------------------
+// lock_log() records the lock time for a channel load
+//-----------------------------------------------------------------------------
+#if STATS_EN == 1
+void lock_log(U8 ch, U16 tlock){
+
+	lk_pair[lk_idx] = (lk_last << 4) | (ch & 0x0f);
+	lk_time[lk_idx] = tlock;
+	if(++lk_idx == LOCK_LOG){
+		lk_idx = 0;
+	}
+	lk_last = ch;
+	lk_n++;
+	if(tlock == LOCK_FAIL){
+		lk_fail++;
+		tlock = lock_tmo;								// dead time is the timeout
+	}
+	if(tlock > lk_max){
+		lk_max = tlock;
+	}
+	lk_sum += tlock;
+	return;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// lock_rpt() displays the lock-detect timeout, and the lock log and stats (STATS_EN)
+//-----------------------------------------------------------------------------
+void lock_rpt(void){
+#if STATS_EN == 1
+	U8	i;
+	U8	j;
+#endif
+
+	putss("\ntmo us: ");
+	put_u16(pca_us(lock_tmo));
+	if(lock_mute){
+		putss(" mute");
+	}
+	putss("\n");
+#if STATS_EN == 1
+	i = LOCK_LOG;
+	if(lk_n < LOCK_LOG){
+		i = (U8)lk_n;									// log not full yet
+	}
+	j = (lk_idx + LOCK_LOG - i) % LOCK_LOG;				// oldest entry
+	while(i--){
+		put_dec(lk_pair[j] >> 4);						// from-to
+		putch('-');
+		put_dec(lk_pair[j] & 0x0f);
+		putch(' ');
+		if(lk_time[j] == LOCK_FAIL){
+			putss("no lock\n");
+		}else{
+			put_u16(pca_us(lk_time[j]));
+			putss("\n");
+		}
+		if(++j == LOCK_LOG){
+			j = 0;
+		}
+	}
+	putss("loads: ");
+	put_u16(lk_n);
+	putss("  no lock: ");
+	put_u16(lk_fail);
+	if(lk_n){
+		putss("\nlock us avg/max: ");
+		put_u16(pca_us((U16)(lk_sum / lk_n)));
+		putch('/');
+		put_u16(pca_us(lk_max));
+		putss(" (fixed ");
+		put_u16(LOCK_FIXED);
+		putch(')');
+	}
+	putss("\n");
+#endif
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// lksup_rec() ends a lock loss event
+//-----------------------------------------------------------------------------
+void lksup_rec(void){
+
+	lk_lost = 0;
+	lk_miss = 0;
+	return;
+}
+
+#if WARM_EN == 1
+//-----------------------------------------------------------------------------
+// warm_crc() returns the CRC of the warm restart state block (less the crc field)
+//-----------------------------------------------------------------------------
+U16 warm_crc(void){
+	U8 idata* p;
+	U16	crc;
+
+	crc = 0;
+	for(p = (U8 idata*)&warm; p < (U8 idata*)&warm.crc; p++){
+		crc = calcrc(*p, crc);
+	}
+	return crc;
+}
+
+//-----------------------------------------------------------------------------
+// warm_chk() returns TRUE if the warm restart state block survived the reset
+//	(marker, CRC, and msg position are valid).  A power-on leaves random RAM, which
+//	fails the marker/CRC.
+//-----------------------------------------------------------------------------
+U8 warm_chk(void){
+
+	if(warm.magic != WARM_MAGIC) return FALSE;
+	if(warm.crc != warm_crc()) return FALSE;
+	if((warm.pos < (MSG_IDX - 1)) || (warm.pos >= (FLASH_END - SECTCW_ADDR))) return FALSE;
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+// warm_save() saves the msg state (channel, next element, and pause timer) to the
+//	warm restart state block
+//-----------------------------------------------------------------------------
+void warm_save(U8 ch, U8 delta, U8 code* ptr, U8 mask){
+
+	warm.magic = WARM_MAGIC;
+	warm.ch = ch;
+	warm.delta = delta;
+	warm.pos = (U16)(ptr - (U8 code*)diode_matrix);
+	warm.mask = mask;
+	warm.io = P1 & 0x70;
+	if(cw_on){
+		warm.io |= WARM_CW;
+	}
+	EA = 0;											// 16b timer, don't let Timer2 see a partial read
+	warm.msgtimer = msgtimer;
+	EA = 1;
+	warm.crc = warm_crc();
+	return;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// boot_rpt() displays the reset to 1st RF time
+//-----------------------------------------------------------------------------
+void boot_rpt(void){
+
+	if(boot_run){
+		putss("boot: no RF\n");
+	}else{
+		putss("boot us: ");
+#if STATS_EN == 1
+		if(boot_ms < 32){
+			put_u16(pca_us(boot_pca));
+		}else{
+			put_u16(boot_ms);
+			putss("000");
+		}
+#else
+		put_u16(boot_ms);								// ms resolution
+		putss("000");
+#endif
+		putss("\n");
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// warm_rpt() displays the reset source and the warm restart stats
+//-----------------------------------------------------------------------------
+void warm_rpt(void){
+
+	putss("\nrst src: ");
+	put_hex(rst_src);
+#if WARM_EN == 1
+	if(warm_rst){
+		putss("  (warm)");
+	}
+	putss("\nwdt: ");
+	put_u16(warm.n_wdt);
+	putss("  bod: ");
+	put_u16(warm.n_bod);
+	putss("  pin/sw: ");
+	put_u16(warm.n_pin);
+	putss("  flerr: ");
+	put_u16(warm.n_fle);
+#endif
+	putss("\n");
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// bm_start() starts a bench timer.  bm_stop() returns the elapsed PCA tics, using
+//	the PCA overflow flag to extend the count past one wrap (max 64 ms).
+//-----------------------------------------------------------------------------
+#if STATS_EN == 1
+void bm_start(void){
+
+	CF = 0;
+	bm_t0 = get_pca();
+	return;
+}
+
+U32 bm_stop(void){
+	U16	t;
+	U32	n;
+
+	t = get_pca();
+	n = (U32)t;
+	if(CF){
+		n += 0x10000L;								// PCA wrapped once
+	}
+	return n - (U32)bm_t0;
+}
+
+//-----------------------------------------------------------------------------
+// bm_put() displays a bench result line: name, # loops, and us per loop (0.1 us)
+//-----------------------------------------------------------------------------
+void bm_put(char* s, U8 n, U32 tics){
+
+	putss(s);
+	put_u16(n);
+	putss("x  us: ");
+	tics = (tics * 49L) / (U32)n / 10L;				// 0.1 us per loop
+	put_u16((U16)(tics / 10L));
+	putch('.');
+	putch((char)(tics % 10L) + '0');
+	putss("\n");
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// bench() times the board primitives and displays the results.  Only called with
+//	the key up: the PLL gets the current (keyup) R4, the DAC gets the keyup level,
+//	and the flash write is 0xff to a blank byte in the spare area (no change).
+//	Sector erase is not run here (no spare sector), the last "EC"/"EM" erase is shown.
+//-----------------------------------------------------------------------------
+void bench(void){
+	U8	i;
+	U16	j;
+	U16	crc;
+	U8 code * p;
+
+	putss("\nSYSCLK: ");
+	put_u16((U16)(SYSCLK / 1000L));
+	putss(" kHz  SPI0CKR: ");
+	put_hex(SPI0CKR);
+	putss("  REVC: ");
+	put_dec(REVC_HW);
+	putss("\n");
+	// 32b PLL frame
+	bm_start();
+	for(i=0; i<BM_N; i++){
+		send_spi32(reg4_32);
+	}
+	bm_put("spi32 ", BM_N, bm_stop());
+	// DAC frame
+	if(dacmode){
+		bm_start();
+		for(i=0; i<BM_N; i++){
+			send_spi8(DAC_SET, diode_matrix[RTBL_IDX]);
+		}
+		bm_put("dac8  ", BM_N, bm_stop());
+	}
+	// flash byte write
+	for(p = FLASH_C(SECTCH_ADDR); (p < FLASH_C(CHAN_ADDR)) && (*p != 0xff); p++);
+	if(p < FLASH_C(CHAN_ADDR)){
+		bm_start();
+		for(i=0; i<BM_NFL; i++){
+			wr_flash(0xff, (U8 xdata *)p);
+		}
+		bm_put("flwr  ", BM_NFL, bm_stop());
+	}
+	// CRC pass over the channel array
+	crc = 0;
+	p = FLASH_C(CHAN_ADDR);
+	bm_start();
+	for(j=0; j<(NUM_CHAN * MAX_REG); j++){
+		crc = calcrc(*p++, crc);
+	}
+	bm_put("crc   ", 1, bm_stop());
+	putss("  (");
+	put_u16(NUM_CHAN * MAX_REG);
+	putss(" B)\n");
+	// sector erase
+	putss("erase ms: ");
+	if(bm_erase){
+		put_u16(bm_erase / 1000);
+		putch('.');
+		putch((char)((bm_erase % 1000) / 100) + '0');
+	}else{
+		putss("-");
+	}
+	putss("\n");
+	// serial
+	while(!txidle());
+	bm_start();
+	for(i=0; i<BM_SER; i++){
+		putch('-');
+	}
+	while(!txidle());
+	putss("\nser cps: ");
+	put_u16((U16)(((U32)BM_SER * (SYSCLK / 12L)) / bm_stop()));
+	putss("\n");
+	return;
+}
+#endif
+
+
+#if TRC_EN == 1
+//-----------------------------------------------------------------------------
+// trc_put() adds an event to the trace ring (main() context)
+//-----------------------------------------------------------------------------
+void trc_put(U8 e){
+
+	if(!trc_ld || ((e & 0xe0) != TRC_SPI)){
+		TRC(e);
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// trc_spi() returns the trace event for a PLL SPI frame
+//-----------------------------------------------------------------------------
+U8 trc_spi(U32 d){
+	U8	e;
+
+	e = TRC_SPI | ((U8)d & 0x07);					// reg#
+	if(((U8)d & 0x07) == 0x04){
+		if(!(d & VCO_DISAB)) e |= 0x08;				// R4: VCO on
+		if(d & RF_ENAB) e |= 0x10;					// R4: RF on
+	}
+	return e;
+}
+
+//-----------------------------------------------------------------------------
+// trc_dump() sends the trace ring, oldest first.  bin = 0 sends one record per line
+//	as "ee mm tttt" (event, ms count, PCA count, hex).  bin = 1 sends "TB", the #
+//	of records, then 4 bytes per record (ee, mm, tt, tt).  Empty records are skipped.
+//	Tracing is held off while the ring is sent.
+//-----------------------------------------------------------------------------
+void trc_dump(U8 bin){
+	U8	i;
+	U8	j;
+	U8	n;
+
+	trc_on = 0;
+	n = 0;
+	for(i=0; i<TRC_LEN; i++){
+		if(trc_ev[i] != TRC_NONE) n++;
+	}
+	if(bin){
+		putch('T');									// header
+		putch('B');
+		putch(n);
+	}else{
+		putss("\n");
+	}
+	j = trc_idx;
+	for(i=0; i<TRC_LEN; i++){
+		if(trc_ev[j] != TRC_NONE){
+			if(bin){
+				putch(trc_ev[j]);
+				putch(trc_ms[j]);
+				putch(trc_th[j]);
+				putch(trc_tl[j]);
+			}else{
+				put_hex(trc_ev[j]);
+				putch(' ');
+				put_hex(trc_ms[j]);
+				putch(' ');
+				put_hex(trc_th[j]);
+				put_hex(trc_tl[j]);
+				putss("\n");
+			}
+		}
+		j = (j + 1) & (TRC_LEN - 1);
+	}
+	trc_on = 1;
+	return;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// get_pca() returns the PCA0 count (SYSCLK/12 tics)
+//-----------------------------------------------------------------------------
+U16 get_pca(void){
+	U16	t;
+	bit	EA_save;
+
+	EA_save = EA;
+	EA = 0;											// an ISR reading PCA0L between these would re-latch PCA0H
+	t = (U16)HAL_PCA_LO();							// reading PCA0L latches PCA0H
+	t |= (U16)HAL_PCA_HI() << 8;
+	EA = EA_save;
+	return t;
+}
+
+//-----------------------------------------------------------------------------
+// pca_us() converts PCA tics to us (SYSCLK/12 = 2.04 MHz, 0.49 us/tic)
+//-----------------------------------------------------------------------------
+U16 pca_us(U16 tics){
+
+	return (U16)(((U32)tics * 49L) / 100L);
+}
+
+#if SWEEP_EN == 1
+//-----------------------------------------------------------------------------
+// swp_next() calculates the register data for the next sweep/hop step
+//-----------------------------------------------------------------------------
+void swp_next(void){
+	U8	i;			// temps
+	U8	ch;
+	U32* p;
+
+	if(swp_mode == SWP_LIN){
+		swp_r0 = add_frac(swp_r0, swp_r1, swp_step);	// MOD (R1) doesn't change in a linear sweep
+	}else{
+		ch = hop_tbl[swp_idx >> 1];						// get next hop channel
+		if(!(swp_idx & 0x01)){
+			ch >>= 4;
+		}
+		ch &= 0x0f;
+		swp_idx++;
+		p = get_chan(ch);								// R5 of hop channel
+		if(*p == 0xffffffff){
+			p = get_chan(0);							// default to ch#00 if ch is empty
+		}
+		p -= 5;											// R0 of hop channel
+		swp_ptr = p;
+		swp_r0 = p[0];
+		swp_r1 = p[1];
+		swp_full = 0;
+		for(i=2; i<6; i++){
+			if(p[i] != chan_ptr[i]){
+				swp_full = 1;							// R2-R5 differ, needs a full load
+			}
+		}
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// swp_emit() sends the next sweep/hop step to the PLL.  If gating is on, waits
+//	for lock.  returns lock time (PCA tics), or LOCK_FAIL
+//-----------------------------------------------------------------------------
+U16 swp_emit(void){
+	U8	i;			// temp
+	U16	rtn = 0;
+
+	if(swp_full){
+		for(i=6; i!=0; i--){
+			send_spi32(swp_ptr[i-1]);					// full channel load (R5 first)
+		}
+		send_spi32((swp_ptr[4] | RF_ENAB) & (~VCO_DISAB));	// RF on
+		chan_ptr = swp_ptr;								// hop channel is now the loaded set
+		reg4_32 = (swp_ptr[4] & ~(RF_ENAB | VCO_DISAB)) | (reg4_32 & (RF_ENAB | VCO_DISAB));	// keep the keying bits
+	}else{
+		if(swp_r1 != reg1_32){
+			send_spi32(swp_r1);							// MOD changed, send R1 (latched by R0 write)
+		}
+		send_spi32(swp_r0);
+	}
+	reg1_32 = swp_r1;									// update cached regs
+	reg0_32 = swp_r0;
+	if(swp_gate){
+		rtn = lock_wait();
+	}
+	return rtn;
+}
+
+//-----------------------------------------------------------------------------
+// swp_bench() runs the sweep back-to-back and reports SPI time, lock time and
+//	step rate.  returns # steps that failed to lock.
+//-----------------------------------------------------------------------------
+U8 swp_bench(void){
+	U8	n;			// step count
+	U8	nfail = 0;	// # steps that did not lock
+	U16	t0;			// temps
+	U16	tspi;
+	U16	tlock;
+	U16	tmin = 0xffff;
+	U16	tmax = 0;
+	U32	tsum = 0;	// sum of lock times
+	U32	ttot = 0;	// sum of step times
+
+	n = swp_cnt;
+	do{
+		t0 = get_pca();
+		swp_gate = 0;
+		swp_emit();										// time the SPI frames
+		tspi = get_pca() - t0;
+		tlock = lock_wait();					// time the lock
+		if(tlock == LOCK_FAIL){
+			nfail++;
+			tlock = lock_tmo;
+		}
+		if(tlock < tmin) tmin = tlock;
+		if(tlock > tmax) tmax = tlock;
+		tsum += tlock;
+		ttot += tspi + tlock;
+		swp_next();
+	}while(--swp_cnt != 0);
+	putss("\nsteps: ");
+	put_u16(n);
+	putss("  spi us: ");
+	put_u16(pca_us(tspi));
+	putss("\nlock us min/avg/max: ");
+	put_u16(pca_us(tmin));
+	putch('/');
+	put_u16(pca_us((U16)(tsum / n)));
+	putch('/');
+	put_u16(pca_us(tmax));
+	putss("\nsteps/sec: ");
+	put_u16((U16)(((U32)n * 2041667L) / ttot));	// PCA clock = 24.5 MHz / 12
+	putss("  no lock: ");
+	put_u16(nfail);
+	putss("\n");
+	return nfail;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// send_spi32
+//-----------------------------------------------------------------------------
+//
+// sends 32 bit word to ADS4351 via portB bit-bang SPI
+//
+void send_spi32(U32 plldata){
+#ifdef BB_SPI
+	U32	mask;
+
+	spi_busy = 1;									// hold off PTT ISR frames
+	if(((U8)plldata & 0x07) == 0x04){				// track VCO power for the lock supervisor
+		if(!vco_on && !(plldata & VCO_DISAB)){
+			lksup_tmr = LKSUP_SETTLE;				// give the PLL time to lock before the next sample
+		}
+		vco_on = !(plldata & VCO_DISAB);
+	}
+	nPLL_LE = LE_ON;								// latch enab = low to clock in data
+	for(mask = 0x80000000; mask != 0; mask >>= 1){	// start shifting 32 bits starting at MSb
+		if(mask & plldata) MOSI = 1;				// set MOSI
+		else MOSI = 0;
+		delay_us(HAFBIT);							// delay half clock
+		SCK = 1;									// clock = high
+		delay_us(HAFBIT);							// delay remaining half
+		SCK = 0;									// clock low
+	}
+	delay_us(HAFBIT);								// delay for LE
+	nPLL_LE = LE_OFF;								// latch enab = high to latch data
+	TRC_M(trc_spi(plldata));
+	delay_us(HAFBIT);								// pad intra-word xfers by a half bit
+	spi_busy = 0;
+	return;
+	
+#else
+	U8	i;	// loop temps
+
+	spi_busy = 1;									// hold off PTT ISR frames
+	if(((U8)plldata & 0x07) == 0x04){				// track VCO power for the lock supervisor
+		if(!vco_on && !(plldata & VCO_DISAB)){
+			lksup_tmr = LKSUP_SETTLE;				// give the PLL time to lock before the next sample
+		}
+		vco_on = !(plldata & VCO_DISAB);
+	}
+	HAL_PLL_LE(LE_ON);								// latch enab = low to clock in data
+	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
+	for(i=0; i < 4; i++){							// shifting 32 bits 8 bits at a time (from plldata
+		while(!HAL_SPI_TXRDY());					//	in place, no copy in the overlay)
+		HAL_SPI_WR(((U8 data*)&plldata)[i ^ U32_MSB]);
+	}
+	while(!HAL_SPI_TXRDY());						// wait for buffer to clear
+	delay_us(BYTDLY);								// delay for LE
+	HAL_PLL_LE(LE_OFF);								// latch enab = high to latch data
+	TRC_M(trc_spi(plldata));
+	delay_us(SH_DLY);								// delay for RC pullup on revC CS line
+	spi_busy = 0;
+	return;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// delay_us
+//-----------------------------------------------------------------------------
+//
+// sets delay for spi SCK and for CS setup/hold
+//
+	// BitBang version uses for-loop to establish ~~200 us delay
+/*void delay_halfbit(void){
+	U16	i;
+	
+	for(i = 0; i < 500;){							// cheezy for-next-loop to set delay for bit-bang-spi
+													// 500 loops is approx 200us
+		i += 1;
+	}
+	return;	
+}*/
+
+void delay_us(U16 dly){								// for HWSPI, this fnd is just used to set reg-reg xfr delay
+
+	TH0 = (dly >> 8);								// prep timer registers for delay
+	TL0 = (dly & 0xFF);
+	TF0 = 0;
+	TR0 = 1;										// start timer
+	while(TF0 == 0);								// loop
+	TR0 = 0;										// stop timer
+	return;	
+}
+
+//-----------------------------------------------------------------------------
+// send_spi8
+//-----------------------------------------------------------------------------
+//
+// sends 8 bit DAC word to LTC2630 DAC via SPI
+//	Uses SPI for clock and data, and KEYOUT for /CS
+//	daccmd is the DAC command word
+//
+void send_spi8(U8 daccmd, U8 dacdata){
+#ifdef BB_SPI
+	U8	bi;			// loop temp
+	U8	mask;
+	U8	temp;
+
+	spi_busy = 1;									// hold off PTT ISR frames
+	KEYOUT = 0;										// latch enab = low to clock in data
+	delay_us(SH_DLY);								// delay for LE
+	for(bi=0; bi<3; bi++){
+		temp = 0;
+		if(bi == 0) temp = daccmd;
+		if(bi == 1) temp = dacdata;
+		for(mask = 0x80; mask != 0x00; mask >>= 1){	// start shifting 24 bits starting at MSb
+			if(mask & temp) MOSI = 1;				// set MOSI
+			else MOSI = 0;
+			delay_us(HAFBIT);							// delay half clock
+			SCK = 1;									// clock = high
+			delay_us(HAFBIT);							// delay remaining half
+			SCK = 0;									// clock low
+		}
+	}
+	delay_us(SH_DLY);								// delay for LE
+	KEYOUT = 1;										// latch enab = high to latch data
+	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
+	spi_busy = 0;
+	return;
+	
+#else
+	spi_busy = 1;									// hold off PTT ISR frames
+	HAL_DAC_CS(0);									// latch enab = low to clock in data
+	delay_us(SH_DLY);								// pad intra-word xfers by a half bit
+	while(!HAL_SPI_TXRDY());						// wait for buffer to clear
+	HAL_SPI_WR(daccmd);								// send cmd
+	while(!HAL_SPI_TXRDY());						// wait for buffer to clear
+	HAL_SPI_WR(dacdata);							// send data
+	while(!HAL_SPI_TXRDY());						// wait for buffer to clear
+	HAL_SPI_CLRF();									// clear irq
+	HAL_SPI_WR(0);									// send pads
+	while(!HAL_SPI_DONE());							// wait for xfr dne
+	delay_us(BYTDLY);								// delay for LE
+	HAL_DAC_CS(1);									// latch enab = high to latch data
+	delay_us(SH_DLY);								// delay for RC pullup on revC CS line
+	spi_busy = 0;
+	return;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// ramp_step() sends the next DAC ramp value (key_task() steps the ramp at 1 ms)
+//	
+//-----------------------------------------------------------------------------
+//
+//	Index	%Full scale		RAW DAC (8b)	Chart of ramp (1ms per step)
+//	000		0				0				*
+//	001		5.3				14				 *
+//	010		15.8			40				    *
+//	011		36.8			94				         *
+//	100		63.1			161				                *
+//	101		84.2			215				                     *
+//	110		94.7			241				                        *
+//	111		100				255				                         *
+
+//U8	code ramp_array[] = { 0, 14, 40,  94, 161, 215, 241, 255};
+//U8	code ramp_array[] = {25, 37, 61, 110, 170, 219, 243, 255};		// ramp table with 0.6V low-end offset
+#define	RAMPLEN (RTBLE_IDX - RTBL_IDX)
+
+void ramp_step(void){
+
+	if(ramp_up){
+		send_spi8(DAC_SET, diode_matrix[RTBLE_IDX - ramp_cnt]);		// RTBL_IDX up
+	}else{
+		send_spi8(DAC_SET, diode_matrix[RTBL_IDX - 1 + ramp_cnt]);	// RTBLE_IDX-1 down
+	}
+	ramp_cnt--;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// setkeyout() sets/clears keyout or starts the DAC ramp according to key mode status.
+//	Does not wait: RF frames passed to key_frame() after this call are held until the
+//	keyout delay/ramp is done (key_task()).  The caller finishes the last transition 1st
+//	(key_flush(), elem_task() does it on entry).
+//-----------------------------------------------------------------------------
+//
+void setkeyout(U8 updn){
+static	bit	last_updn;			// last ramp direction
+
+	if(updn == 0xAA){
+		last_updn = 0;
+		return;
+	}
+	TRC_M(TRC_KEY | (updn & 0x01));
+	if(updn && boot_run){
+#if STATS_EN == 1
+		boot_pca = get_pca();										// 1st keydn (msg or PTT) since reset
+#endif
+		boot_run = 0;
+	}
+	if(dacmode){
+		if(last_updn != updn){
+			ramp_up = updn;											// start ramp up or dn
+			ramp_cnt = RAMPLEN;
+			keytimer = 0;											// 1st step on next pass
+			key_st = KEY_RAMP;
+			last_updn = updn;
+		}
+	}else{
+		if(updn){
+			KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK);			// KEYOUT = tone on
+			keytimer = 2;											// >= 1 ms
+		}else{
+			KEYOUT = (diode_matrix[KEY_IDX] & KEY_MASK) ^ 0x01;		// KEYOUT = tone off
+			keytimer = diode_matrix[RMP_IDX];
+		}
+		key_st = KEY_DLY;
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// key_frame() sends an RF frame (KF_xx) now if no keyout transition is running, else
+//	queues it for the end of the transition.  The queue holds the code, the frame is
+//	built from the reg holding regs when it is sent.
+//-----------------------------------------------------------------------------
+void key_frame(U8 kf){
+
+	if(key_st == KEY_IDLE){
+		send_spi32(kf_word(kf));
+	}else{
+		if(key_nq < KEYQ_LEN){
+			keyq[key_nq++] = kf;
+		}
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// kf_word() returns the RF frame for key_frame() code kf.  KF_R4_LK waits for lock
+//	(lock_tmo) first, and returns RF off if there is none and lock_mute is set.
+//-----------------------------------------------------------------------------
+U32 kf_word(U8 kf){
+
+	switch(kf){
+		case KF_R4_OFF:
+			return reg4_32 & (~RF_ENAB);
+		case KF_R4_LK:
+			if((lock_wait() == LOCK_FAIL) && lock_mute){
+				return reg4_32 & (~RF_ENAB);				// no lock, hold RF off
+			}
+			// fall through
+		case KF_R4_ON:
+			return reg4_32 & (~VCO_DISAB);
+		case KF_R1:
+			return reg1_32;
+		case KF_R0:
+			return reg0_32;
+		case KF_R01:
+			return reg01_32;
+		case KF_R00:
+			return reg00_32;
+		default:
+			break;
+	}
+	return reg4_32;
+}
+
+//-----------------------------------------------------------------------------
+// key_flush() finishes the keyout transition now (rest of the ramp and queued frames)
+//-----------------------------------------------------------------------------
+void key_flush(void){
+	U8	i;
+
+	if(key_st == KEY_RAMP){
+		while(ramp_cnt){
+			ramp_step();
+		}
+	}
+	key_st = KEY_IDLE;
+	for(i=0; i<key_nq; i++){
+		if(!ptt_dn){
+			send_spi32(kf_word(keyq[i]));							// PTT is down: the ISR owns R4, drop msg frames
+		}
+	}
+	key_nq = 0;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// key_task() runs the keyout delay/DAC ramp from the main loop
+//-----------------------------------------------------------------------------
+void key_task(void){
+
+	if((key_st == KEY_IDLE) || keytimer){
+		return;
+	}
+	if((key_st == KEY_RAMP) && ramp_cnt){
+		ramp_step();												// 1 ms per step
+		keytimer = 1;
+		return;
+	}
+	key_flush();													// done, send queued frames
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// calcrc() calculates incremental crcsum using defined poly
+//	(xmodem poly = 0x1021).  oldcrc = 0x0000 for first call, c = data byte
+//-----------------------------------------------------------------------------
+U16 calcrc(U8 c, U16 oldcrc){
+#define	POLY 0x1021	// xmodem polynomial
+
+	U16 crc;
+	U8	i;
+	
+	crc = oldcrc ^ ((U16)c << 8);
+	for (i = 0; i < 8; ++i){
+		if (crc & 0x8000) crc = (crc << 1) ^ POLY; //0x1021;
+		else crc = crc << 1;
+	 }
+	 return crc;
+}
+
+//-----------------------------------------------------------------------------
+// clk_set() sets SYSCLK to full speed (lo = 0) or SYSCLK/8 (lo = 1), and rescales the
+//	Timer2 (1 ms) and Timer1 (9600 baud) reloads to match.  PCA and Timer0 tics are 8x
+//	longer while throttled.  The Timer2 count in flight is rescaled too, else the tic
+//	that spans the switch runs up to 8x long (or short) and the msg timing slips.
+//-----------------------------------------------------------------------------
+void clk_set(U8 lo){
+	U16	rem;
+
+	while(!txidle());								// let the last TX chr finish
+	EA = 0;
+	TR2 = 0;
+	rem = -HAL_T2_RD();								// counts left in this tic
+	if(lo){
+		rem = (rem + 7) >> 3;
+		OSCICN = OSC_LO;
+		TMR2RLL = (U8)(TMR2RL_LO & 0xff);
+		TMR2RLH = (U8)(TMR2RL_LO >> 8);
+		CKCON |= T1M;								// Timer1 = SYSCLK
+		TH1 = TH1_LO;
+		clk_lo = 1;
+	}else{
+		rem <<= 3;
+		OSCICN = OSC_FULL;
+		TMR2RLL = (U8)(TMR2RL_FULL & 0xff);
+		TMR2RLH = (U8)(TMR2RL_FULL >> 8);
+		CKCON &= ~T1M;								// Timer1 = SYSCLK/12
+		TH1 = TH1_FULL;
+		clk_lo = 0;
+	}
+	HAL_T2_WR((U16)-rem);
+	TR2 = 1;
+	TRC(TRC_CLK | clk_lo);
+	EA = 1;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// put_hex
+//-----------------------------------------------------------------------------
+//
+// sends 8b hex to serial port as ASCII
+//
+void put_hex(U8 dhex){
+	char	c;
+	
+	c = (dhex >> 4) + '0';							// convert low nybble to BCD
+	if(c > '9') c += 'A' - '9' - 1;					// if hex, convert to "A" - "F"
+	putch(c);										// send to terminal
+	c = (dhex & 0x0f) + '0';						// repeat above for hi nyb
+	if(c > '9') c += 'A' - '9' - 1;
+	putch(c);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// put_u16
+//-----------------------------------------------------------------------------
+//
+// sends 16b unsigned to serial port as decimal ASCII (no leading zeros)
+//
+U16 code dec_wt[] = { 10000, 1000, 100, 10, 1 };	// digit weights
+
+void put_u16(U16 dval){
+	U8	i;			// digit weight index
+	U8	c;			// digit
+	bit	lead = 1;	// leading zero flag
+
+	for(i = 0; i < 5; i++){
+		c = (U8)(dval / dec_wt[i]);
+		dval -= (U16)c * dec_wt[i];
+		if(c || !lead || (i == 4)){
+			putch(c + '0');
+			lead = 0;
+		}
+	}
+	return;
+}
+
+#if FREQ_EN == 1
+//-----------------------------------------------------------------------------
+// put_freq
+//-----------------------------------------------------------------------------
+//
+// sends frequency (10 Hz units) to serial port as MHz, "ffff.fffff"
+//
+void put_freq(U32 freq){
+	U8	i;			// temps
+	U16	d;
+	U16	fmhz;
+
+	fmhz = (U16)(freq / 100000L);
+	put_u16(fmhz);
+	putch('.');
+	freq -= (U32)fmhz * 100000L;
+	for(i=0, d=10000; i<5; i++, d/=10){
+		putch((char)(freq / d) + '0');				// fractional digits w/ leading zeros
+		freq %= d;
+	}
+	return;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// put_dec
+//-----------------------------------------------------------------------------
+//
+// sends 8b hex to serial port as decimal ASCII
+//
+void put_dec(U8 dhex){
+
+	if(dhex > 99){
+		putch('>');									// error display
+		putch('>');
+	}else{
+		put_hex(((dhex / 10) << 4) | (dhex % 10));	// BCD, display as hex = display as BCD
+	}
+	return;
+}
+
+//--------------------------------------------------------------------------------------
+// hex_chk() checks the Intel HEX record in the rx buffer (after the ':') without removing it.
+//	returns the # record bytes (count thru checksum), 0 if a chr is not hex or the checksum fails
+//--------------------------------------------------------------------------------------
+U8 hex_chk(void){
+	U8	i = 0;		// rx buffer index
+	U8	n = 0;		// # bytes
+	U8	sum = 0;
+	U8	c;
+	U8	cc;
+
+	c = (U8)peekch(i++);
+	while(c > ESC){									// to the CR (or end of buffer)
+		cc = convnyb((U8)peekch(i++));
+		c = convnyb(c);
+		if((c > 0x0f) || (cc > 0x0f)){
+			return 0;								// not hex (or odd # chrs)
+		}
+		sum += (c << 4) | cc;
+		n++;
+		c = (U8)peekch(i++);
+	}
+	if(sum){
+		n = 0;										// checksum error
+	}
+	return n;
+}
+
+//--------------------------------------------------------------------------------------
+// addr_chk() checks the multi-drop address of a new cmd line (after gotcr()).  "@hh" and the spaces
+//	after it are removed, and tx is muted for a broadcast ("@00") or un-muted for this unit's ID.
+//	returns 0 if the line is not for this unit (the line is discarded), else 1
+//--------------------------------------------------------------------------------------
+U8 addr_chk(void){
+	U8	c;
+	U8	cc;
+
+	adr_all = 0;
+	c = (U8)peekch(0);
+	while((c <= ESC) && (c != '\r') && (c != '\0')){	// skip leading control chrs (LF)
+		getch00();
+		c = (U8)peekch(0);
+	}
+	if(c != '@'){
+		if(unit_id != ID_NONE){
+			cleanline();								// no address, only runs on a unit with no ID
+			return 0;
+		}
+		return 1;
+	}
+	getch00();
+	c = (U8)getch00();
+	cc = (U8)getch00();
+	if((c == '\r') || (cc == '\r')){
+		return 0;										// short line, already consumed
+	}
+	c = convnyb(c);
+	cc = convnyb(cc);
+	if((c > 0x0f) || (cc > 0x0f)){
+		cleanline();
+		return 0;
+	}
+	c = (c << 4) | cc;
+	while(whitespc(peekch(0))){
+		getch00();
+	}
+	if(c == 0){
+		adr_all = 1;									// broadcast, runs silent
+		tx_mute(1);
+		return 1;
+	}
+	if(c != unit_id){
+		cleanline();									// another unit
+		return 0;
+	}
+	tx_mute(0);
+	return 1;
+}
+
+//--------------------------------------------------------------------------------------
+// id_get() returns the multi-drop unit ID (last byte written to the ID log).
+//	returns ID_NONE if the log is blank or the ID was cleared (00)
+//--------------------------------------------------------------------------------------
+U8 id_get(void){
+	U8 code * p = FLASH_C(UNIT_ID_ADDR);
+	U8	i;
+	U8	id = ID_NONE;
+
+	for(i=0; (i<UNIT_ID_N) && (p[i] != 0xff); i++){
+		id = p[i];
+	}
+	if(id == 0){
+		id = ID_NONE;
+	}
+	return id;
+}
+
+//--------------------------------------------------------------------------------------
+// id_put() writes a unit ID (00 = clear) to the next blank byte of the ID log.
+//	returns 1 if the log is full or the write failed
+//--------------------------------------------------------------------------------------
+U8 id_put(U8 id){
+	U8 code * p = FLASH_C(UNIT_ID_ADDR);
+	U8	i;
+
+	for(i=0; i<UNIT_ID_N; i++){
+		if(p[i] == 0xff){
+			wr_flash(id, FLASH_X(UNIT_ID_ADDR + i));
+			return (p[i] != id);
+		}
+	}
+	return 1;
+}
+
+//--------------------------------------------------------------------------------------
+// id_port() sets the TX pin for the unit ID: open-drain (shared bus) if addressed, else push-pull
+//--------------------------------------------------------------------------------------
+void id_port(void){
+
+	if(unit_id == ID_NONE){
+		P0MDOUT |= TXD_PP;
+	}else{
+		P0MDOUT &= ~TXD_PP;
+	}
+	return;
+}
+
+//--------------------------------------------------------------------------------------
+// getbyte() returns 1 if no EOL is encountered: processes ASCII byte into pointer location.
+//	skips spaces.  Other chars are data error.
+//	returns 1 if EOL or data error
+//--------------------------------------------------------------------------------------
+U8 getbyte(U8* dataptr){
+	U8	c;		// temps
+	U8	cc;
+	U8	temp;
+	U8	rtn = 0;	// default to !goteol rtn
+
+	do{												// 1st nyb, skip spaces & trap EOL
+		c = (U8)getch00();
+	}while(whitespc(c));
+	do{												// 2nd nyb, skip spaces & trap EOL
+		cc = (U8)getch00();
+	}while(whitespc(cc));
+	if((c <= ESC) || (cc <= ESC)){
+		rtn = 1;									// any cntl chr is interpreted as EOL
+	}else{
+		temp = convnyb(c);
+		if(temp > 0x0f) rtn = 2;					// error data
+		c = convnyb(cc);
+		if(c > 0x0f) rtn = 2;						// error data
+	}
+	if(!rtn){
+		*dataptr = (temp << 4) | c;
+	}
+	return rtn;
+}
+
+#if FREQ_EN == 1
+//--------------------------------------------------------------------------------------
+// getfreq() processes ASCII decimal MHz (ffff.fffff) into a U32 in 10 Hz units.
+//	skips leading spaces.  Digits past 10 Hz resolution are ignored.
+//	returns 0 if OK, 1 if no digits or data error
+//--------------------------------------------------------------------------------------
+U8 getfreq(U32* fptr){
+	U8	c;			// temps
+	U8	n = 0;		// # digits
+	U8	nf = 0;		// # fractional digits
+	bit	dp = 0;		// decimal point seen
+	U32	f = 0;
+
+	do{
+		c = (U8)getch00();							// skip spaces
+	}while(whitespc(c));
+	while(((c >= '0') && (c <= '9')) || ((c == '.') && !dp)){
+		if(c == '.'){
+			dp = 1;
+		}else{
+			if(!dp){
+				f = (f * 10) + (c - '0');			// MHz digits
+				n++;
+			}else{
+				if(nf < 5){
+					f = (f * 10) + (c - '0');		// fractional digits (10 Hz resolution)
+					nf++;
+				}
+			}
+		}
+		c = (U8)getch00();
+	}
+	if((n == 0) || (n > 4) || ((c > ESC) && !whitespc(c))){
+		return 1;									// no digits, too many digits, or data error
+	}
+	for(; nf<5; nf++){
+		f *= 10;									// scale to 10 Hz units
+	}
+	*fptr = f;
+	return 0;
+}
+#endif
+
+//--------------------------------------------------------------------------------------
+// whitespc() returns 1 if chr = space, comma, or tab, else returns 0
+//--------------------------------------------------------------------------------------
+U8 whitespc(char c){
+	U8 rtn = 0;	// temp rtn, default false
+
+	switch(c){
+		case ' ':
+		case ',':
+		case '\t':
+			rtn = 1;								// if defined whitespace chr, return true
+			break;
+	}
+	return rtn;
+}
+
+//--------------------------------------------------------------------------------------
+// convnyb() converts ASCII to bin nybble.  returns 0xff if non-hex ascii
+//--------------------------------------------------------------------------------------
+U8 convnyb(U8 c){
+	U8	rtn = 0xff;
+
+	if((c >= 'a') && (c <= 'z')) c -= 'a' - 'A';	// upcase
+	if((c >= '0') && (c <= 'F')){					// 1st validation step
+		rtn = (c - '0');							// passed, convert to BIN
+		if(rtn > 9){
+			rtn -= 'A' - '9' - 1;					// convert letters
+			if(rtn < 0x0a) rtn = 0xff;				// 2nd validation step (if true, fail)
+		}
+	}
+	return rtn;										// return result
+}
+
+//--------------------------------------------------------------------------------------
+// get_chan() returns pointer to R5 of specified channel data
+//--------------------------------------------------------------------------------------
+U32 *get_chan(U8 chanum){
+	U32 *ptemp;
+	
+	ptemp = pll_ch + (6 * chanum) + 5;				// channel pointer is base + #regs * ch# + 5
+	return ptemp;
+}
+
+//--------------------------------------------------------------------------------------
+// conv_to_chnum() converts dual-BCD port bits to channel# (0 = first channel)
+//	if invalid BCD, returns ch#0
+//--------------------------------------------------------------------------------------
+
+U8 conv_to_chnum(U8 portbits){
+	U8	i;				// temp return value
+	U8	r;				// temp regs
+	U8	s;
+	
+	r = portbits & 0x0f;							// get low BCD nyb
+	s = (portbits >> 4) & 0x0f;
+	if((r > 9) || (s > 9)){
+		i = 0;										// bcd error, default to ch#0
+	}else{
+		i = r + (s * 10);							// get integer version of 2 digit BCD
+	}
+//	if(i > MAX_CHAN){
+//		i = 0;										// if channel error, set to 0
+//	}
+	return i;
+}
+
+//-----------------------------------------------------------------------------
+// Timer2_ISR
+//-----------------------------------------------------------------------------
+//
+// Called when timer 2 overflows (NORM mode):
+//      updates app timers @ 10ms rate
+//		rate = (sysclk/12) / (65536 - TH:L)
+//
+//-----------------------------------------------------------------------------
+
+INTERRUPT_USING(Timer2_ISR, 5, 2)
+{
+
+    TF2H = 0;                           			// Clear Timer2 interrupt flag
+#if SWEEP_EN == 1
+    if(swptimer != 0){                 				// sweep dwell timer
+        swptimer--;
+    }
+#endif
+    if(lksup_tmr != 0){                 			// lock supervisor sample timer
+        lksup_tmr--;
+    }
+#if STATS_EN == 1
+	if(fsel_run){									// FSEL switch latency timer
+		fsel_ms++;
+	}
+#endif
+	if(fsel_db != 0){								// FSEL debounce
+		if(--fsel_db == 0){
+			fsel_chg = 1;
+		}
+	}
+	if(keytimer != 0){								// key task timer
+		keytimer--;
+	}
+	if(clitimer != 0){								// CLI task timer
+		clitimer--;
+	}
+#if STATS_EN == 1
+	if(loop_ms != 0xff){							// main loop pass timer
+		loop_ms++;
+	}
+#endif
+#if TRC_EN == 1
+	trc_tic++;										// trace ms count
+#endif
+	if(boot_run){									// reset to 1st RF timer
+		boot_ms++;
+	}
+	if(wdt_ms < WDT_MS){							// kick the WDT while main() is checking in
+		wdt_ms++;
+		PCA0CPH2 = 0;
+	}
+#if WARM_EN == 1
+	if(warm_tmr != 0){								// warm state save timer
+		warm_tmr--;
+	}
+#endif
+#if STATS_EN == 1
+	if(++duty_tot == 0xffff){						// duty counters (halved on overflow to keep the ratio)
+		duty_tot >>= 1;
+		duty_idle >>= 1;
+		duty_lo >>= 1;
+	}
+	if(cpu_idle){									// CPU was in idle when this tic woke it
+		duty_idle++;
+	}
+	if(clk_lo){
+		duty_lo++;
+#else
+	duty_tot++;										// tic count (Timer2 reload dither)
+	if(clk_lo){
+#endif
+		if(duty_tot & 0x03){						// 2042/8 = 255.25 counts: next reload 255, or 256 every 4th tic
+			TMR2RLL = (U8)(TMR2RL_LO & 0xff);
+		}else{
+			TMR2RLL = (U8)((TMR2RL_LO - 1) & 0xff);
+		}
+	}
+#ifndef BB_SPI
+	if(ptt_pend && !spi_busy && !ptt_hold){			// SPI is free, re-trigger PTT intr to send the deferred frame
+		IE0 = 1;
+	}
+#endif
+    if(msgtimer != 0){                 				// msg delay timer
+		if(--msgpre == 0){							// prescale for QRSS mode
+			msgpre = msg_scale;
+	        msgtimer--;
+		}
+    }
+	if(cw_on && (--elem_pre == 0)){
+		elem_pre = msg_scale;						// prescale for QRSS mode
+		if(--elem_timer == 0){
+			elem_flag = 1;
+			elem_timer = elem_time;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// ptt_isr
+//-----------------------------------------------------------------------------
+//
+// INT0 (nPTT, P0.3) intr.  Sends the R4 keydn/keyup frame to the PLL
+//	if the SPI is idle, else the frame is deferred and Timer2 re-triggers this intr
+//	once the SPI is free.  INT0 polarity is flipped at each edge to catch both press
+//	and release.  The SPI frame is coded in-line (no calls from this reg bank).
+//	Low priority like the others (INT0 is 1st in the polling order), so it shares reg
+//	bank 2 and doesn't nest on the stack.  Worst case it waits out one Timer2 tic.
+//
+//-----------------------------------------------------------------------------
+
+INTERRUPT_USING(ptt_isr, 0, 2)
+{
+#if STATS_EN == 1
+	U16	t;			// PCA time
+#endif
+#ifndef BB_SPI
+	U8	i;			// loop temps
+	U8	d;			// SPI byte
+#endif
+
+#if STATS_EN == 1
+	t = (U16)HAL_PCA_LO();									// reading PCA0L latches PCA0H
+	t |= (U16)HAL_PCA_HI() << 8;
+	if(!ptt_pend){
+		ptt_t0 = t;									// edge time (a re-trigger keeps the original)
+	}
+#endif
+	if(nPTT == 0){
+		IT01CF |= IN0PL;							// PTT pressed, look for release
+		ptt_dn = 1;
+	}else{
+		IT01CF &= ~IN0PL;							// PTT released, look for press
+		ptt_dn = 0;
+		ptt_retry = 0;								// next press may re-try the msg init
+	}
+	TRC(TRC_PTT | ptt_dn);
+	if(!ptt_arm){
+		ptt_pend = 0;
+		return;
+	}
+	ptt_evt = 1;
+#ifndef BB_SPI
+	if(spi_busy || ptt_hold){
+		ptt_pend = 1;								// main() owns the SPI, defer
+		return;
+	}
+	ptt_pend = 0;
+	if(ptt_dn){
+		if(!vco_on){
+			lksup_tmr = LKSUP_SETTLE;				// give the PLL time to lock before the next sample
+		}
+		vco_on = 1;
+	}else{
+		vco_on = !(reg4_32 & VCO_DISAB);
+	}
+	HAL_PLL_LE(LE_ON);								// latch enab = low to clock in data
+	for(i=0; i < 4; i++){
+		HAL_SPI_CLRF();								// clear SPIF
+		d = ((U8 data*)&reg4_32)[i ^ U32_MSB];		// keyup (reg4_32 in place, no copy)
+		if(ptt_dn && (i == 2)){
+			d &= ~(U8)(VCO_DISAB >> 8);				// keydn (VCO_DISAB is in R4 bits 15-8)
+		}
+		HAL_SPI_WR(d);
+		while(!HAL_SPI_DONE());						// wait for xfr dne
+	}
+	HAL_SPI_CLRF();
+	HAL_PLL_LE(LE_OFF);								// latch enab = high to latch data
+#if STATS_EN == 1
+	t = (U16)HAL_PCA_LO();
+	t |= (U16)HAL_PCA_HI() << 8;
+	t -= ptt_t0;
+	ptt_lat = t;									// edge to R4 latch latency
+	if(t > ptt_max){
+		ptt_max = t;
+	}
+#endif
+	for(i=40; i!=0; i--);							// pad for RC pullup on revC CS line
+#else
+	ptt_pend = 1;									// bit-bang SPI uses Timer0, main() sends the frame
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// fsel_isr
+//-----------------------------------------------------------------------------
+//
+// Port match intr (FSEL inputs, P1.3-0).  Re-arms the match on the new port state and
+//	(re)starts the debounce timer.  Timer2 flags the change once the inputs are stable.
+//	Low priority, shares reg bank 2 with Timer2_ISR and rxd_intr.
+//
+//-----------------------------------------------------------------------------
+
+INTERRUPT_USING(fsel_isr, 14, 2)
+{
+
+	P1MAT = P1;										// match on next change
+	TRC(TRC_FSEL | (~P1MAT & PB_MASK));
+#if STATS_EN == 1
+	if(!fsel_run){
+		fsel_ms = 0;								// 1st edge, start latency timer
+		fsel_run = 1;
+	}
+#endif
+	fsel_db = FSEL_DB;
+}
+
+#undef IS_MAINC
+//**************
+// End Of File
+//**************
@@ -1,243 +1,348 @@
-/*************************************************************************
- *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
- *
- *  File name: serial.c
- *
- *  Module:    Control
- *
- *  Summary:   This is the serial I/O module for the F360 MCU
- *
- *******************************************************************/
-
-/********************************************************************
- *  File scope declarations revision history:
- *    05-12-13 jmh:  creation date
- *
- *******************************************************************/
-
-#include "c8051F520.h"
-#include "typedef.h"
-#include "main.h"
-#include "serial.h"
-
-//------------------------------------------------------------------------------
-// local defines
-//------------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// Local Variable Declarations
-//-----------------------------------------------------------------------------
-
-#define RXD_ERR 0x01
-#define RXD_BS 0x04					// BS rcvd flag
-#define RXD_ESC 0x40				// ESC rcvd flag
-#define RXD_CHAR 0x80				// CHAR rcvd flag (not used)
-#define RXD_BUFF_END 64
-idata S8	rxd_buff[RXD_BUFF_END];	// rx data buffer
-U8	rxd_hptr;						// rx buf head ptr = next available buffer input
-U8	rxd_tptr;						// rx buf tail ptr = next available buffer output
-U8	rxd_stat;						// rx buff status
-U8	rxd_crcnt;						// CR counter
-bit	qTI0B;							// UART TI0 reflection (set by interrupt)
-//------------------------------------------------------------------------------
-// local fn declarations
-//------------------------------------------------------------------------------
-
-//-----------------------------------------------------------------------------
-// init_serial() initializes serial port vars
-//-----------------------------------------------------------------------------
-//
-void init_serial(void){
-	qTI0B = 1;							// UART TI0 reflection (set by interrupt)
-	rxd_hptr = 0;						// rx buf head ptr
-	rxd_tptr = 0;						// rx buf tail ptr
-	rxd_stat = 0;						// rx buff status
-	rxd_crcnt = 0;						// init cr counter
-}
-
-//-----------------------------------------------------------------------------
-// putch, UART0
-//-----------------------------------------------------------------------------
-//
-// SFR Paged version of putch, no CRLF translation
-//
-char putch (char c)  {
-
-	// output character
-	while(!qTI0B){						// wait for tx buffer to clear
-		continue;
-	}
-	qTI0B = 0;
-	SBUF0 = c;							// send chr to UART
-	return (c);
-}
-
-//-----------------------------------------------------------------------------
-// getch00 checks for input @ RX0.  If no chr, return '\0'.
-//-----------------------------------------------------------------------------
-//
-// SFR Paged, waits for a chr and returns
-// Processor spends most of its idle time waiting in this fn
-//
-char getch00(void)
-{
-	char c = '\0';		// default to null return
-	bit	EA_save;
-
-	if(rxd_tptr != rxd_hptr){			// make sure buffer not empty
-		c = rxd_buff[rxd_tptr++];		// get chr from buff
-		if(rxd_tptr == RXD_BUFF_END){	// and update tail pointer
-			rxd_tptr = 0;
-		}
-	}
-	if((c == '\r') && rxd_crcnt){		// process CR chrs
-		EA_save = EA;					// prohibit intrpts
-		EA = 0;
-		rxd_crcnt--;					// clear flag
-		EA = EA_save;					// re-set intrpt enable
-	}
-	return c;
-}
-
-//-----------------------------------------------------------------------------
-// cleanline() cleans buffer up to and including 1st CR.  
-//	Pull CHRS from buffer and discard until first CR is encountered.  Then, exit.
-//-----------------------------------------------------------------------------
-//
-void cleanline(void)
-{
-	char c;	// temp char
-
-	if(rxd_tptr != rxd_hptr){							// skip if buffer empty
-		do{
-			c = rxd_buff[rxd_tptr++];					// pull chr and update pointer
-			if(rxd_tptr == RXD_BUFF_END){
-				rxd_tptr = 0;
-			}
-		}while((c != '\r') && (rxd_tptr != rxd_hptr));	// repeat until CR or buffer empty
-	}
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// gotch00 checks for input @ RX0.  If no chr, return '\0'.
-//-----------------------------------------------------------------------------
-//
-// returns 0 if no chr in buffer or if current chr is '\r'
-//
-char gotch00(void)
-{
-	char c = 0;
-
-	if((rxd_tptr != rxd_hptr) && (rxd_buff[rxd_tptr] != '\r')){
-		c = 1;								// set buffer has data
-	}
-	if(rxd_stat & RXD_BS){					// process backspace
-		rxd_stat &= ~RXD_BS;				// clear flag
-		putss("\b \b");						// echo clearing BS to terminal
-	}
-	return c;
-}
-
-//-----------------------------------------------------------------------------
-// gotcr checks for '\r' @ RX0.  If no chr, return '\0'.
-//-----------------------------------------------------------------------------
-//
-// returns 0 if no cr rcvd
-//
-char gotcr(void)
-{
-	char c = 0;
-	bit	EA_save;
-
-	if(rxd_crcnt){
-		EA_save = EA;						// prohibit intrpts
-		EA = 0;
-		rxd_crcnt--;						// clear flag
-		EA = EA_save;						// re-set intrpt enable
-		c = 1;								// set buffer has data
-	}
-/*	if(rxd_stat & RXD_BS){					// process backspace
-		rxd_stat &= ~RXD_BS;				// clear flag
-		putss("\b \b");						// echo clearing BS to terminal
-	}*/
-	return c;
-}
-
-//-----------------------------------------------------------------------------
-// putss() does puts w/o newline
-//-----------------------------------------------------------------------------
-
-void putss (char* string)
-{
-	while(*string){
-		if(*string == '\n') putch('\r');
-		putch(*string++);
-	}
-	return;
-}
-
-//-----------------------------------------------------------------------------
-// rxd_intr
-//-----------------------------------------------------------------------------
-//
-// UART intr.  Captures RX data and places into circular buffer
-//	For TX, uses reflection register (qTI0B) to pass TXD empty status back to
-//	putchar.
-//
-//-----------------------------------------------------------------------------
-// uart1_intr
-//-----------------------------------------------------------------------------
-//
-// UART1 rx intr.  Captures RX data and places into circular buffer
-//
-
-void rxd_intr(void) interrupt 4
-{
-/* buffer registers repeated here for reference ... !! DO NOT UNCOMMENT !!
-S8   rxd_buff[10];					// rx data buffer
-U8   rxd_hptr = 0;					// rx buf head ptr
-U8   rxd_tptr = 0;					// rx buf tail ptr
-U8   rxd_stat = 0;					// rx buff status*/
-
-	char	c;
-
-	if(TI0){
-		qTI0B = 1;								// set TX reflection flag
-		TI0 = 0;
-	}
-	if(RI0){
-		c = SBUF0;
-		if((c == '\n') || (c == ESC)){			// don't capture linefeeds or ESC
-			if(c == ESC){
-				rxd_hptr = 0;					// if ESC, re-init serial buffer
-				rxd_tptr = 0;
-				rxd_crcnt = 0;
-				rxd_stat = RXD_ESC;
-			}
-		}else{
-			rxd_buff[rxd_hptr] = c;
-			if(rxd_buff[rxd_hptr] == '\r'){
-				rxd_crcnt++;					// set CR rcvd flag
-			}
-			if(rxd_buff[rxd_hptr] == '\b'){
-				if(rxd_hptr != rxd_tptr){		// only process BS if buffer is not empty
-					rxd_stat |= RXD_BS;			// set BS rcvd flag
-					if(rxd_hptr == 0){			// decrement headptr and rollunder if needed
-						rxd_hptr = RXD_BUFF_END;
-					}
-					rxd_hptr--;
-				}
-			}else{
-				if(++rxd_hptr == RXD_BUFF_END){	// increment headptr and rollover if needed
-					rxd_hptr = 0;
-				}
-			}
-			if(rxd_hptr == rxd_tptr){			// check for overflow, flag error if true
-				rxd_stat |= RXD_ERR;
-			}
-		}
-		RI0 = 0;								// clear intr flag
-	}
-	return;
-}
+/*************************************************************************
+ *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: serial.c
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the serial I/O module for the F360 MCU
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    05-12-13 jmh:  creation date
+ *    10-19-26:      TX is now interrupt driven from a ring buffer.  putch() only waits if the buffer is full.
+ *					Added tx_mute() (multi-drop: output is dropped while muted).
+					SBUF0 goes through HAL_UART_WR/RD (hal.h) for the host simulator.
+ *
+ *******************************************************************/
+
+#include "c8051F520.h"
+#include "typedef.h"
+#include "main.h"
+#include "serial.h"
+#include "hal.h"
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+#define RXD_ERR 0x01
+#define RXD_BS 0x04					// BS rcvd flag
+#define RXD_ESC 0x40				// ESC rcvd flag
+#define RXD_CHAR 0x80				// CHAR rcvd flag (not used)
+#define RXD_BUFF_END 64
+idata S8	rxd_buff[RXD_BUFF_END];	// rx data buffer
+U8	rxd_hptr;						// rx buf head ptr = next available buffer input
+U8	rxd_tptr;						// rx buf tail ptr = next available buffer output
+U8	rxd_stat;						// rx buff status
+U8	rxd_crcnt;						// CR counter
+#ifndef TXD_BUFF_END
+#define TXD_BUFF_END 8				// 7 chrs, putch() runs the msg (tx_wait()) while a longer report waits.
+#endif								//	The STATS_EN reports want 32 (sim/Makefile), the RAM budget is bench/results.txt
+idata S8	txd_buff[TXD_BUFF_END];	// tx data buffer
+U8	txd_hptr;						// tx buf head ptr = next available buffer input
+U8	txd_tptr;						// tx buf tail ptr = next chr to send
+bit	qTI0B;							// UART TX idle (set by interrupt when the tx buffer is empty)
+bit	txd_mute;						// tx output dropped (multi-drop, not addressed)
+//------------------------------------------------------------------------------
+// local fn declarations
+//------------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// init_serial() initializes serial port vars
+//-----------------------------------------------------------------------------
+//
+void init_serial(void){
+	qTI0B = 1;							// UART TX idle (set by interrupt)
+	rxd_hptr = 0;						// rx buf head ptr
+	rxd_tptr = 0;						// rx buf tail ptr
+	rxd_stat = 0;						// rx buff status
+	rxd_crcnt = 0;						// init cr counter
+	txd_hptr = 0;						// tx buf head ptr
+	txd_tptr = 0;						// tx buf tail ptr
+	txd_mute = 0;						// tx on
+}
+
+//-----------------------------------------------------------------------------
+// putch, UART0
+//-----------------------------------------------------------------------------
+//
+// SFR Paged version of putch, no CRLF translation
+//	Places chr in the tx buffer (waits only if the buffer is full) and starts the
+//	UART if it is idle.  tx_wait() runs while it waits.
+//
+char putch (char c)  {
+	U8	i;
+
+	if(txd_mute){
+		return (c);						// muted, drop chr
+	}
+	i = txd_hptr + 1;
+	if(i == TXD_BUFF_END){
+		i = 0;
+	}
+	while(i == txd_tptr){				// wait for room in tx buffer
+		tx_wait();						// main.c
+	}
+	txd_buff[txd_hptr] = c;
+	txd_hptr = i;
+	if(qTI0B){
+		qTI0B = 0;
+		TI0 = 1;						// UART idle, kick the tx intr
+	}
+	return (c);
+}
+
+//-----------------------------------------------------------------------------
+// tx_mute() turns tx output off (on = 1) or on (on = 0).  Chrs already in the
+//	tx buffer are still sent.
+//-----------------------------------------------------------------------------
+void tx_mute(U8 on){
+
+	txd_mute = on;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// getch00 checks for input @ RX0.  If no chr, return '\0'.
+//-----------------------------------------------------------------------------
+//
+// SFR Paged, waits for a chr and returns
+// Processor spends most of its idle time waiting in this fn
+//
+char getch00(void)
+{
+	char c = '\0';		// default to null return
+	bit	EA_save;
+
+	if(rxd_tptr != rxd_hptr){			// make sure buffer not empty
+		c = rxd_buff[rxd_tptr++];		// get chr from buff
+		if(rxd_tptr == RXD_BUFF_END){	// and update tail pointer
+			rxd_tptr = 0;
+		}
+	}
+	if((c == '\r') && rxd_crcnt){		// process CR chrs
+		EA_save = EA;					// prohibit intrpts
+		EA = 0;
+		rxd_crcnt--;					// clear flag
+		EA = EA_save;					// re-set intrpt enable
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+// cleanline() cleans buffer up to and including 1st CR.  
+//	Pull CHRS from buffer and discard until first CR is encountered.  Then, exit.
+//-----------------------------------------------------------------------------
+//
+void cleanline(void)
+{
+	char c;	// temp char
+
+	if(rxd_tptr != rxd_hptr){							// skip if buffer empty
+		do{
+			c = rxd_buff[rxd_tptr++];					// pull chr and update pointer
+			if(rxd_tptr == RXD_BUFF_END){
+				rxd_tptr = 0;
+			}
+		}while((c != '\r') && (rxd_tptr != rxd_hptr));	// repeat until CR or buffer empty
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// gotch00 checks for input @ RX0.  If no chr, return '\0'.
+//-----------------------------------------------------------------------------
+//
+// returns 0 if no chr in buffer or if current chr is '\r'
+//
+char gotch00(void)
+{
+	char c = 0;
+
+	if((rxd_tptr != rxd_hptr) && (rxd_buff[rxd_tptr] != '\r')){
+		c = 1;								// set buffer has data
+	}
+	if(rxd_stat & RXD_BS){					// process backspace
+		rxd_stat &= ~RXD_BS;				// clear flag
+		putss("\b \b");						// echo clearing BS to terminal
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+// peekch returns the chr i places past the rx tail without removing it.
+//-----------------------------------------------------------------------------
+//
+// returns '\0' if the buffer holds fewer than i+1 chrs
+//
+char peekch(U8 i)
+{
+	U8	n;
+
+	n = rxd_hptr;						// # chrs in buffer
+	if(n < rxd_tptr){
+		n += RXD_BUFF_END;
+	}
+	n -= rxd_tptr;
+	if(i >= n){
+		return '\0';
+	}
+	i += rxd_tptr;
+	if(i >= RXD_BUFF_END){
+		i -= RXD_BUFF_END;
+	}
+	return rxd_buff[i];
+}
+
+//-----------------------------------------------------------------------------
+// gotcr checks for '\r' @ RX0.  If no chr, return '\0'.
+//-----------------------------------------------------------------------------
+//
+// returns 0 if no cr rcvd
+//
+char gotcr(void)
+{
+	char c = 0;
+	bit	EA_save;
+
+	if(rxd_crcnt){
+		EA_save = EA;						// prohibit intrpts
+		EA = 0;
+		rxd_crcnt--;						// clear flag
+		EA = EA_save;						// re-set intrpt enable
+		c = 1;								// set buffer has data
+	}
+/*	if(rxd_stat & RXD_BS){					// process backspace
+		rxd_stat &= ~RXD_BS;				// clear flag
+		putss("\b \b");						// echo clearing BS to terminal
+	}*/
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+// txidle returns TRUE if the UART is not sending a chr and the tx buffer is empty
+//-----------------------------------------------------------------------------
+//
+char txidle(void)
+{
+
+	return (char)qTI0B;
+}
+
+//-----------------------------------------------------------------------------
+// putss() does puts w/o newline
+//-----------------------------------------------------------------------------
+
+void putss (char* string)
+{
+	while(*string){
+		if(*string == '\n') putch('\r');
+		putch(*string++);
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// putsnb() does puts w/o newline, w/o waiting.  Sends as much of the string as fits
+//	in the tx buffer and returns a pointer to the rest ('\0' if all sent).
+//-----------------------------------------------------------------------------
+
+char* putsnb (char* string)
+{
+	U8	n;
+
+	n = txd_tptr - txd_hptr - 1;			// # free in tx buffer
+	if(txd_tptr <= txd_hptr){
+		n += TXD_BUFF_END;
+	}
+	while(*string && (n > 1)){				// leave room for a CR
+		if(*string == '\n'){
+			putch('\r');
+			n--;
+		}
+		putch(*string++);
+		n--;
+	}
+	return string;
+}
+
+//-----------------------------------------------------------------------------
+// rxd_intr
+//-----------------------------------------------------------------------------
+//
+// UART intr.  Captures RX data and places into circular buffer
+//	For TX, sends the next chr from the tx buffer, and sets qTI0B when the buffer
+//	is empty so putch() knows to re-start the UART.
+//	Uses reg bank 2 with the other low priority ISRs (Timer2, port match): they can't
+//	nest, so they share the bank instead of pushing R0-R7 on the stack (no calls here).
+//
+//-----------------------------------------------------------------------------
+// uart1_intr
+//-----------------------------------------------------------------------------
+//
+// UART1 rx intr.  Captures RX data and places into circular buffer
+//
+
+INTERRUPT_USING(rxd_intr, 4, 2)
+{
+/* buffer registers repeated here for reference ... !! DO NOT UNCOMMENT !!
+S8   rxd_buff[10];					// rx data buffer
+U8   rxd_hptr = 0;					// rx buf head ptr
+U8   rxd_tptr = 0;					// rx buf tail ptr
+U8   rxd_stat = 0;					// rx buff status*/
+
+	char	c;
+
+	if(TI0){
+		TI0 = 0;
+		if(txd_tptr != txd_hptr){
+			HAL_UART_WR(txd_buff[txd_tptr]);		// send next chr
+			if(++txd_tptr == TXD_BUFF_END){
+				txd_tptr = 0;
+			}
+		}else{
+			qTI0B = 1;							// tx buffer empty, set TX idle flag
+		}
+	}
+	if(RI0){
+		c = HAL_UART_RD();
+		if((c == '\n') || (c == ESC)){			// don't capture linefeeds or ESC
+			if(c == ESC){
+				rxd_hptr = 0;					// if ESC, re-init serial buffer
+				rxd_tptr = 0;
+				rxd_crcnt = 0;
+				rxd_stat = RXD_ESC;
+			}
+		}else{
+			rxd_buff[rxd_hptr] = c;
+			if(rxd_buff[rxd_hptr] == '\r'){
+				rxd_crcnt++;					// set CR rcvd flag
+			}
+			if(rxd_buff[rxd_hptr] == '\b'){
+				if(rxd_hptr != rxd_tptr){		// only process BS if buffer is not empty
+					rxd_stat |= RXD_BS;			// set BS rcvd flag
+					if(rxd_hptr == 0){			// decrement headptr and rollunder if needed
+						rxd_hptr = RXD_BUFF_END;
+					}
+					rxd_hptr--;
+				}
+			}else{
+				if(++rxd_hptr == RXD_BUFF_END){	// increment headptr and rollover if needed
+					rxd_hptr = 0;
+				}
+			}
+			if(rxd_hptr == rxd_tptr){			// check for overflow, flag error if true
+				rxd_stat |= RXD_ERR;
+			}
+		}
+		RI0 = 0;								// clear intr flag
+	}
+	return;
+}
@@ -1,45 +1,50 @@
-/*************************************************************************
- *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
- *
- *  File name: serial.h
- *
- *  Module:    Control
- *
- *  Summary:   This is the header file for serial I/O.
- *
- *******************************************************************/
-
-/********************************************************************
- *  File scope declarations revision history:
- *    09-09-12 jmh:  creation date
- *
- *******************************************************************/
-
+/*************************************************************************
+ *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: serial.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This is the header file for serial I/O.
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    09-09-12 jmh:  creation date
+ *
+ *******************************************************************/
+
+//------------------------------------------------------------------------------
+
+// extern defines
 //------------------------------------------------------------------------------
-
-// extern defines
-//------------------------------------------------------------------------------
 
 //------------------------------------------------------------------------------
-
-// public Function Prototypes
 
-//------------------------------------------------------------------------------
+// public Function Prototypes
 
-void init_serial(void);
-char putch(const char c);
-void cleanline(void);
-char getch00(void);
-char gotch00(void);
-char gotcr(void);
-void putss (char *string);
+//------------------------------------------------------------------------------
+
+void init_serial(void);
+INTERRUPT_PROTO_USING(rxd_intr, 4, 2);				// SDCC needs the ISR visible where main() is
+char putch(const char c);
+void tx_mute(U8 on);
+void cleanline(void);
+char getch00(void);
+char gotch00(void);
+char peekch(U8 i);
+char gotcr(void);
+char txidle(void);
+char* putsnb (char* string);
+void putss (char *string);
 
-//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
 
-// global defines
+// global defines
 
 //------------------------------------------------------------------------------
-
-#define NOTBUF 0
-#define TBUF 1
-#define	ESC	27
+
+#define NOTBUF 0
+#define TBUF 1
+#define	ESC	27
@@ -0,0 +1,1658 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: sim.c
+ *
+ *  Module:    Host simulator
+ *
+ *  Summary:   Runs the beacon firmware (the real main.c, serial.c, flash.c, f300_init.c,
+ *				adfcalc.c, channels.c, and cwconst.c built with -DHOST_SIM) against a model
+ *				of the C8051F52x and the board:
+ *				  - SFRs are plain variables (c8051F520.h).  The sbit/byte aliases (IE/EA,
+ *					TCON/TR0, P1/KEYOUT, ..) are kept coherent at every basic block.
+ *				  - virtual clock.  The firmware objects are built with
+ *					-fsanitize-coverage=trace-pc and every basic block charges BLK_CYC
+ *					SYSCLK cycles.  This is a coarse CPU time model: the peripherals
+ *					below are timed exactly, the code between them is not.  SYSCLK
+ *					follows OSCICN.
+ *				  - Timer2 (auto-reload at SYSCLK/12, TF2H), Timer0 (mode 1, TF0, for
+ *					delay_us()), Timer1 (UART baud rate), PCA0 count (SYSCLK/12, PCA0L
+ *					latches PCA0H), and the PCA WDT (module 2, a PCA0CPH2 write kicks it).
+ *				  - intrs at block boundaries: INT0 (nPTT, P0.3, edge, IT01CF polarity),
+ *					UART0, Timer2, and port match (P1MAT/P1MASK), with the IP priority
+ *					(a high priority ISR preempts a low one).  PCON idle jumps to the
+ *					next event.
+ *				  - UART0 at the Timer1 rate.  The host end runs at 9600 baud (or the
+ *					scenario "baud"), and a mismatch over 4% garbles the chr.  Rx data comes from the scenario,
+ *					or from a pty (-p).
+ *				  - SPI (hal.h hooks).  ADF4351 frames latch on the nPLL_LE rising edge,
+ *					LTC2630 frames on the DAC /CS (KEYOUT) rising edge.  The PLL model
+ *					decodes R0-R5 (10 MHz ref) and holds lock-detect (MISO) low for a
+ *					lock delay after an R0 write or a VCO power up.  An injected unlock
+ *					holds it low until R0 is sent again.  RF is on when R4 enables it,
+ *					muted while unlocked if R4 has MTLD set.  The bit-bang SPI (BB_SPI) is
+ *					not modeled.
+ *				  - FLASH (hal.h hook).  A write w/o the FLKEY key, PSWE, or the VDD
+ *					monitor is a flash error reset.  Writes AND into the image, erase
+ *					clears the sector, and both stall the CPU.  The key is taken as
+ *					given if the last FLKEY write was 0xF1 (the 0xA5, 0xF1 pair is in
+ *					one basic block).
+ *				  - resets.  Each boot is a fork()ed child, so the firmware starts with
+ *					fresh (STARTUP.A51 cleared) globals.  The "noinit" section (the warm
+ *					restart block, upper idata on the target) is carried over all but a
+ *					power-on reset.  The FLASH image, clock, PLL, and stats are in
+ *					shared memory.  A power-on or brown-out also resets the PLL.
+ *
+ *				sim-boot runs the UART bootloader (boot.c and flash.c) on the same model
+ *				instead of the app.  Its app start (HAL_APP_JMP) is counted ("app") and
+ *				the CPU then idles until the next reset.
+ *
+ *				The scenario file drives the inputs and sets the pass limits (see
+ *				sim/README).  The trace (-t) has one "t_us EVENT data" line per event.
+ *				The stats are printed at the end, and the exit code is 1 if a limit
+ *				failed.
+ *
+ *  Build:     make -C sim
+ *  Usage:     sim [-t trace] [-g spitrace] [-u uart] [-p] [-T sec] [-q] scenario
+ *				-t file	  event trace
+ *				-g file	  SPI frame trace (PLL and DAC frames, KEYOUT edges, see trdiff.c)
+ *				-u file	  UART output transcript
+ *				-p		  pty mode: the UART is a pseudo-terminal (its name is
+ *						  printed) and the clock runs in real time
+ *				-T sec	  stop at sec seconds (default: the scenario "end")
+ *				-q		  don't print the stats (exit code only)
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#define	_XOPEN_SOURCE	600
+#define	_DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+// firmware headers last: typedef.h (HOST_SIM) defines away the 8051 memory qualifiers
+#include "../typedef.h"
+#include "../c8051F520.h"
+#include "../main.h"
+#include "../flash.h"
+#include "../cwconst.h"
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	FOSC		24500000.0		// internal oscillator (Hz) = 1 tic of the virtual clock
+#define	TUS			(FOSC / 1e6)	// tics per us
+#define	BLK_CYC		8				// SYSCLK cycles charged per basic block
+#define	IRQ_CYC		20				// SYSCLK cycles per intr (vector, push, reti)
+#define	FLASH_SIZE	0x2000
+#define	FL_WR_US	40.0			// byte write stall
+#define	FL_ER_US	20000.0			// sector erase stall
+#define	RST_US		100.0			// reset (pin, wdt, sw, flash error) to 1st instr
+#define	POR_US		1000.0			// power-on/brown-out (VDD ramp + VDD monitor)
+#define	HOST_BAUD	9600.0			// host end of the UART (default)
+#define	BAUD_TOL	0.04			// max baud mismatch before chrs are garbled
+#define	REF_MHZ		10.0			// ADF4351 reference
+#define	LK_BASE		300.0			// default lock delay: us after an R0 write,
+#define	LK_MHZ		1.0				//	plus us per MHz of VCO step,
+#define	LK_VCO		20.0			//	and us after a VCO power up
+#define	NEVER		(~0ULL)
+
+// main.c pin and register constants (REVC_HW = 0)
+#define	LE_ACT		0				// nPLL_LE low = shift, rising edge latches
+#define	LOCK_PIN	1				// MISO (MUXOUT) high = locked
+#define	RF_ENAB		0x0020			// R4
+#define	VCO_DISAB	0x0800
+#define	MTLD		0x0400			// R4 mute till lock detect
+#define	R2_PD		0x0020			// R2 power down
+#define	EMAT		0x80			// EIE1 port match enable
+#define	IN0PL		0x08			// IT01CF INT0 polarity (1 = active high)
+#define	WDTE		0x40			// PCA0MD
+#define	T1M			0x08			// CKCON
+#define	T0M			0x04
+#define	PINRSF		0x01			// RSTSRC flags
+#define	WDTRSF		0x08
+#define	SWRSF		0x10
+#define	FERROR		0x40
+#define	OSC_RST		0xC4			// OSCICN reset value (SYSCLK/8)
+#define	WDT_SENT	0xa5			// PCA0CPH2 is set to this after each kick
+
+// exit codes of a boot (child)
+#define	EX_RESET	10
+#define	EX_DONE		11
+
+// reset sources
+enum { RS_POR, RS_BOD, RS_PIN, RS_WDT, RS_SW, RS_FLE, RS_N };
+const char* rs_name[RS_N] = { "por", "bod", "pin", "wdt", "sw", "fle" };
+const U8 rs_flag[RS_N] = { PORSF, PORSF, PINRSF, WDTRSF, SWRSF, FERROR };
+
+// scenario events
+enum { EV_TX, EV_PTT, EV_FSEL, EV_RESET, EV_UNLOCK, EV_LOCKDLY, EV_GAP, EV_STATS, EV_END };
+#define	MAX_EV		4096
+#define	EV_TXT		120
+
+// sample stats (us)
+enum { ST_EDGE, ST_JIT, ST_LATE, ST_PTT, ST_FSEL, ST_DEAD, ST_LKW, ST_UNLK, ST_ISR_T2, ST_ISR_RX, ST_RST, ST_RSRC,
+	ST_N = ST_RSRC + RS_N };
+const char* st_name[ST_N] = { "edge", "jitter", "late", "ptt", "fsel", "dead", "lkwait", "unlock", "isr_t2", "isr_rx",
+	"reset", "rst_por", "rst_bod", "rst_pin", "rst_wdt", "rst_sw", "rst_fle" };
+#define	MAX_SMP		65536
+
+#define	MAX_LIM		64
+#define	UART_LOG	65536
+#define	MAX_LINE	256
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+typedef unsigned long long T64;
+
+struct ev {
+	T64		t;
+	int		type;
+	double	a, b, c;
+	char	txt[EV_TXT];
+	int		n;							// tx: # chrs (binary data may hold a NUL)
+};
+
+struct lim {
+	char	name[32];
+	char	pfx[EV_TXT];				// "uart" limit: text in front of the number
+	int		ge;							// 1 = ">=", else "<="
+	double	v;
+};
+
+struct smp {
+	int		n;
+	double	v[MAX_SMP];
+};
+
+// everything that outlives a reset is in shared memory
+struct sim {
+	T64		t;							// virtual clock (FOSC tics)
+	T64		t_end;
+	U8		flash[FLASH_SIZE];
+	// reset
+	int		rst;						// cause of the last reset (RS_xx)
+	T64		rst_t;
+	int		n_rst[RS_N];
+	int		rst_rf;						// waiting for the 1st RF frame after a reset
+	U8		noinit[256];
+	U32		seed;
+	// UART
+	double	baud;						// host end
+	char	rxq[4096];
+	int		rxq_h, rxq_t;
+	T64		rx_nxt;
+	T64		rx_last;
+	int		n_ovr, n_garble;
+	char	ulog[UART_LOG];
+	int		ulog_n;
+	char	uline[MAX_LINE];
+	int		uline_n;
+	// PLL
+	U32		reg[6];
+	U32		sr;
+	U8		le;
+	U8		locked;
+	U8		unlk;						// injected unlock (cleared by an R0 write)
+	T64		lk_nxt;
+	double	lk_need;					// freq step not settled yet (us)
+	double	lk_base, lk_mhz, lk_vco;	// lock delay model
+	double	fvco, fout;
+	U8		rf;
+	T64		early_t;					// RF on while unlocked since
+	// DAC
+	U32		dsr;
+	U8		cs;
+	// scenario
+	struct ev ev[MAX_EV];
+	int		nev, iev;
+	struct lim lim[MAX_LIM];
+	int		nlim;
+	U8		ptt;						// 1 = pressed (nPTT low)
+	U8		fsel;						// BCD channel inputs
+	// stats
+	T64		st_t0;						// stats window start
+	double	unit_us;					// element time (0 = from the msg header)
+	T64		dn_t0, dn_prev;				// 1st and last key-down edge
+	double	dn_units;					// units between the 1st and last key-down edge
+	double	dn_skip;					// us of key-down intervals not timed (scenario gaps)
+	int		dn_n;
+	T64		gap_t0, gap_t1;				// scenario gap: key-down intervals that overlap it are not timed
+	int		n_miss;						// element edges missed (Timer2 edge with the last one not taken)
+	T64		ptt_t;						// PTT edge waiting for its R4 frame
+	T64		fsel_t;						// FSEL change waiting for its R0 frame
+	T64		r0_t;						// R0 write (new freq) waiting for RF on
+	T64		lkw_t;						// lock after a freq step, waiting for the R4 frame
+	T64		unlk_t;						// injected unlock waiting for lock
+	double	rf_early;					// RF on while unlocked (us)
+	int		n_wdt;						// WDT timeouts (not injected)
+	int		n_app;						// sim-boot: app starts
+	int		n_frames;
+	struct smp smp[ST_N];
+	double	jit_nu[MAX_SMP];			// units per edge interval (jitter fit)
+};
+
+struct sim* S;
+U8 * sim_flash;
+
+FILE*	trc_f;
+FILE*	spi_f;
+FILE*	uart_f;
+int		pty_fd = -1;
+int		quiet;
+struct timespec	wall0;					// pty mode: wall clock at t = 0
+
+// per boot (child) state
+T64		nxt;							// next due event
+T64		t2_nxt, t0_nxt, tx_nxt, wdt_nxt, rt_nxt;
+T64		elem_t;							// element edge (elem_flag set) waiting for main() to take it
+T64		blk;							// tics per basic block
+U32		sdiv;							// SYSCLK divider
+T64		pca_t;							// PCA0 count at pca_t
+U32		pca_c;
+U8		pca_hl;							// PCA0H latch
+U8		tx_c;
+int		lvl = -1;						// intr level running (-1 = none, 0 = low, 1 = high)
+U8		osc_sh, pcamd_sh, tr0_sh, tr2_sh, rst_rd, p1_out;
+
+// firmware.  The app's symbols are weak: sim-boot has only boot.c (no intrs, EA stays 0)
+#define	APP		__attribute__((weak))
+void fw_main(void);
+APP void Timer2_ISR(void);
+APP void ptt_isr(void);
+APP void fsel_isr(void);
+APP void rxd_intr(void);
+extern volatile _Bool PB0 APP, PB1 APP, PB2 APP, KEYOUT APP, SCK APP, MISO APP, MOSI APP, nPTT APP, nPLL_LE APP;
+extern volatile _Bool elem_flag APP;			// element edge (main.c): set by Timer2_ISR, cleared by elem_task()
+extern volatile U16 elem_timer APP;
+extern U32 pll_ch_array[];
+extern U8 cw_img[] __asm__("diode_matrix");		// cwconst.h maps diode_matrix onto sim_flash
+extern U8 __start_noinit[] __attribute__((weak)), __stop_noinit[] __attribute__((weak));	// none if WARM_EN = 0
+
+// sbit/byte alias groups
+struct grp {
+	volatile U8*	b;
+	volatile _Bool*	sb[8];
+	U8		sh;							// value last written to the byte and sbits
+	U8		lat;						// latch
+	U8		ext;						// pins (ports), 1 = not driven low
+};
+
+struct grp g_p0 = { &P0, { &SCK, &MISO, &MOSI, &nPTT, 0, 0, 0, &nPLL_LE } };
+struct grp g_tcon = { &TCON, { &IT0, &IE0, &IT1, &IE1, &TR0, &TF0, &TR1, &TF1 } };
+struct grp g_p1 = { &P1, { &PB0, &PB1, &PB2, 0, 0, 0, 0, &KEYOUT } };
+struct grp g_scon = { &SCON0, { &RI0, &TI0, &RB80, &TB80, &REN0, &MCE0, 0, &S0MODE } };
+struct grp g_ie = { &IE, { &EX0, &ET0, &EX1, &ET1, &ES0, &ET2, &ESPI0, &EA } };
+struct grp g_ip = { &IP, { &PX0, &PT0, &PX1, &PT1, &PS0, &PT2, &PSPI0, 0 } };
+struct grp g_t2 = { &TMR2CN, { &T2XCLK, &T2RCLK, &TR2, &T2SPLIT, &TF2CEN, &TF2LEN, &TF2L, &TF2H } };
+struct grp* grps[] = { &g_p0, &g_tcon, &g_p1, &g_scon, &g_ie, &g_ip, &g_t2 };
+#define	NGRP	(int)(sizeof(grps) / sizeof(grps[0]))
+
+// intr sources, in poll order
+#define	NIRQ	4
+#define	IRQ_RX	1
+#define	IRQ_T2	2
+void (*const isr[NIRQ])(void) = { ptt_isr, rxd_intr, Timer2_ISR, fsel_isr };
+
+//------------------------------------------------------------------------------
+// local fn declarations
+//------------------------------------------------------------------------------
+
+void sim_reset(int src);
+void sim_done(void);
+void sched(void);
+void sim_events(void);
+void sfr_chk(void);
+void trc(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+//-----------------------------------------------------------------------------
+// time helpers
+//-----------------------------------------------------------------------------
+double t_us(T64 t){
+
+	return (double)t / TUS;
+}
+
+T64 us_t(double us){
+
+	return (T64)(us * TUS + 0.5);
+}
+
+//-----------------------------------------------------------------------------
+// trc() writes a trace line
+//-----------------------------------------------------------------------------
+void trc(const char* fmt, ...){
+	va_list	ap;
+
+	if(!trc_f) return;
+	fprintf(trc_f, "%12.1f ", t_us(S->t));
+	va_start(ap, fmt);
+	vfprintf(trc_f, fmt, ap);
+	va_end(ap);
+	fputc('\n', trc_f);
+}
+
+//-----------------------------------------------------------------------------
+// smp_add() adds a sample (us) to a stat, if the stats window is open
+//-----------------------------------------------------------------------------
+void smp_add(int k, double v){
+	struct smp* s = &S->smp[k];
+
+	if(S->t < S->st_t0) return;
+	if(s->n < MAX_SMP){
+		s->v[s->n++] = v;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sbit/byte alias groups.  A byte write (byte != the value last written) loads the
+//	latch, else a changed sbit loads its latch bit.  Then the byte and the sbits all
+//	read latch & pins.
+//-----------------------------------------------------------------------------
+void grp_out(struct grp* g){
+	U8	v = g->lat & g->ext;
+	int	i;
+
+	*g->b = v;
+	for(i = 0; i < 8; i++){
+		if(g->sb[i]) *g->sb[i] = (v >> i) & 1;
+	}
+	g->sh = v;
+}
+
+void grp_sync(struct grp* g){
+	U8	v = *g->b;
+	int	i;
+	int	w = 0;
+
+	if(v != g->sh){
+		g->lat = v;
+		w = 1;
+	}else{
+		for(i = 0; i < 8; i++){
+			if(g->sb[i] && (*g->sb[i] != ((v >> i) & 1))){
+				g->lat = (g->lat & ~(1 << i)) | (*g->sb[i] << i);
+				w = 1;
+			}
+		}
+	}
+	if(w) grp_out(g);
+}
+
+// sim side latch write (intr flags)
+void grp_set(struct grp* g, int i, int v){
+
+	grp_sync(g);
+	if(v) g->lat |= 1 << i;
+	else g->lat &= ~(1 << i);
+	grp_out(g);
+}
+
+// sim side pin change
+void grp_pin(struct grp* g, int i, int v){
+
+	grp_sync(g);
+	if(v) g->ext |= 1 << i;
+	else g->ext &= ~(1 << i);
+	grp_out(g);
+}
+
+//-----------------------------------------------------------------------------
+// clock helpers
+//-----------------------------------------------------------------------------
+U32 pca_now(void){
+
+	return pca_c + (U32)((S->t - pca_t) / (12 * sdiv));
+}
+
+U32 t_pre(U8 fast){
+
+	if(CKCON & fast) return 1;
+	switch(CKCON & 0x03){
+		case 1: return 4;
+		case 2: return 48;
+		default: return 12;
+	}
+}
+
+T64 t2_per(void){
+
+	return (T64)(65536 - (((U32)TMR2RLH << 8) | TMR2RLL)) * 12 * sdiv;
+}
+
+T64 wdt_per(void){
+
+	return (T64)256 * (PCA0CPL2 ? PCA0CPL2 : 256) * 12 * sdiv;
+}
+
+double fw_baud(void){
+
+	return FOSC / sdiv / t_pre(T1M) / (256 - TH1) / 2.0;
+}
+
+int baud_ok(void){
+
+	return fabs(fw_baud() / S->baud - 1.0) <= BAUD_TOL;
+}
+
+// t2_save() puts the running Timer2 count into TMR2H:TMR2L
+void t2_save(void){
+	U32	d = 12 * sdiv;
+	U32	c;
+
+	if(t2_nxt == NEVER) return;
+	c = 65536 - (U32)((t2_nxt - S->t + d - 1) / d);
+	TMR2L = (U8)c;
+	TMR2H = (U8)(c >> 8);
+}
+
+// OSCICN change: the running timers finish their periods at the new rate
+void clk_chg(void){
+	U32	d = 1 << (7 - (OSCICN & 7));
+
+	if(d == sdiv) return;
+	pca_c = pca_now();
+	pca_t = S->t;
+	if(t2_nxt != NEVER) t2_nxt = S->t + (t2_nxt - S->t) / sdiv * d;
+	if(t0_nxt != NEVER) t0_nxt = S->t + (t0_nxt - S->t) / sdiv * d;
+	if(wdt_nxt != NEVER) wdt_nxt = S->t + (wdt_nxt - S->t) / sdiv * d;
+	trc("CLK SYSCLK/%u", (unsigned)d);
+	sdiv = d;
+	blk = BLK_CYC * sdiv;
+	sched();
+}
+
+//-----------------------------------------------------------------------------
+// key timing stats.  Each key-down to key-down interval is compared to the
+//	nearest whole number of msg elements (edge), and again after the mean rate
+//	error over the run is taken out (jitter, in report()).
+//-----------------------------------------------------------------------------
+void msg_unit(void){
+	U8*	m = S->flash + SECTCW_ADDR;
+
+	if(S->unit_us != 0) return;
+	S->unit_us = (((U32)m[DIT_IDX] << 8) | m[DIT_IDX + 1]) * 1000.0;
+	if(m[KEY_IDX] & QRSS_MASK){
+		S->unit_us *= QRSS_SCALE;
+	}
+}
+
+void key_edge(void){
+	double	dt, nu, e;
+
+	if(S->t < S->st_t0) return;
+	msg_unit();
+	if(S->dn_n == 0){
+		S->dn_t0 = S->t;
+	}else{
+		dt = t_us(S->t - S->dn_prev);
+		if((S->dn_prev < S->gap_t1) && (S->t > S->gap_t0)){
+			S->dn_skip += dt;							// spans a scenario gap
+		}else{
+			nu = floor(dt / S->unit_us + 0.5);
+			e = dt - (nu * S->unit_us);
+			if(S->smp[ST_EDGE].n < MAX_SMP){
+				S->jit_nu[S->smp[ST_EDGE].n] = nu;
+			}
+			smp_add(ST_EDGE, e);
+			S->dn_units += nu;
+		}
+	}
+	S->dn_prev = S->t;
+	S->dn_n++;
+}
+
+//-----------------------------------------------------------------------------
+// rf_upd() tracks the RF output: PLL up, RF enabled, VCO on, and locked if R4
+//	has MTLD (mute till lock detect) set
+//-----------------------------------------------------------------------------
+void rf_upd(void){
+	U8	rf;
+
+	rf = !(S->reg[2] & R2_PD) && (S->reg[4] & RF_ENAB) && !(S->reg[4] & VCO_DISAB) &&
+		 (S->locked || !(S->reg[4] & MTLD));
+	if(rf && !S->locked){
+		if(S->early_t == NEVER) S->early_t = S->t;
+	}else if(S->early_t != NEVER){
+		if(S->t >= S->st_t0) S->rf_early += t_us(S->t - S->early_t);
+		S->early_t = NEVER;
+	}
+	if(rf == S->rf) return;
+	S->rf = rf;
+	trc("RF %s", rf ? "on" : "off");
+	if(rf){
+		key_edge();
+		if(S->r0_t != NEVER){
+			smp_add(ST_DEAD, t_us(S->t - S->r0_t));
+			S->r0_t = NEVER;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// PLL model
+//-----------------------------------------------------------------------------
+void pll_freq(void){
+	U32	r0 = S->reg[0], r1 = S->reg[1], r2 = S->reg[2], r4 = S->reg[4];
+	U32	mod = (r1 >> 3) & 0xfff;
+	U32	rc = (r2 >> 14) & 0x3ff;
+	double	pfd;
+
+	if(rc == 0) rc = 1;
+	if(mod == 0) mod = 1;
+	pfd = REF_MHZ * ((r2 & (1L << 25)) ? 2 : 1) / (rc * ((r2 & (1L << 24)) ? 2 : 1));
+	S->fvco = pfd * (((r0 >> 15) & 0xffff) + (double)((r0 >> 3) & 0xfff) / mod);
+	S->fout = S->fvco / (1 << ((r4 >> 20) & 7));
+}
+
+void pll_lock_set(U8 v){
+
+	if(v == S->locked) return;
+	S->locked = v;
+	grp_pin(&g_p0, 1, v ? LOCK_PIN : !LOCK_PIN);
+	trc("LOCK %d", v);
+	if(v){
+		if(S->lk_need != 0) S->lkw_t = S->t;
+		S->lk_need = 0;
+		if(S->unlk_t != NEVER){
+			smp_add(ST_UNLK, t_us(S->t - S->unlk_t));
+			S->unlk_t = NEVER;
+		}
+	}
+	rf_upd();
+}
+
+// pll_relock() drops lock for us (or until a pending relock is done, if that is
+//	later).  No lock while the PLL or VCO is powered down, and a freq step that is
+//	still settling (lk_need) is added at the next VCO power up.
+void pll_relock(double us){
+	T64	n = S->t + us_t(us);
+
+	pll_lock_set(0);
+	if(S->unlk || (S->reg[2] & R2_PD) || (S->reg[4] & VCO_DISAB)){
+		S->lk_nxt = NEVER;
+	}else{
+		if((S->lk_nxt != NEVER) && (S->lk_nxt > n)) n = S->lk_nxt;
+		S->lk_nxt = n;
+	}
+	sched();
+}
+
+void pll_latch(void){
+	U32	r = S->sr;
+	U32	old;
+	int	n = r & 7;
+	double	f0 = S->fvco;
+
+	S->n_frames++;
+	if(spi_f) fprintf(spi_f, "%12.1f PLL R%d %08lX\n", t_us(S->t), n, (unsigned long)r);
+	if(n > 5){
+		trc("PLL bad frame %08lX", (unsigned long)r);
+		return;
+	}
+	old = S->reg[n];
+	S->reg[n] = r;
+	pll_freq();
+	trc("PLL R%d %08lX  %.6f MHz", n, (unsigned long)r, S->fout);
+	switch(n){
+		case 0:
+			S->unlk = 0;
+			S->lkw_t = NEVER;
+			if(S->fsel_t != NEVER){
+				smp_add(ST_FSEL, t_us(S->t - S->fsel_t));
+				S->fsel_t = NEVER;
+			}
+			if(S->fvco != f0){
+				S->r0_t = S->t;
+				S->lk_need = S->lk_base + S->lk_mhz * fabs(S->fvco - f0);
+			}
+			pll_relock(S->lk_base + S->lk_mhz * fabs(S->fvco - f0));
+			break;
+
+		case 2:
+			if((r ^ old) & R2_PD){
+				pll_relock(S->lk_vco + S->lk_need);
+			}
+			break;
+
+		case 4:
+			if(S->lkw_t != NEVER){
+				smp_add(ST_LKW, t_us(S->t - S->lkw_t));
+				S->lkw_t = NEVER;
+			}
+			if(S->ptt_t != NEVER){
+				if((S->ptt && !(r & VCO_DISAB)) || (!S->ptt && (r & VCO_DISAB))){
+					smp_add(ST_PTT, t_us(S->t - S->ptt_t));
+					S->ptt_t = NEVER;
+				}
+			}
+			if(S->rst_rf && (r & RF_ENAB) && !(r & VCO_DISAB)){
+				smp_add(ST_RST, t_us(S->t - S->rst_t));
+				smp_add(ST_RSRC + S->rst, t_us(S->t - S->rst_t));
+				trc("BOOT %s to RF %.1f us", rs_name[S->rst], t_us(S->t - S->rst_t));
+				S->rst_rf = 0;
+			}
+			if((r ^ old) & VCO_DISAB){
+				pll_relock(S->lk_vco + S->lk_need);
+			}
+			break;
+	}
+	rf_upd();
+}
+
+//-----------------------------------------------------------------------------
+// hal.h hooks
+//-----------------------------------------------------------------------------
+void sim_spi_wr(U8 d){
+
+	S->sr = (S->sr << 8) | d;
+	S->dsr = ((S->dsr << 8) | d) & 0xffffff;
+	S->t += (T64)16 * (SPI0CKR + 1) * sdiv;		// 8 SCK at SYSCLK / (2 * (SPI0CKR + 1))
+}
+
+void sim_pll_le(U8 x){
+
+	x = x ? 1 : 0;
+	grp_set(&g_p0, 7, x);
+	if((x != LE_ACT) && (S->le == LE_ACT)){
+		pll_latch();
+	}
+	S->le = x;
+}
+
+void sim_dac_cs(U8 x){
+
+	x = x ? 1 : 0;
+	if(x && !S->cs){
+		if(spi_f) fprintf(spi_f, "%12.1f DAC %06lX\n", t_us(S->t), (unsigned long)S->dsr);
+		trc("DAC %06lX", (unsigned long)S->dsr);
+	}
+	S->cs = x;
+	grp_set(&g_p1, 7, x);
+	p1_out = (p1_out & 0x7f) | (x << 7);			// a /CS edge is not a key edge
+}
+
+// Timer2 count: while it runs the count is kept as t2_nxt, while it is stopped in
+//	TMR2H:TMR2L.  The sbits and SFRs are synced 1st, the caller has just cleared TR2.
+U16 sim_t2_rd(void){
+
+	grp_sync(&g_t2);
+	sfr_chk();
+	t2_save();
+	return ((U16)TMR2H << 8) | TMR2L;
+}
+
+void sim_t2_wr(U16 v){
+
+	grp_sync(&g_t2);
+	sfr_chk();
+	TMR2L = (U8)v;
+	TMR2H = (U8)(v >> 8);
+	if(t2_nxt != NEVER){
+		t2_nxt = S->t + (T64)(65536 - v) * 12 * sdiv;
+		sched();
+	}
+}
+
+U8 sim_pca_lo(void){
+	U32	c = pca_now();
+
+	pca_hl = (U8)(c >> 8);
+	return (U8)c;
+}
+
+U8 sim_pca_hi(void){
+
+	return pca_hl;
+}
+
+void sim_uart_wr(U8 c){
+
+	tx_c = c;
+	tx_nxt = S->t + (T64)20 * (256 - TH1) * t_pre(T1M) * sdiv;	// 10 bits, Timer1 / 2 per bit
+	sched();
+}
+
+U8 sim_uart_rd(void){
+
+	return SBUF0;
+}
+
+void sim_flash_wr(U8 * a, U8 d){
+	long	addr = a - sim_flash;
+	int		i;
+
+	if((FLKEY != 0xf1) || !(PSCTL & PSWE) || !(VDDMON & 0x80) || (addr < 0) || (addr >= FLASH_SIZE)){
+		trc("FLASH error %04lX (FLKEY %02X PSCTL %02X VDDMON %02X)", addr, FLKEY, PSCTL, VDDMON);
+		sim_reset(RS_FLE);
+	}
+	FLKEY = 0;										// the key is good for one write
+	if(PSCTL & PSEE){
+		addr &= ~(SECTOR_SIZE - 1);
+		for(i = 0; i < SECTOR_SIZE; i++){
+			S->flash[addr + i] = 0xff;
+		}
+		trc("FLASH erase %04lX", addr);
+		S->t += us_t(FL_ER_US);
+	}else{
+		S->flash[addr] &= d;
+		S->t += us_t(FL_WR_US);
+	}
+}
+
+// sim-boot: the bootloader starts the app.  There is none, so the CPU idles (the
+//	events still run) until a reset or the end.
+void sim_app_jmp(U16 a){
+
+	trc("APP start %04X", a);
+	S->n_app++;
+	for(;;){
+		S->t = nxt;
+		sim_events();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// UART
+//-----------------------------------------------------------------------------
+void uart_out(U8 c){
+
+	if(!baud_ok()){
+		c = '?';
+		S->n_garble++;
+	}
+	if(S->ulog_n < UART_LOG - 1){
+		S->ulog[S->ulog_n++] = c;
+	}
+	if(uart_f) fputc(c, uart_f);
+	if(pty_fd >= 0){
+		if(write(pty_fd, &c, 1) < 0){}			// nobody on the slave end
+	}
+	if((c == '\n') || (c == '\r') || (S->uline_n == MAX_LINE - 1)){
+		if(S->uline_n){
+			S->uline[S->uline_n] = '\0';
+			trc("UART \"%s\"", S->uline);
+			S->uline_n = 0;
+		}
+	}else if(isprint(c)){
+		S->uline[S->uline_n++] = c;
+	}
+}
+
+void rx_sched(void){
+
+	if((S->rx_nxt == NEVER) && (S->rxq_h != S->rxq_t)){
+		S->rx_nxt = S->rx_last + us_t(10e6 / S->baud);
+		if(S->rx_nxt < S->t) S->rx_nxt = S->t;
+		sched();
+	}
+}
+
+void rx_put(const char* s, int n){
+	int	i;
+
+	for(i = 0; i < n; i++){
+		S->rxq[S->rxq_h] = s[i];
+		S->rxq_h = (S->rxq_h + 1) % sizeof(S->rxq);
+	}
+	rx_sched();
+}
+
+void rx_chr(void){
+	U8	c = S->rxq[S->rxq_t];
+
+	S->rxq_t = (S->rxq_t + 1) % sizeof(S->rxq);
+	S->rx_last = S->t;
+	S->rx_nxt = NEVER;
+	if(!baud_ok()){
+		c ^= 0x5a;
+		S->n_garble++;
+	}
+	if(RI0){
+		S->n_ovr++;									// the firmware has not taken the last chr
+		trc("UART rx overrun");
+	}else{
+		SBUF0 = c;
+		grp_set(&g_scon, 0, 1);
+	}
+	rx_sched();
+}
+
+// pty mode: hold the virtual clock to the wall clock, and read the pty
+void pty_poll(void){
+	struct timespec	w;
+	double	ahead;
+	char	b[64];
+	int		n;
+
+	clock_gettime(CLOCK_MONOTONIC, &w);
+	ahead = t_us(S->t) - ((w.tv_sec - wall0.tv_sec) * 1e6 + (w.tv_nsec - wall0.tv_nsec) / 1e3);
+	if(ahead > 1000){
+		usleep((useconds_t)ahead);
+	}
+	n = read(pty_fd, b, sizeof(b));
+	if(n > 0){
+		rx_put(b, n);
+	}
+	rt_nxt = S->t + us_t(1000);
+}
+
+//-----------------------------------------------------------------------------
+// ptt_pin() drives nPTT.  INT0 is edge triggered: IE0 is set when the pin goes to
+//	the active level (IT01CF IN0PL).
+//-----------------------------------------------------------------------------
+void ptt_pin(U8 dn){
+	U8	pin = !dn;
+
+	if(pin == ((g_p0.ext >> 3) & 1)) return;
+	grp_pin(&g_p0, 3, pin);
+	if(pin == ((IT01CF & IN0PL) ? 1 : 0)){
+		grp_set(&g_tcon, 1, 1);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sc_run() runs a scenario event
+//-----------------------------------------------------------------------------
+void sc_run(struct ev* e){
+	int	i;
+
+	switch(e->type){
+		case EV_TX:
+			trc("HOST tx \"%s\"", e->txt);
+			rx_put(e->txt, e->n);
+			break;
+
+		case EV_PTT:
+			S->ptt = (e->a != 0);
+			S->ptt_t = S->t;
+			trc("PTT %d", S->ptt);
+			ptt_pin(S->ptt);
+			break;
+
+		case EV_FSEL:
+			S->fsel = (U8)e->a;
+			S->fsel_t = S->t;
+			trc("FSEL %d", S->fsel);
+			for(i = 0; i < 4; i++){
+				grp_pin(&g_p1, i, !((S->fsel >> i) & 1));	// switch closed = low
+			}
+			break;
+
+		case EV_RESET:
+			sim_reset((int)e->a);
+			break;
+
+		case EV_UNLOCK:
+			trc("PLL unlock (injected)");
+			S->unlk = 1;
+			S->unlk_t = S->t;
+			pll_relock(0);
+			break;
+
+		case EV_LOCKDLY:
+			S->lk_base = e->a;
+			S->lk_mhz = e->b;
+			S->lk_vco = e->c;
+			break;
+
+		case EV_GAP:
+			S->gap_t0 = S->t;
+			S->gap_t1 = S->t + (T64)(e->a * FOSC / 1e3);
+			trc("GAP %.0f ms", e->a);
+			break;
+
+		case EV_STATS:
+			S->st_t0 = S->t;
+			memset(S->smp, 0, sizeof(S->smp));
+			S->dn_n = 0;
+			S->dn_units = 0;
+			S->dn_skip = 0;
+			S->n_miss = 0;
+			S->rf_early = 0;
+			S->n_ovr = 0;
+			S->n_garble = 0;
+			S->n_wdt = 0;
+			trc("STATS");
+			break;
+
+		case EV_END:
+			sim_done();
+			break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sched() finds the next due event
+//-----------------------------------------------------------------------------
+void sched(void){
+	T64	n = S->t_end;
+
+	if(t2_nxt < n) n = t2_nxt;
+	if(t0_nxt < n) n = t0_nxt;
+	if(tx_nxt < n) n = tx_nxt;
+	if(wdt_nxt < n) n = wdt_nxt;
+	if(rt_nxt < n) n = rt_nxt;
+	if(S->rx_nxt < n) n = S->rx_nxt;
+	if(S->lk_nxt < n) n = S->lk_nxt;
+	if((S->iev < S->nev) && (S->ev[S->iev].t < n)) n = S->ev[S->iev].t;
+	nxt = n;
+}
+
+//-----------------------------------------------------------------------------
+// sim_events() runs the events that are due
+//-----------------------------------------------------------------------------
+void sim_events(void){
+	T64	n;
+
+	while(S->t >= nxt){
+		n = nxt;
+		if(t2_nxt <= n){
+			t2_nxt += t2_per();
+			grp_set(&g_t2, 7, 1);						// TF2H
+		}
+		if(t0_nxt <= n){
+			t0_nxt += (T64)65536 * t_pre(T0M) * sdiv;
+			grp_set(&g_tcon, 5, 1);						// TF0
+		}
+		if(tx_nxt <= n){
+			tx_nxt = NEVER;
+			uart_out(tx_c);
+			grp_set(&g_scon, 1, 1);						// TI0
+		}
+		if(S->rx_nxt <= n){
+			rx_chr();
+		}
+		if(S->lk_nxt <= n){
+			S->lk_nxt = NEVER;
+			pll_lock_set(1);
+		}
+		if(wdt_nxt <= n){
+			S->n_wdt++;
+			trc("WDT timeout");
+			sim_reset(RS_WDT);
+		}
+		if(rt_nxt <= n){
+			pty_poll();
+		}
+		while((S->iev < S->nev) && (S->ev[S->iev].t <= n)){
+			sc_run(&S->ev[S->iev++]);
+		}
+		if(S->t_end <= n){
+			sim_done();
+		}
+		sched();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sfr_chk() looks for the SFR writes that start/stop something
+//-----------------------------------------------------------------------------
+void sfr_chk(void){
+	U8	v;
+
+	if(OSCICN != osc_sh){
+		osc_sh = OSCICN;
+		clk_chg();
+	}
+	if(TR0 != tr0_sh){
+		tr0_sh = TR0;
+		t0_nxt = tr0_sh ? S->t + (T64)(65536 - (((U32)TH0 << 8) | TL0)) * t_pre(T0M) * sdiv : NEVER;
+		sched();
+	}
+	if(TR2 != tr2_sh){
+		tr2_sh = TR2;
+		if(tr2_sh){
+			t2_nxt = S->t + (T64)(65536 - (((U32)TMR2H << 8) | TMR2L)) * 12 * sdiv;
+		}else{
+			t2_save();
+			t2_nxt = NEVER;
+		}
+		sched();
+	}
+	if(PCA0MD != pcamd_sh){
+		if((PCA0MD ^ pcamd_sh) & WDTE){
+			wdt_nxt = (PCA0MD & WDTE) ? S->t + wdt_per() : NEVER;
+			sched();
+		}
+		pcamd_sh = PCA0MD;
+	}
+	if(PCA0CPH2 != WDT_SENT){
+		PCA0CPH2 = WDT_SENT;
+		if(wdt_nxt != NEVER){
+			wdt_nxt = S->t + wdt_per();
+			sched();
+		}
+	}
+	if(RSTSRC != rst_rd){
+		v = RSTSRC;
+		RSTSRC = rst_rd;								// reads back the reset flags
+		if(v & SWRSF){
+			sim_reset(RS_SW);
+		}
+	}
+	v = g_p1.lat & 0xf0;
+	if(v != p1_out){
+		if((v ^ p1_out) & 0x80){
+			trc("KEYOUT %d", v >> 7);
+			if(spi_f) fprintf(spi_f, "%12.1f KEY %d\n", t_us(S->t), v >> 7);
+		}
+		if((v ^ p1_out) & 0x70) trc("IO %d", (v >> 4) & 7);
+		p1_out = v;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// irq() runs the highest priority pending intr that can preempt the running level
+//-----------------------------------------------------------------------------
+int irq_pend(int k){
+
+	switch(k){
+		case 0: return IE0 && EX0;
+		case 1: return (TI0 || RI0) && ES0;
+		case 2: return TF2H && ET2;
+		default: return ((P1 & P1MASK) != (P1MAT & P1MASK)) && (EIE1 & EMAT);
+	}
+}
+
+int irq_prio(int k){
+
+	switch(k){
+		case 0: return PX0;
+		case 1: return PS0;
+		case 2: return PT2;
+		default: return 0;
+	}
+}
+
+int irq_sel(void){
+	int	k, p;
+	int	best = -1;
+	int	bp = lvl;
+
+	if(!EA || (lvl == 1)) return -1;
+	for(k = 0; k < NIRQ; k++){
+		if(irq_pend(k)){
+			p = irq_prio(k);
+			if(p > bp){
+				best = k;
+				bp = p;
+			}
+		}
+	}
+	return best;
+}
+
+void irq(void){
+	int	k = irq_sel();
+	int	old = lvl;
+	T64	t0 = S->t;
+	U16	et;
+	_Bool	ef;
+
+	if(k < 0) return;
+	et = elem_timer;
+	ef = elem_flag;
+	lvl = irq_prio(k);
+	if(k == 0){
+		grp_set(&g_tcon, 1, 0);							// IE0 clears on vector (edge mode)
+	}
+	S->t += (T64)IRQ_CYC * sdiv;
+	isr[k]();
+	lvl = old;
+	if(k == IRQ_T2){
+		smp_add(ST_ISR_T2, t_us(S->t - t0));
+		if(elem_timer != et && elem_timer != (U16)(et - 1)){
+			// element timer re-loaded: an element edge
+			if(ef){
+				if(S->t >= S->st_t0) S->n_miss++;		// main() has not taken the last one
+				trc("ELEM miss");
+			}else{
+				elem_t = S->t;
+			}
+		}
+	}else if(k == IRQ_RX){
+		smp_add(ST_ISR_RX, t_us(S->t - t0));
+	}
+}
+
+//-----------------------------------------------------------------------------
+// __sanitizer_cov_trace_pc() is called at every basic block of the firmware
+//-----------------------------------------------------------------------------
+void __sanitizer_cov_trace_pc(void){
+	int	i;
+
+	S->t += blk;
+	if((elem_t != NEVER) && !elem_flag){
+		smp_add(ST_LATE, t_us(S->t - elem_t));			// element edge taken by main()
+		elem_t = NEVER;
+	}
+	if(S->t >= nxt) sim_events();
+	for(i = 0; i < NGRP; i++){
+		grp_sync(grps[i]);
+	}
+	sfr_chk();
+	if(PCON & 0x01){
+		// idle: run the clock to the next event until an intr wakes the CPU
+		while(irq_sel() < 0){
+			S->t = nxt;
+			sim_events();
+		}
+		PCON &= ~0x01;
+	}
+	irq();
+}
+
+//-----------------------------------------------------------------------------
+// boot() sets the reset state of the MCU (in the child)
+//-----------------------------------------------------------------------------
+void boot(void){
+	int	i;
+	U32	r;
+
+	for(i = 0; i < NGRP; i++){
+		grps[i]->lat = 0;
+		grps[i]->ext = 0xff;
+	}
+	g_p0.lat = 0xff;
+	g_p1.lat = 0xff;
+	g_p0.ext = (S->ptt ? 0xf7 : 0xff) & (S->locked == LOCK_PIN ? 0xff : 0xfd);
+	g_p1.ext = 0xf0 | (~S->fsel & 0x0f);
+	for(i = 0; i < NGRP; i++){
+		grp_out(grps[i]);
+	}
+	p1_out = g_p1.lat & 0xf0;
+	OSCICN = OSC_RST;
+	osc_sh = OSCICN;
+	sdiv = 1 << (7 - (OSCICN & 7));
+	blk = BLK_CYC * sdiv;
+	PCA0MD = WDTE;									// WDT is on out of reset
+	pcamd_sh = PCA0MD;
+	PCA0CPH2 = WDT_SENT;
+	rst_rd = rs_flag[S->rst];
+	RSTSRC = rst_rd;
+	SP = 0x07;
+	pca_t = S->t;
+	pca_c = 0;
+	t2_nxt = NEVER;
+	t0_nxt = NEVER;
+	elem_t = NEVER;
+	tx_nxt = NEVER;
+	wdt_nxt = S->t + wdt_per();
+	rt_nxt = (pty_fd >= 0) ? S->t : NEVER;
+	tr0_sh = 0;
+	tr2_sh = 0;
+	lvl = -1;
+	if((S->rst == RS_POR) || (__stop_noinit - __start_noinit > (long)sizeof(S->noinit))){
+		for(i = 0; i < __stop_noinit - __start_noinit; i++){
+			S->seed = S->seed * 1103515245 + 12345;		// power-on RAM is random
+			r = S->seed >> 16;
+			__start_noinit[i] = (U8)r;
+		}
+	}else{
+		memcpy(__start_noinit, S->noinit, __stop_noinit - __start_noinit);
+	}
+	S->rst_rf = 1;
+	trc("BOOT %s (RSTSRC %02X)", rs_name[S->rst], rst_rd);
+	sched();
+}
+
+//-----------------------------------------------------------------------------
+// sim_reset() ends this boot.  The parent starts the next one.
+//-----------------------------------------------------------------------------
+void sim_reset(int src){
+
+	trc("RESET %s", rs_name[src]);
+	S->rst = src;
+	S->n_rst[src]++;
+	S->rst_t = S->t;
+	memcpy(S->noinit, __start_noinit, __stop_noinit - __start_noinit);
+	if((src == RS_POR) || (src == RS_BOD)){
+		memset(S->reg, 0, sizeof(S->reg));				// the PLL browns out too
+		S->reg[2] = R2_PD;
+		S->reg[4] = VCO_DISAB;
+		S->lk_nxt = NEVER;
+		pll_lock_set(0);
+		rf_upd();
+		S->t += us_t(POR_US);
+	}else{
+		S->t += us_t(RST_US);
+	}
+	fflush(NULL);
+	_exit(EX_RESET);
+}
+
+void sim_done(void){
+
+	trc("END");
+	fflush(NULL);
+	_exit(EX_DONE);
+}
+
+//-----------------------------------------------------------------------------
+// flash_init() builds the FLASH image: channels.c and cwconst.c at their
+//	linker addresses (CHAN_ADDR, SECTCW_ADDR), the rest erased
+//-----------------------------------------------------------------------------
+void flash_init(void){
+	int	i;
+
+	memset(S->flash, 0xff, FLASH_SIZE);
+	memcpy(S->flash + CHAN_ADDR, pll_ch_array, NUM_CHAN * 6 * sizeof(U32));
+	for(i = 0; (SECTCW_ADDR + i) < FLASH_END; i++){
+		S->flash[SECTCW_ADDR + i] = cw_img[i];
+		if((i > MSG_IDX) && (cw_img[i - 1] == CW_STOP) && (cw_img[i] == CW_EOM)) break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// scenario file.  unesc() resolves the \ escapes (\xNN may be 00), returns the length.
+//-----------------------------------------------------------------------------
+int unesc(char* d, const char* s){
+	char*	d0 = d;
+	int	c;
+
+	while(*s && (*s != '\n') && (*s != '\r')){
+		if(*s == '\\'){
+			s++;
+			switch(*s){
+				case 'r': c = '\r'; break;
+				case 'n': c = '\n'; break;
+				case 'e': c = 0x1b; break;
+				case 'x': c = (int)strtol(s + 1, (char**)&s, 16); s--; break;
+				case '\0': c = '\\'; s--; break;
+				default: c = *s; break;
+			}
+			*d++ = (char)c;
+			s++;
+		}else{
+			*d++ = *s++;
+		}
+	}
+	*d = '\0';
+	return d - d0;
+}
+
+int sc_err(const char* name, int ln, const char* msg){
+
+	fprintf(stderr, "%s:%d: %s\n", name, ln, msg);
+	return 1;
+}
+
+int sc_load(const char* name){
+	FILE*	f;
+	char	b[MAX_LINE];
+	char	cmd[32];
+	char	arg[MAX_LINE];
+	char*	p;
+	int		ln = 0;
+	int		i, n;
+	unsigned	a, v;
+	double	t;
+	struct ev*	e;
+	struct lim*	l;
+
+	f = fopen(name, "r");
+	if(!f){
+		perror(name);
+		return 1;
+	}
+	S->lk_base = LK_BASE;
+	S->lk_mhz = LK_MHZ;
+	S->lk_vco = LK_VCO;
+	while(fgets(b, sizeof(b), f)){
+		ln++;
+		for(p = b; isspace((U8)*p); p++);
+		if((*p == '#') || (*p == '\0')) continue;
+		if(isdigit((U8)*p)){
+			// timed event
+			if((S->nev == MAX_EV) || (sscanf(p, "%lf %31s%n", &t, cmd, &n) < 2)){
+				return sc_err(name, ln, "bad event");
+			}
+			e = &S->ev[S->nev++];
+			e->t = us_t(t * 1000);
+			if((S->nev > 1) && (e->t < e[-1].t)) return sc_err(name, ln, "events out of order");
+			for(p += n; (*p == ' ') || (*p == '\t'); p++);
+			if(!strcmp(cmd, "tx")){
+				e->type = EV_TX;
+				e->n = unesc(e->txt, p);
+			}else if(!strcmp(cmd, "ptt")){
+				e->type = EV_PTT;
+				e->a = atof(p);
+			}else if(!strcmp(cmd, "fsel")){
+				e->type = EV_FSEL;
+				e->a = atof(p);
+			}else if(!strcmp(cmd, "reset")){
+				e->type = EV_RESET;
+				sscanf(p, "%31s", arg);
+				for(i = 0; (i < RS_N) && strcmp(arg, rs_name[i]); i++);
+				if((i == RS_N) || (i == RS_FLE)) return sc_err(name, ln, "reset por|bod|pin|wdt|sw");
+				e->a = i;
+			}else if(!strcmp(cmd, "unlock")){
+				e->type = EV_UNLOCK;
+			}else if(!strcmp(cmd, "lockdly")){
+				e->type = EV_LOCKDLY;
+				if(sscanf(p, "%lf %lf %lf", &e->a, &e->b, &e->c) != 3) return sc_err(name, ln, "lockdly base_us us_per_MHz vco_us");
+			}else if(!strcmp(cmd, "gap")){
+				e->type = EV_GAP;
+				if(sscanf(p, "%lf", &e->a) != 1) return sc_err(name, ln, "gap ms");
+			}else if(!strcmp(cmd, "stats")){
+				e->type = EV_STATS;
+			}else if(!strcmp(cmd, "end")){
+				e->type = EV_END;
+				if(S->t_end == NEVER) S->t_end = e->t;
+			}else{
+				return sc_err(name, ln, "unknown event");
+			}
+			continue;
+		}
+		// setup
+		if(sscanf(p, "%31s%n", cmd, &n) != 1) continue;
+		p += n;
+		if(!strcmp(cmd, "flash")){
+			if(sscanf(p, "%x%n", &a, &n) != 1) return sc_err(name, ln, "flash addr bytes..");
+			for(p += n; sscanf(p, "%x%n", &v, &n) == 1; p += n){
+				if(a >= FLASH_SIZE) return sc_err(name, ln, "flash addr");
+				S->flash[a++] = (U8)v;
+			}
+		}else if(!strcmp(cmd, "baud")){
+			S->baud = atof(p);
+			if(S->baud <= 0) return sc_err(name, ln, "baud rate");
+		}else if(!strcmp(cmd, "unit")){
+			S->unit_us = atof(p) * 1000;
+		}else if(!strcmp(cmd, "lockdly")){
+			if(sscanf(p, "%lf %lf %lf", &S->lk_base, &S->lk_mhz, &S->lk_vco) != 3) return sc_err(name, ln, "lockdly base_us us_per_MHz vco_us");
+		}else if(!strcmp(cmd, "limit")){
+			if(S->nlim == MAX_LIM) return sc_err(name, ln, "too many limits");
+			l = &S->lim[S->nlim++];
+			if(sscanf(p, "%31s%n", l->name, &n) != 1) return sc_err(name, ln, "limit name <=|>= value");
+			p += n;
+			if(!strcmp(l->name, "uart") || !strcmp(l->name, "count")){
+				// limit uart|count "text" <= value
+				p = strchr(p, '"');
+				if(!p || !strchr(p + 1, '"')) return sc_err(name, ln, "limit uart|count \"text\" <=|>= value");
+				n = strchr(p + 1, '"') - (p + 1);
+				if(n >= EV_TXT) n = EV_TXT - 1;
+				memcpy(arg, p + 1, n);
+				arg[n] = '\0';
+				unesc(l->pfx, arg);
+				p = strchr(p + 1, '"') + 1;
+			}
+			if(sscanf(p, "%31s %lf", cmd, &l->v) != 2) return sc_err(name, ln, "limit name <=|>= value");
+			if(!strcmp(cmd, ">=")) l->ge = 1;
+			else if(strcmp(cmd, "<=")) return sc_err(name, ln, "limit name <=|>= value");
+		}else{
+			return sc_err(name, ln, "unknown setup cmd");
+		}
+	}
+	fclose(f);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// report() prints the stats and checks the limits.  Returns # failed limits.
+//-----------------------------------------------------------------------------
+int dcmp(const void* a, const void* b){
+	double	x = *(const double*)a, y = *(const double*)b;
+
+	return (x > y) - (x < y);
+}
+
+// abs mean, p99, and max of a stat
+void st_calc(int k, double* mean, double* p99, double* max){
+	struct smp*	s = &S->smp[k];
+	static double	v[MAX_SMP];
+	double	sum = 0;
+	int		i;
+
+	*mean = *p99 = *max = 0;
+	if(s->n == 0) return;
+	for(i = 0; i < s->n; i++){
+		v[i] = fabs(s->v[i]);
+		sum += v[i];
+	}
+	qsort(v, s->n, sizeof(double), dcmp);
+	*mean = sum / s->n;
+	*p99 = v[(int)((s->n - 1) * 0.99 + 0.5)];
+	*max = v[s->n - 1];
+}
+
+double drift_ppm(void){
+
+	if((S->dn_n < 2) || (S->dn_units == 0)) return 0;
+	return ((t_us(S->dn_prev - S->dn_t0) - S->dn_skip) / (S->dn_units * S->unit_us) - 1.0) * 1e6;
+}
+
+int val(const char* name, const char* pfx, double* v){
+	char	st[32];
+	char*	p;
+	char*	q;
+	double	m[4];
+	int		k;
+
+	if(!strcmp(name, "count")){
+		// # of "pfx" in the UART output
+		S->ulog[S->ulog_n] = '\0';
+		for(*v = 0, q = S->ulog; (q = strstr(q, pfx)) != 0; q++) *v += 1;
+		return 0;
+	}
+	if(!strcmp(name, "uart")){
+		// number after the last "pfx" in the UART output
+		S->ulog[S->ulog_n] = '\0';
+		for(p = 0, q = S->ulog; (q = strstr(q, pfx)) != 0; q++) p = q;
+		if(!p) return 1;
+		*v = strtod(p + strlen(pfx), &q);
+		return q == p + strlen(pfx);
+	}
+	if(!strcmp(name, "drift_ppm")){ *v = fabs(drift_ppm()); return 0; }
+	if(!strcmp(name, "rf_early")){ *v = S->rf_early; return 0; }
+	if(!strcmp(name, "wdt")){ *v = S->n_wdt; return 0; }
+	if(!strcmp(name, "ovr")){ *v = S->n_ovr; return 0; }
+	if(!strcmp(name, "miss")){ *v = S->n_miss; return 0; }
+	if(!strcmp(name, "garble")){ *v = S->n_garble; return 0; }
+	if(!strcmp(name, "frames")){ *v = S->n_frames; return 0; }
+	if(!strcmp(name, "app")){ *v = S->n_app; return 0; }
+	for(k = 0; k < ST_N; k++){
+		snprintf(st, sizeof(st), "%s.", st_name[k]);
+		if(!strncmp(name, st, strlen(st))){
+			p = (char*)name + strlen(st);
+			m[0] = S->smp[k].n;
+			st_calc(k, &m[1], &m[2], &m[3]);
+			if(!strcmp(p, "n")) *v = m[0];
+			else if(!strcmp(p, "mean")) *v = m[1];
+			else if(!strcmp(p, "p99")) *v = m[2];
+			else if(!strcmp(p, "max")) *v = m[3];
+			else return 1;
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int report(void){
+	double	mean, p99, max, d, v;
+	struct smp*	e = &S->smp[ST_EDGE];
+	struct lim*	l;
+	int		k, i;
+	int		fail = 0;
+
+	// jitter: edge error less the mean rate error
+	d = drift_ppm() * 1e-6;
+	for(i = 0; i < e->n; i++){
+		S->smp[ST_JIT].v[i] = e->v[i] - (S->jit_nu[i] * S->unit_us * d);
+	}
+	S->smp[ST_JIT].n = e->n;
+	if(!quiet){
+		printf("sim: %.3f s, %d PLL frames, resets por %d bod %d pin %d wdt %d sw %d fle %d\n", t_us(S->t) / 1e6,
+			S->n_frames, S->n_rst[RS_POR], S->n_rst[RS_BOD], S->n_rst[RS_PIN], S->n_rst[RS_WDT], S->n_rst[RS_SW], S->n_rst[RS_FLE]);
+		printf("%-8s %6s %12s %12s %12s  (us)\n", "stat", "n", "mean", "p99", "max");
+		for(k = 0; k < ST_N; k++){
+			if(S->smp[k].n == 0) continue;
+			st_calc(k, &mean, &p99, &max);
+			printf("%-8s %6d %12.1f %12.1f %12.1f\n", st_name[k], S->smp[k].n, mean, p99, max);
+		}
+		if(S->dn_n > 1){
+			printf("key-down edges %d over %.0f units of %.0f us, rate error %+.1f ppm\n", S->dn_n, S->dn_units, S->unit_us, drift_ppm());
+		}
+		printf("rf_early %.1f us  wdt %d  ovr %d  garble %d  miss %d\n", S->rf_early, S->n_wdt, S->n_ovr, S->n_garble, S->n_miss);
+		if(S->n_app) printf("app starts %d\n", S->n_app);
+	}
+	for(i = 0; i < S->nlim; i++){
+		l = &S->lim[i];
+		if(val(l->name, l->pfx, &v)){
+			if(!quiet) printf("limit %s%s%s: no value  FAIL\n", l->name, l->pfx[0] ? " " : "", l->pfx);
+			fail++;
+			continue;
+		}
+		k = l->ge ? (v >= l->v) : (v <= l->v);
+		if(!quiet) printf("limit %s%s%s %s %g: %g  %s\n", l->name, l->pfx[0] ? " " : "", l->pfx, l->ge ? ">=" : "<=", l->v, v, k ? "ok" : "FAIL");
+		if(!k) fail++;
+	}
+	return fail;
+}
+
+//-----------------------------------------------------------------------------
+// pty_open() opens the pty for -p and prints the slave name
+//-----------------------------------------------------------------------------
+int pty_open(void){
+	struct termios	t;
+	char*	s;
+
+	pty_fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if((pty_fd < 0) || grantpt(pty_fd) || unlockpt(pty_fd) || !(s = ptsname(pty_fd))){
+		perror("pty");
+		return 1;
+	}
+	if(tcgetattr(pty_fd, &t) == 0){
+		cfmakeraw(&t);
+		tcsetattr(pty_fd, TCSANOW, &t);
+	}
+	fcntl(pty_fd, F_SETFL, O_NONBLOCK);
+	printf("pty: %s\n", s);
+	fflush(stdout);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// main() runs one boot per child process until the scenario ends
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	char*	scen = 0;
+	double	tmax = 0;
+	pid_t	pid;
+	int		st;
+	int		i;
+
+	S = mmap(0, sizeof(struct sim), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(S == MAP_FAILED){
+		perror("mmap");
+		return 2;
+	}
+	sim_flash = S->flash;
+	S->t_end = NEVER;
+	S->rx_nxt = NEVER;
+	S->lk_nxt = NEVER;
+	S->ptt_t = NEVER;
+	S->fsel_t = NEVER;
+	S->r0_t = NEVER;
+	S->unlk_t = NEVER;
+	S->lkw_t = NEVER;
+	S->early_t = NEVER;
+	S->reg[2] = R2_PD;
+	S->reg[4] = VCO_DISAB;
+	S->le = !LE_ACT;
+	S->cs = 1;
+	S->seed = 1;
+	S->baud = HOST_BAUD;
+	flash_init();
+	for(i = 1; i < argc; i++){
+		if((argv[i][0] != '-') || !argv[i][1]){
+			scen = argv[i];
+			continue;
+		}
+		switch(argv[i][1]){
+			case 't':
+			case 'g':
+			case 'u':
+				if(i + 1 == argc) break;
+				if(!(argv[i][1] == 't' ? (trc_f = fopen(argv[i + 1], "w")) : argv[i][1] == 'g' ?
+				   (spi_f = fopen(argv[i + 1], "w")) : (uart_f = fopen(argv[i + 1], "w")))){
+					perror(argv[i + 1]);
+					return 2;
+				}
+				i++;
+				continue;
+
+			case 'T':
+				if(i + 1 == argc) break;
+				tmax = atof(argv[++i]);
+				continue;
+
+			case 'p':
+				if(pty_open()) return 2;
+				continue;
+
+			case 'q':
+				quiet = 1;
+				continue;
+		}
+		scen = 0;
+		break;
+	}
+	if(!scen){
+		fprintf(stderr, "usage: sim [-t trace] [-g spitrace] [-u uart] [-p] [-T sec] [-q] scenario\n");
+		return 2;
+	}
+	if(sc_load(scen)) return 2;
+	if(tmax > 0) S->t_end = us_t(tmax * 1e6);
+	if((S->t_end == NEVER) && (pty_fd < 0)){
+		fprintf(stderr, "%s: no \"end\" (or -T)\n", scen);
+		return 2;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &wall0);
+	S->rst = RS_POR;
+	S->n_rst[RS_POR] = 1;
+	S->t = us_t(POR_US);
+	for(;;){
+		fflush(NULL);
+		pid = fork();
+		if(pid < 0){
+			perror("fork");
+			return 2;
+		}
+		if(pid == 0){
+			boot();
+			fw_main();
+			_exit(EX_DONE);
+		}
+		if(waitpid(pid, &st, 0) < 0){
+			perror("waitpid");
+			return 2;
+		}
+		if(WIFEXITED(st) && (WEXITSTATUS(st) == EX_RESET)) continue;
+		if(WIFEXITED(st) && (WEXITSTATUS(st) == EX_DONE)) break;
+		fprintf(stderr, "sim: firmware crashed at %.1f us (status %x)\n", t_us(S->t), st);
+		return 2;
+	}
+	return report() ? 1 : 0;
+}
@@ -0,0 +1,124 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: trdiff.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Compares two SPI frame traces (sim -g).  Each line is "t_us PLL Rn hhhhhhhh",
+ *				"t_us DAC hhhhhh", or "t_us KEY n".  The frames must match in content and
+ *				order, and each frame time must be within the tolerance of the golden trace.  A
+ *				change to the register values or to the order of the writes is a
+ *				diff, a few us of code timing is not.
+ *
+ *  Build:     make -C sim (or cc -O2 -o trdiff trdiff.c)
+ *  Usage:     trdiff [-a us] [-n max] golden run
+ *				-a us	time tolerance (default 50 us)
+ *				-n max	stop after max diffs (default 20)
+ *				exit 0 = same, 1 = differs, 2 = error
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	MAX_LINE	128
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+struct frm {
+	double	t;
+	char	txt[MAX_LINE];				// "PLL R0 00ABCDEF"
+	int		ln;
+};
+
+//-----------------------------------------------------------------------------
+// rd() reads the next frame.  Returns 0 at EOF.
+//-----------------------------------------------------------------------------
+int rd(FILE* f, struct frm* r){
+	char	b[MAX_LINE];
+	int		n;
+
+	while(fgets(b, sizeof(b), f)){
+		r->ln++;
+		if(sscanf(b, "%lf %n", &r->t, &n) != 1) continue;
+		strncpy(r->txt, b + n, MAX_LINE - 1);
+		r->txt[strcspn(r->txt, "\r\n")] = '\0';
+		return 1;
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// main()
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	FILE*	fg;
+	FILE*	fr;
+	struct frm	g = { 0 }, r = { 0 };
+	double	tol = 50;
+	double	dt;
+	double	dmax = 0;
+	int		max = 20;
+	int		i, eg, er;
+	int		n = 0;
+	int		nd = 0;
+
+	for(i = 1; (i < argc - 2) && (argv[i][0] == '-'); i++){
+		if(!strcmp(argv[i], "-a")) tol = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-n")) max = atoi(argv[++i]);
+		else break;
+	}
+	if(i != argc - 2){
+		fprintf(stderr, "usage: trdiff [-a us] [-n max] golden run\n");
+		return 2;
+	}
+	fg = fopen(argv[i], "r");
+	fr = fopen(argv[i + 1], "r");
+	if(!fg || !fr){
+		perror(fg ? argv[i + 1] : argv[i]);
+		return 2;
+	}
+	for(;;){
+		eg = !rd(fg, &g);
+		er = !rd(fr, &r);
+		if(eg || er){
+			if(eg != er){
+				printf("%s ends first (golden line %d, run line %d)\n", eg ? "golden" : "run", g.ln, r.ln);
+				nd++;
+			}
+			break;
+		}
+		n++;
+		dt = r.t - g.t;
+		if(fabs(dt) > fabs(dmax)) dmax = dt;
+		if(strcmp(g.txt, r.txt)){
+			printf("frame %d: golden %12.1f %s\n", n, g.t, g.txt);
+			printf("frame %d: run    %12.1f %s\n", n, r.t, r.txt);
+			nd++;
+		}else if(fabs(dt) > tol){
+			printf("frame %d: %s at %.1f us, golden %.1f us (%+.1f us)\n", n, r.txt, r.t, g.t, dt);
+			nd++;
+		}
+		if(nd >= max){
+			printf("..\n");
+			break;
+		}
+	}
+	printf("%d frames, %d diffs, max time diff %+.1f us (tol %.1f us)\n", n, nd, dmax, tol);
+	return nd ? 1 : 0;
+}
@@ -0,0 +1,442 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: bootld.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Orion beacon firmware update over the UART bootloader (boot.c).
+ *				Reads the app Intel HEX (built with BOOT_EN = 1, linked at APP_ADDR),
+ *				and writes <app>_bl.hex: the app plus its length/CRC record at APP_INFO,
+ *				to load with C2 alongside boot.hex.  With a port it also sends "XB" to
+ *				the running app (9600 baud), then the image to the bootloader at 115.2
+ *				kbaud in BL_BLK byte blocks (one ACK per block), and reports the erase,
+ *				transfer, and total update time.  Channel/msg data in the HEX (channels.c,
+ *				cwconst.c) is not sent, the bootloader keeps those sectors.
+ *
+ *  Build:     cc -O2 -I.. -o bootld bootld.c
+ *  Usage:     bootld app.hex [port]
+ *             bootld -S app.hex		test the update against a simulated bootloader
+ *										on a pseudo-terminal
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#define	_XOPEN_SOURCE	600
+#define	_DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	SECTOR_SIZE	512				// flash.h (boot.h needs SECTCH_ADDR)
+#define	SECTCH_ADDR	0x1600
+#include "boot.h"
+
+#define	FLASH_SIZE	0x2000
+#define	MAX_LINE	600
+#define	ESC			0x1b
+#define	SIM_SECT_MS	20				// sim sector erase
+#define	SIM_WR_US	40				// sim byte write
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+unsigned char	img[FLASH_SIZE];
+int		len;						// app image length (from APP_ADDR)
+unsigned int	crc;
+int		skipped;					// # bytes at/above SECTCH_ADDR (not sent)
+
+//-----------------------------------------------------------------------------
+// now() returns the monotonic time (s)
+//-----------------------------------------------------------------------------
+double now(void){
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+//-----------------------------------------------------------------------------
+// calcrc() is the firmware CRC16 (xmodem poly 0x1021)
+//-----------------------------------------------------------------------------
+unsigned int calcrc(unsigned char c, unsigned int crc){
+	int	i;
+
+	crc ^= (unsigned int)c << 8;
+	for(i = 0; i < 8; i++){
+		crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+	}
+	return crc & 0xffff;
+}
+
+//-----------------------------------------------------------------------------
+// read_hex() loads the app HEX into img[].  returns 0 if OK
+//-----------------------------------------------------------------------------
+int read_hex(const char* name){
+	FILE*	f;
+	char	line[MAX_LINE];
+	unsigned int	n, a, t, v;
+	unsigned int	sum;
+	unsigned int	i;
+	int		top = 0;
+	int		ln = 0;
+	int		err = 0;
+
+	f = fopen(name, "r");
+	if(!f){
+		perror(name);
+		return 1;
+	}
+	memset(img, 0xff, sizeof(img));
+	while(fgets(line, sizeof(line), f)){
+		ln++;
+		if(line[0] != ':') continue;
+		if((sscanf(line + 1, "%2x%4x%2x", &n, &a, &t) != 3) || (strlen(line) < 11 + 2 * n)){
+			fprintf(stderr, "%s:%d: bad record\n", name, ln);
+			err = 1;
+			break;
+		}
+		sum = n + (a >> 8) + a + t;
+		for(i = 0; i <= n; i++){
+			sscanf(line + 9 + 2 * i, "%2x", &v);
+			sum += v;
+			if((i < n) && (t == 0)){
+				if(a + i < APP_ADDR){
+					fprintf(stderr, "%s:%d: data below 0x%04X, app not linked for the bootloader (BOOT_EN = 1)\n",
+						name, ln, APP_ADDR);
+					err = 1;
+				}else if(a + i >= SECTCH_ADDR){
+					skipped++;						// channel/msg data
+				}else if(a + i >= APP_INFO){
+					fprintf(stderr, "%s:%d: app overlaps APP_INFO (0x%04X)\n", name, ln, APP_INFO);
+					err = 1;
+				}else{
+					img[a + i] = (unsigned char)v;
+					if((int)(a + i) >= top) top = a + i + 1;
+				}
+			}
+		}
+		if(sum & 0xff){
+			fprintf(stderr, "%s:%d: checksum\n", name, ln);
+			err = 1;
+		}
+		if(((t == 2) || (t == 4)) && strncmp(line + 9, "0000", 4)){
+			fprintf(stderr, "%s:%d: address above 64K\n", name, ln);
+			err = 1;
+		}
+		if(err || (t == 1)) break;
+	}
+	fclose(f);
+	len = (top > APP_ADDR) ? top - APP_ADDR : 0;
+	if(!err && !len){
+		fprintf(stderr, "%s: no app data\n", name);
+		err = 1;
+	}
+	crc = 0;
+	for(i = 0; (int)i < len; i++){
+		crc = calcrc(img[APP_ADDR + i], crc);
+	}
+	return err;
+}
+
+//-----------------------------------------------------------------------------
+// hex_rec() writes one Intel HEX record
+//-----------------------------------------------------------------------------
+void hex_rec(FILE* f, int n, unsigned int a, int t, const unsigned char* d){
+	unsigned int	sum;
+	int		i;
+
+	sum = n + (a >> 8) + a + t;
+	fprintf(f, ":%02X%04X%02X", n, a & 0xffff, t);
+	for(i = 0; i < n; i++){
+		fprintf(f, "%02X", d[i]);
+		sum += d[i];
+	}
+	fprintf(f, "%02X\n", (0x100 - (sum & 0xff)) & 0xff);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// write_hex() writes <app>_bl.hex (app + APP_INFO)
+//-----------------------------------------------------------------------------
+int write_hex(const char* src){
+	char	name[MAX_LINE];
+	char*	p;
+	FILE*	f;
+	unsigned char	info[4];
+	int		i;
+
+	snprintf(name, sizeof(name) - 8, "%s", src);
+	p = strrchr(name, '.');
+	if(p && !strchr(p, '/')) *p = '\0';
+	strcat(name, "_bl.hex");
+	f = fopen(name, "w");
+	if(!f){
+		perror(name);
+		return 1;
+	}
+	for(i = 0; i < len; i += 16){
+		hex_rec(f, (len - i < 16) ? len - i : 16, APP_ADDR + i, 0, img + APP_ADDR + i);
+	}
+	info[0] = (unsigned char)(len >> 8);
+	info[1] = (unsigned char)len;
+	info[2] = (unsigned char)(crc >> 8);
+	info[3] = (unsigned char)crc;
+	hex_rec(f, 4, APP_INFO, 0, info);
+	hex_rec(f, 0, 0, 1, info);
+	fclose(f);
+	printf("%s\n", name);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// port_open() opens a port raw, 8N1
+//-----------------------------------------------------------------------------
+int port_open(const char* name, speed_t sp){
+	int				fd;
+	struct termios	t;
+
+	fd = open(name, O_RDWR | O_NOCTTY);
+	if(fd < 0){
+		perror(name);
+		return -1;
+	}
+	if(tcgetattr(fd, &t) == 0){
+		cfmakeraw(&t);
+		t.c_cflag |= CLOCAL | CREAD;
+		t.c_cflag &= ~(CSTOPB | CRTSCTS);
+		cfsetispeed(&t, sp);
+		cfsetospeed(&t, sp);
+		tcsetattr(fd, TCSANOW, &t);
+	}
+	tcflush(fd, TCIOFLUSH);
+	return fd;
+}
+
+//-----------------------------------------------------------------------------
+// wait_for() reads until s shows up or ms passes.  returns 1 if found.  With
+//	s = NULL, returns the 1st chr read (0 on timeout).
+//-----------------------------------------------------------------------------
+int wait_for(int fd, const char* s, long ms){
+	struct pollfd	p;
+	char	r[256];
+	double	tend;
+	int		n = 0;
+	int		k;
+
+	tend = now() + ms / 1000.0;
+	p.fd = fd;
+	p.events = POLLIN;
+	for(;;){
+		k = (int)((tend - now()) * 1000.0);
+		if((k <= 0) || (poll(&p, 1, k) <= 0)) return 0;
+		if(n >= (int)sizeof(r) - 1) n = 0;
+		k = read(fd, r + n, s ? (int)sizeof(r) - 1 - n : 1);
+		if(k <= 0) return 0;
+		if(!s) return (unsigned char)r[0];
+		n += k;
+		r[n] = '\0';
+		if(strstr(r, s)) return 1;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// update() sends "XB", then the image.  returns 0 if the bootloader answers BL_OK
+//-----------------------------------------------------------------------------
+int update(const char* port){
+	unsigned char	b[4];
+	double	t0, te, tx;
+	int		fd;
+	int		i, n, c;
+
+	fd = port_open(port, B9600);
+	if(fd < 0) return 1;
+	if(write(fd, "\x1b\rXB\r", 5) != 5) return 1;
+	if(!wait_for(fd, "boot", 2000)){
+		printf("%s: no \"XB\" answer (app not built with BOOT_EN = 1, or already in the bootloader)\n", port);
+	}
+	close(fd);
+	fd = port_open(port, B115200);
+	if(fd < 0) return 1;
+	wait_for(fd, "BL", 1000);					// banner (missed if already in the bootloader)
+	t0 = now();
+	b[0] = BL_SYNC;
+	b[1] = (unsigned char)(len >> 8);
+	b[2] = (unsigned char)len;
+	if(write(fd, b, 3) != 3) return 1;
+	c = wait_for(fd, NULL, 5000);
+	if(c != BL_ACK){
+		printf("%s: erase failed (%s)\n", port, c ? "BL_FAIL" : "no answer");
+		close(fd);
+		return 1;
+	}
+	te = now();
+	for(i = 0; i < len; i += n){
+		n = (len - i < BL_BLK) ? len - i : BL_BLK;
+		if(write(fd, img + APP_ADDR + i, n) != n) return 1;
+		c = wait_for(fd, NULL, 2000);
+		if(c != BL_ACK){
+			printf("%s: block @0x%04X failed (%s)\n", port, APP_ADDR + i, c ? "BL_FAIL" : "no answer");
+			close(fd);
+			return 1;
+		}
+	}
+	tx = now();
+	b[0] = (unsigned char)(crc >> 8);
+	b[1] = (unsigned char)crc;
+	if(write(fd, b, 2) != 2) return 1;
+	c = wait_for(fd, NULL, 2000);
+	close(fd);
+	printf("%s: %s, erase %.0f ms, %d bytes in %.0f ms (%.0f B/s, wire %.0f ms), total %.2f s\n", port,
+		(c == BL_OK) ? "OK" : "FAIL (stays in the bootloader)", (te - t0) * 1000.0, len, (tx - te) * 1000.0,
+		len / (tx - te), len * 10000.0 / BOOT_BAUD, now() - t0);
+	return (c == BL_OK) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// sim() is a simulated app ("XB") and bootloader on pty master fd.  Wire time at
+//	BOOT_BAUD, sector erase, and byte write times are modeled.
+//-----------------------------------------------------------------------------
+void sim(int fd){
+	unsigned char	fl[FLASH_SIZE];
+	unsigned char	c;
+	unsigned int	n, i, k, cr, hc;
+	char	ln[8];
+	int		m = 0;
+
+	memset(fl, 0x5a, sizeof(fl));
+	for(;;){											// app CLI: wait for "XB"
+		if(read(fd, &c, 1) != 1) exit(0);
+		if(c == ESC){
+			m = 0;
+			continue;
+		}
+		if(c != '\r'){
+			if(m < (int)sizeof(ln) - 1) ln[m++] = c;
+			continue;
+		}
+		ln[m] = '\0';
+		m = 0;
+		if(!strcmp(ln, "XB")) break;
+		if(write(fd, "\r\nbkn>", 6) != 6) exit(0);
+	}
+	if(write(fd, "X\r\nboot\r\n", 9) != 9) exit(0);
+	usleep(20000);
+	if(write(fd, "BL\r\n", 4) != 4) exit(0);
+	for(;;){
+		do{
+			if(read(fd, &c, 1) != 1) exit(0);
+		}while(c != BL_SYNC);
+		if((read(fd, &c, 1) != 1)) exit(0);
+		n = c << 8;
+		if((read(fd, &c, 1) != 1)) exit(0);
+		n |= c;
+		if(!n || (n > APP_MAX)){
+			c = BL_FAIL;
+			if(write(fd, &c, 1) != 1) exit(0);
+			continue;
+		}
+		for(i = APP_ADDR; i < SECTCH_ADDR; i += SECTOR_SIZE){
+			usleep(SIM_SECT_MS * 1000);
+			memset(fl + i, 0xff, SECTOR_SIZE);
+		}
+		c = BL_ACK;
+		if(write(fd, &c, 1) != 1) exit(0);
+		cr = 0;
+		for(i = 0; i < n; i++){
+			if(read(fd, &c, 1) != 1) exit(0);
+			fl[APP_ADDR + i] &= c;
+			cr = calcrc(c, cr);
+			if(((i & (BL_BLK - 1)) == (BL_BLK - 1)) || (i == n - 1)){
+				k = (i & (BL_BLK - 1)) + 1;				// block size
+				usleep(k * 10000000L / BOOT_BAUD + k * SIM_WR_US);
+				c = BL_ACK;
+				if(write(fd, &c, 1) != 1) exit(0);
+			}
+		}
+		if((read(fd, &c, 1) != 1)) exit(0);
+		hc = c << 8;
+		if((read(fd, &c, 1) != 1)) exit(0);
+		hc |= c;
+		k = 0;
+		for(i = 0; i < n; i++) k = calcrc(fl[APP_ADDR + i], k);
+		c = ((hc == cr) && (k == cr)) ? BL_OK : BL_FAIL;
+		if(write(fd, &c, 1) != 1) exit(0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// main()
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	int		i = 1;
+	int		sm = 0;
+	int		m, rc;
+	char*	port = NULL;
+	pid_t	pid = 0;
+	struct termios	t;
+
+	if((argc > 1) && !strcmp(argv[1], "-S")){
+		sm = 1;
+		i = 2;
+	}
+	if(i >= argc){
+		fprintf(stderr, "usage: bootld app.hex [port]\n       bootld -S app.hex\n");
+		return 2;
+	}
+	if(read_hex(argv[i]) || write_hex(argv[i])){
+		return 1;
+	}
+	printf("app: %d bytes, CRC16 %04X, %d bytes free%s\n", len, crc, APP_MAX - len,
+		skipped ? ", channel/msg data in the HEX not sent" : "");
+	if(i + 1 < argc){
+		port = argv[i + 1];
+	}
+	if(sm){
+		m = posix_openpt(O_RDWR | O_NOCTTY);
+		if((m < 0) || grantpt(m) || unlockpt(m) || !(port = ptsname(m))){
+			perror("pty");
+			return 2;
+		}
+		port = strdup(port);
+		if(tcgetattr(m, &t) == 0){
+			cfmakeraw(&t);
+			tcsetattr(m, TCSANOW, &t);
+		}
+		pid = fork();
+		if(pid == 0){
+			sim(m);
+			exit(0);
+		}
+		close(m);
+		m = open(port, O_RDWR | O_NOCTTY);			// hold the slave open across the baud change
+	}
+	if(!port){
+		return 0;
+	}
+	rc = update(port);
+	if(pid > 0){
+		kill(pid, SIGTERM);
+		waitpid(pid, NULL, 0);
+	}
+	return rc;
+}
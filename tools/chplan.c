@@ -0,0 +1,537 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: chplan.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Orion beacon channel plan compiler.  Builds the ADF4351 register set for
+ *				each channel in a plan file with the firmware's own calculator (adfcalc.c),
+ *				searching the R counter, doubler, and ref div2 (R2) for an exact frequency.
+ *				A set only counts as exact if it also passes the "FV" check (adf_freq(),
+ *				then adf_calc() gives back the same words), so "FV" passes on every
+ *				channel that is not reported "not exact".  Channels in the same hop group get a
+ *				common R2, picked to maximise the # of channel pairs that share R2-R5
+ *				(the firmware hops those with R1/R0 only, no full load or relock wait
+ *				for the band select).  Writes:
+ *					<plan>.c	pll_ch_array[] entries (channels.c format)
+ *					<plan>.cmd	upload script: "EC", "Y", "Mnn .." lines, "z hhhh"
+ *					<plan>.hex	Intel HEX image of the channel array (CHAN_ADDR)
+ *
+ *  Build:     cc -O2 -I.. -o chplan chplan.c ../adfcalc.c
+ *				(typedef.h gives the host a 32 bit U32, so the calculator wraps as on the target)
+ *				(add -DREF_FREQ=n, 10 Hz units, for a unit built with another ref osc)
+ *  Usage:     chplan [-j n] plan [plan ..]
+ *				-j n = compile n plans at a time (one process per plan)
+ *
+ *	Plan format (one item per line, '#' starts a comment):
+ *		ref f.f			ref osc (MHz), must match REF_FREQ (the firmware calculator)
+ *		nchan n			# channels in the build (NUM_CHAN, default 16)
+ *		pfdmax f.f		max PFD searched (MHz, default 32)
+ *		template r0 r1 r2 r3 r4 r5
+ *						register template (hex, default ch 00 of channels.c).  R2, R3, R5,
+ *						and the R1/R4 control bits come from here.
+ *		ch nn f.f p [g]	channel nn at f MHz, p = output power (-4, -1, 2, 5 dBm),
+ *						g = hop group name (optional)
+ *	An ungrouped channel uses the template R2 if that is exact, else the exact R2
+ *	with the highest PFD.
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "typedef.h"
+#include "adfcalc.h"
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	SECTCH_ADDR	0x1600			// channel sector (flash.h)
+#define	CHAN_ADDR	(SECTCH_ADDR + 0x80)
+#define	MAX_CHAN	100
+#define	MAX_LINE	256
+
+#define	R2_DBL		0x02000000L		// R2 bit 25: reference doubler
+#define	R2_RDIV2	0x01000000L		// R2 bit 24: reference div by 2
+#define	R2_RMSK		0x00ffc000L		// R2 R counter [23:14]
+#define	R4_PWRMSK	0x00000018L		// R4 output power [4:3]
+#define	INT_MAX		65535			// ADF4351 INT field
+#define	NO_CH		0xffffffffL
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+U32		tmpl[6] = { 0x00A00720, 0x08009389, 0x00004E42, 0x000004B3, 0x00E5043C, 0x00580005 };
+U32		regs[MAX_CHAN][6];			// register sets
+U32		freq[MAX_CHAN];				// 10 Hz units, 0 = unused
+U8		pwr[MAX_CHAN];				// R4 power bits
+U8		stat[MAX_CHAN];				// adf_calc() status
+char	grp[MAX_CHAN][16];			// hop group ("" = none)
+int		nchan;
+U32		pfdmax;
+const char*	pname;
+
+U32 get_pfd(U32 r2);				// adfcalc.c
+int fv_chk(U32* p, U32 f);
+
+//-----------------------------------------------------------------------------
+// r2_set() returns the template R2 with R counter r, doubler d, div2 t
+//-----------------------------------------------------------------------------
+U32 r2_set(int r, int d, int t){
+	U32	r2;
+
+	r2 = tmpl[2] & ~(R2_DBL | R2_RDIV2 | R2_RMSK);
+	r2 |= (U32)r << 14;
+	if(d) r2 |= R2_DBL;
+	if(t) r2 |= R2_RDIV2;
+	return r2;
+}
+
+//-----------------------------------------------------------------------------
+// ch_calc() builds the register set for channel c with R2 = r2.  returns the
+//	adf_calc() status (ADF_INTERR if INT won't fit)
+//-----------------------------------------------------------------------------
+U8 ch_calc(int c, U32 r2, U32* p){
+	U32	pfd;
+	U32	fvco;
+	int	i;
+
+	pfd = get_pfd(r2);
+	if((pfd == 0) || (pfd > pfdmax)){
+		return ADF_RANGE;
+	}
+	fvco = freq[c];
+	while(fvco < VCO_MIN){
+		fvco <<= 1;
+	}
+	if(fvco / pfd > INT_MAX){
+		return ADF_INTERR;
+	}
+	for(i = 0; i < 6; i++){
+		p[i] = tmpl[i];
+	}
+	p[2] = r2;
+	p[4] = (p[4] & ~R4_PWRMSK) | ((U32)pwr[c] << 3);
+	i = adf_calc(freq[c], p);
+	if((i == ADF_OK) && !fv_chk(p, freq[c])){
+		i = ADF_APPROX;								// "FV" would fail on the target
+	}
+	return (U8)i;
+}
+
+//-----------------------------------------------------------------------------
+// fv_chk() is the firmware's "FV" check: returns 1 if the set at p reads back as f
+//	and re-calculates to the same words
+//-----------------------------------------------------------------------------
+int fv_chk(U32* p, U32 f){
+	U32	q[6];
+	int	i;
+
+	for(i = 0; i < 6; i++){
+		q[i] = p[i];
+	}
+	if(adf_freq(q) != f){
+		return 0;
+	}
+	if(adf_calc(f, q) != ADF_OK){
+		return 0;
+	}
+	for(i = 0; i < 6; i++){
+		if(q[i] != p[i]) return 0;
+	}
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+// same25() returns 1 if two register sets share R2-R5 (R1/R0 hop)
+//-----------------------------------------------------------------------------
+int same25(U32* a, U32* b){
+	int	i;
+
+	for(i = 2; i < 6; i++){
+		if(a[i] != b[i]) return 0;
+	}
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+// solve() picks R2 for the channels in group g (or channel c alone if g is "").
+//	Score: # of channel pairs sharing R2-R5, then the template R2, then PFD.
+//-----------------------------------------------------------------------------
+void solve(int c, const char* g){
+	int		m[MAX_CHAN];
+	int		n = 0;
+	int		i, j, k;
+	int		r, d, t;
+	int		ok;
+	long	score;
+	long	best = -1;
+	U32		r2;
+	U32		p[MAX_CHAN][6];
+
+	if(*g){
+		for(i = 0; i < nchan; i++){
+			if(freq[i] && !strcmp(grp[i], g)) m[n++] = i;
+		}
+	}else{
+		m[n++] = c;
+	}
+	for(t = 0; t < 2; t++){
+		for(d = 0; d < 2; d++){
+			for(r = 1; r < 1024; r++){
+				r2 = r2_set(r, d, t);
+				ok = 1;
+				for(i = 0; ok && (i < n); i++){
+					if(ch_calc(m[i], r2, p[i]) != ADF_OK) ok = 0;
+				}
+				if(!ok) continue;
+				score = 0;
+				for(i = 0; i < n; i++){
+					for(j = i + 1; j < n; j++){
+						score += same25(p[i], p[j]);
+					}
+				}
+				score <<= 1;
+				if(r2 == tmpl[2]) score |= 1;
+				score = (score << 22) | (long)(get_pfd(r2) / 10L);	// PFD (100 Hz) < 2^22
+				if(score > best){
+					best = score;
+					for(i = 0; i < n; i++){
+						for(k = 0; k < 6; k++) regs[m[i]][k] = p[i][k];
+						stat[m[i]] = ADF_OK;
+					}
+				}
+			}
+		}
+	}
+	if(best < 0){
+		for(i = 0; i < n; i++){
+			stat[m[i]] = ch_calc(m[i], tmpl[2], regs[m[i]]);	// no exact set, use the template PFD
+			fprintf(stderr, "%s: ch %02d %s\n", pname, m[i],
+				(stat[m[i]] == ADF_APPROX) ? "not exact (approx)" : "out of range");
+		}
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// calcrc() is the firmware CRC16 (xmodem poly 0x1021)
+//-----------------------------------------------------------------------------
+unsigned int calcrc(U8 c, unsigned int crc){
+	int	i;
+
+	crc ^= (unsigned int)c << 8;
+	for(i = 0; i < 8; i++){
+		crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+	}
+	return crc & 0xffff;
+}
+
+//-----------------------------------------------------------------------------
+// ch_bytes() returns the flash image of channel c (U32s MS byte 1st, as Keil)
+//-----------------------------------------------------------------------------
+void ch_bytes(int c, U8* b){
+	int	i;
+
+	for(i = 0; i < 24; i++){
+		b[i] = freq[c] ? (U8)(regs[c][i / 4] >> (24 - 8 * (i & 3))) : 0xff;
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// out_name() builds <plan>.<ext> (replaces the plan extension)
+//-----------------------------------------------------------------------------
+void out_name(char* buf, const char* src, const char* ext){
+	char*	p;
+
+	strcpy(buf, src);
+	p = strrchr(buf, '.');
+	if(p && !strchr(p, '/')){
+		*p = '\0';
+	}
+	strcat(buf, ".");
+	strcat(buf, ext);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// write_out() writes the .c, .cmd, and .hex files.  returns the channel CRC or -1
+//-----------------------------------------------------------------------------
+long write_out(const char* src){
+	char	buf[MAX_LINE + 8];
+	FILE*	fp;
+	U8		b[24];
+	int		c;
+	int		i;
+	unsigned int	crc = 0;
+	unsigned int	a;
+	unsigned int	sum;
+	static const char*	dbm[4] = { "-4", "-1", "+2", "+5" };
+
+	for(c = 0; c < nchan; c++){
+		ch_bytes(c, b);
+		for(i = 0; i < 24; i++) crc = calcrc(b[i], crc);
+	}
+
+	out_name(buf, src, "c");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return -1;
+	}
+	fprintf(fp, "\t\t//      R0          R1          R2          R3          R4          R5\t\t// ADF reg#s\n");
+	for(c = 0; c < nchan; c++){
+		fprintf(fp, "\t\t// Ch %02d\n\t\t", c);
+		for(i = 0; i < 6; i++){
+			fprintf(fp, "0x%08lX, ", freq[c] ? (unsigned long)regs[c][i] : (unsigned long)NO_CH);
+		}
+		if(freq[c]){
+			fprintf(fp, "\t// %lu.%05lu MHz, %s dBm, PFD %lu.%05lu MHz%s%s%s\n",
+				(unsigned long)(freq[c] / 100000L), (unsigned long)(freq[c] % 100000L), dbm[pwr[c] & 3],
+				(unsigned long)(get_pfd(regs[c][2]) / 100000L), (unsigned long)(get_pfd(regs[c][2]) % 100000L),
+				*grp[c] ? ", hop grp " : "", grp[c], (stat[c] == ADF_OK) ? "" : " (NOT EXACT)");
+		}else{
+			fprintf(fp, "\t// null channel\n");
+		}
+	}
+	fclose(fp);
+
+	out_name(buf, src, "cmd");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return -1;
+	}
+	fprintf(fp, "EC\nY\n");							// erase ch sector, confirm
+	for(c = 0; c < nchan; c++){
+		if(!freq[c]) continue;
+		ch_bytes(c, b);
+		fprintf(fp, "M%02d ", c);
+		for(i = 0; i < 24; i++) fprintf(fp, "%02X", b[i]);
+		fprintf(fp, "\n");
+	}
+	fprintf(fp, "z %04X\n", crc);
+	fclose(fp);
+
+	out_name(buf, src, "hex");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return -1;
+	}
+	for(c = 0; c < nchan; c++){
+		if(!freq[c]) continue;						// erased
+		ch_bytes(c, b);
+		a = CHAN_ADDR + 24 * c;
+		fprintf(fp, ":18%04X00", a);
+		sum = 24 + (a >> 8) + (a & 0xff);
+		for(i = 0; i < 24; i++){
+			fprintf(fp, "%02X", b[i]);
+			sum += b[i];
+		}
+		fprintf(fp, "%02X\n", (-sum) & 0xff);
+	}
+	fprintf(fp, ":00000001FF\n");
+	fclose(fp);
+	return crc;
+}
+
+//-----------------------------------------------------------------------------
+// mhz() converts "f.fffff" MHz to 10 Hz units (0 on error)
+//-----------------------------------------------------------------------------
+U32 mhz(const char* s){
+	U32	f = 0;
+	int	nf = -1;
+
+	for(; *s; s++){
+		if(*s == '.'){
+			if(nf >= 0) return 0;
+			nf = 0;
+		}else if((*s >= '0') && (*s <= '9')){
+			if(nf < 5){
+				f = f * 10 + (*s - '0');
+				if(nf >= 0) nf++;
+			}
+		}else{
+			return 0;
+		}
+	}
+	if(nf < 0) nf = 0;
+	while(nf++ < 5){
+		f *= 10;
+	}
+	return f;
+}
+
+//-----------------------------------------------------------------------------
+// plan() compiles one plan file.  returns 0 if OK
+//-----------------------------------------------------------------------------
+int plan(const char* src){
+	char	line[MAX_LINE];
+	char	w[5][32];
+	FILE*	fp;
+	int		ln = 0;
+	int		err = 0;
+	int		c;
+	int		i;
+	int		j;
+	int		n;
+	int		p;
+	int		pairs;
+	int		share;
+	long	crc;
+	unsigned long	v[6];
+
+	pname = src;
+	nchan = 16;
+	pfdmax = 3200000L;
+	memset(freq, 0, sizeof(freq));
+	memset(grp, 0, sizeof(grp));
+	if((fp = fopen(src, "r")) == NULL){
+		perror(src);
+		return 1;
+	}
+	while(fgets(line, sizeof(line), fp)){
+		ln++;
+		w[0][0] = '\0';
+		n = sscanf(line, "%31s %31s %31s %31s %31s", w[0], w[1], w[2], w[3], w[4]);
+		if((n <= 0) || (w[0][0] == '#')){
+			continue;
+		}
+		if(!strcmp(w[0], "ref") && (n == 2)){
+			if(mhz(w[1]) != REF_FREQ){
+				fprintf(stderr, "%s:%d: ref is not REF_FREQ (%ld), rebuild with -DREF_FREQ\n", src, ln, (long)REF_FREQ);
+				err++;
+			}
+		}else if(!strcmp(w[0], "nchan") && (n == 2)){
+			nchan = atoi(w[1]);
+			if((nchan < 1) || (nchan > MAX_CHAN)){
+				fprintf(stderr, "%s:%d: bad nchan\n", src, ln);
+				err++;
+				nchan = 16;
+			}
+		}else if(!strcmp(w[0], "pfdmax") && (n == 2)){
+			pfdmax = mhz(w[1]);
+		}else if(!strcmp(w[0], "template")){
+			if(sscanf(line, "%*s %lx %lx %lx %lx %lx %lx", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6){
+				fprintf(stderr, "%s:%d: template needs R0-R5\n", src, ln);
+				err++;
+			}else{
+				for(i = 0; i < 6; i++) tmpl[i] = v[i];
+			}
+		}else if(!strcmp(w[0], "ch") && (n >= 4)){
+			c = atoi(w[1]);
+			p = atoi(w[3]);
+			if((c < 0) || (c >= nchan) || freq[c]){
+				fprintf(stderr, "%s:%d: bad or repeated ch #\n", src, ln);
+				err++;
+			}else if(((freq[c] = mhz(w[2])) < RF_MIN) || (freq[c] > RF_MAX)){
+				fprintf(stderr, "%s:%d: freq out of range\n", src, ln);
+				freq[c] = 0;
+				err++;
+			}else if((p != -4) && (p != -1) && (p != 2) && (p != 5)){
+				fprintf(stderr, "%s:%d: power must be -4, -1, 2, or 5\n", src, ln);
+				freq[c] = 0;
+				err++;
+			}else{
+				pwr[c] = (p + 4) / 3;
+				if(n == 5){
+					snprintf(grp[c], sizeof(grp[c]), "%.15s", w[4]);
+				}
+			}
+		}else{
+			fprintf(stderr, "%s:%d: ?\n", src, ln);
+			err++;
+		}
+	}
+	fclose(fp);
+	if(err){
+		return 1;
+	}
+	for(c = 0; c < nchan; c++){
+		if(!freq[c]) continue;
+		for(i = 0; (i < c) && !(freq[i] && *grp[c] && !strcmp(grp[i], grp[c])); i++);
+		if(i == c){
+			solve(c, grp[c]);						// 1st ch of its group (or ungrouped)
+		}
+	}
+	if((crc = write_out(src)) < 0){
+		return 1;
+	}
+	n = 0;
+	pairs = 0;
+	share = 0;
+	for(c = 0; c < nchan; c++){
+		if(!freq[c]) continue;
+		n++;
+		if(stat[c] != ADF_OK) err++;
+		for(j = c + 1; j < nchan; j++){
+			if(freq[j] && *grp[c] && !strcmp(grp[c], grp[j])){
+				pairs++;
+				share += same25(regs[c], regs[j]);
+			}
+		}
+	}
+	printf("%s: %d ch, %d not exact, hop pairs %d, R1/R0 hops %d, CRC16 %04lX\n",
+		src, n, err, pairs, share, (unsigned long)crc);
+	fflush(stdout);
+	return err ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// main() compiles each plan, up to -j n at a time
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	int		i = 1;
+	int		nj = 1;
+	int		run = 0;
+	int		rc = 0;
+	int		st;
+	pid_t	pid;
+
+	if((argc > 2) && !strcmp(argv[1], "-j")){
+		nj = atoi(argv[2]);
+		if(nj < 1) nj = 1;
+		i = 3;
+	}
+	if(i >= argc){
+		fprintf(stderr, "usage: chplan [-j n] plan [plan ..]\n");
+		return 2;
+	}
+	for(; i < argc; i++){
+		if(nj == 1){
+			rc |= plan(argv[i]);
+			continue;
+		}
+		if(run == nj){
+			wait(&st);								// wait for a free slot
+			run--;
+			if(!WIFEXITED(st) || WEXITSTATUS(st)) rc = 1;
+		}
+		pid = fork();
+		if(pid == 0){
+			exit(plan(argv[i]));
+		}
+		if(pid < 0){
+			perror("fork");
+			rc |= plan(argv[i]);					// no process, do it here
+		}else{
+			run++;
+		}
+	}
+	while(run--){
+		wait(&st);
+		if(!WIFEXITED(st) || WEXITSTATUS(st)) rc = 1;
+	}
+	return rc;
+}
@@ -0,0 +1,592 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: msgc.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Orion beacon message compiler.  Compiles a message source file (text
+ *				plus markup) into the message sector image (diode_matrix[] at
+ *				SECTCW_ADDR), and writes:
+ *					<file>.c	diode_matrix[] initializer (cwconst.c format)
+ *					<file>.cmd	upload script: "EM", "Y", "Caaaa dd.." lines, "zm hhhh"
+ *					<file>.hex	Intel HEX image of the message sector
+ *				and reports the image size, msg CRC ("cm"), and on-air time per cycle.
+ *
+ *  Build:     cc -O2 -o msgc msgc.c
+ *  Usage:     msgc [-j n] file.msg [file.msg ..]
+ *				-j n = compile n files at a time (one process per file)
+ *
+ *	Source format (one item per line, '#' starts a comment line):
+ *		.dit ms			dit time (ms), or .wpm n (PARIS, 1200 / n ms)
+ *		.delay ms		msg pause (ms) from EOM to the msg re-start
+ *		.ramp n			keyout delay (ms) at key up (RMP_IDX)
+ *		.table n x8		DAC ramp table (RTBL_IDX, default 25 37 61 110 170 219 243 255)
+ *		.key hi|lo		keyout polarity (default lo)
+ *		.dac .fsk		mode bits in the key polarity byte
+ *		.dfcw .qrss		(QRSS: .dit/.delay are still ms, stored in QRSS_SCALE units)
+ *		.cgap n			extra gap after each chr (units, default 3: 4 unit chr gap)
+ *		.wgap n			extra gap per space (units, default 10: 14 unit word gap)
+ *		any other line	msg text.  Line breaks count as a space.  Letters, digits,
+ *						. , ? / = + - ' : ; ( ) " @ are sent, <xx..> sends the chrs run
+ *						together (prosign, e.g. <AR>).  Embedded cmds (byte aligned, one
+ *						element time each, see main.c):
+ *							]%	EOM (rest of the text is ignored)
+ *							]>	I/O + 1			]<	I/O - 1
+ *							]0-]7	set I/O bits	]8	NOP
+ *							]cx	set ch x		]+x	add x to ch		]-x	clr delta ch if > x
+ *							(x = a-p for ch 0-15, not case sensitive)
+ *	The defaults are the message spreadsheet's timing, so a source with only the
+ *	text and header fields reproduces its image (see w5afy.msg).
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	SECTCW_ADDR	0x1800			// msg sector (flash.h)
+#define	FLASH_END	0x1dfe			// 0x1dff is the lock byte
+#define	MSG_MAX		(FLASH_END - SECTCW_ADDR)
+
+#define	KEY_IDX		0				// msg header (cwconst.h)
+#define	KEY_MASK	0x01
+#define	DFCW_MASK	0x10
+#define	QRSS_MASK	0x20
+#define	DAC_MASK	0x40
+#define	FSK_MASK	0x80
+#define	RMP_IDX		1
+#define	DIT_IDX		2
+#define	DLY_IDX		4
+#define	RTBL_IDX	6
+#define	MSG_IDX		14
+#define	QRSS_SCALE	10				// ms per count (main.h)
+
+#define	CW_STOP		0x18			// embedded cmds (main.h)
+#define	CW_EOM		0xff
+#define	CW_IOP		0xe0
+#define	CW_IOM		0xd0
+#define	CW_IOSET	0xa0
+#define	CW_CHSET	0xc0
+#define	CW_CHADD	0xb0
+#define	CW_CHCLR	0x90
+#define	CW_NOP		0x08
+
+#define	C_LINE		16				// data bytes per "C" line (64 chr RX buffer)
+#define	HEX_LINE	16				// data bytes per HEX record
+#define	SRC_LINE	256
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+struct {
+	char	c;
+	const char*	m;
+} morse[] = {
+	{ 'A', ".-" },		{ 'B', "-..." },	{ 'C', "-.-." },	{ 'D', "-.." },
+	{ 'E', "." },		{ 'F', "..-." },	{ 'G', "--." },		{ 'H', "...." },
+	{ 'I', ".." },		{ 'J', ".---" },	{ 'K', "-.-" },		{ 'L', ".-.." },
+	{ 'M', "--" },		{ 'N', "-." },		{ 'O', "---" },		{ 'P', ".--." },
+	{ 'Q', "--.-" },	{ 'R', ".-." },		{ 'S', "..." },		{ 'T', "-" },
+	{ 'U', "..-" },		{ 'V', "...-" },	{ 'W', ".--" },		{ 'X', "-..-" },
+	{ 'Y', "-.--" },	{ 'Z', "--.." },
+	{ '0', "-----" },	{ '1', ".----" },	{ '2', "..---" },	{ '3', "...--" },
+	{ '4', "....-" },	{ '5', "....." },	{ '6', "-...." },	{ '7', "--..." },
+	{ '8', "---.." },	{ '9', "----." },
+	{ '.', ".-.-.-" },	{ ',', "--..--" },	{ '?', "..--.." },	{ '/', "-..-." },
+	{ '=', "-...-" },	{ '+', ".-.-." },	{ '-', "-....-" },	{ '\'', ".----." },
+	{ ':', "---..." },	{ ';', "-.-.-." },	{ '(', "-.--." },	{ ')', "-.--.-" },
+	{ '"', ".-..-." },	{ '@', ".--.-." },
+	{ 0, NULL }
+};
+
+unsigned char	img[MSG_MAX];		// msg sector image
+int		nbyte;						// # image bytes (incl. a partial byte)
+int		nbit;						// # bits used in img[nbyte-1] (8 = full)
+long	units;						// element times per msg cycle
+int		ncmd;						// # embedded cmds
+int		cgap;						// extra chr gap (units)
+int		wgap;						// extra word gap (units)
+int		err;						// error count (this file)
+const char*	fname;					// source file
+int		lnum;						// source line
+
+//-----------------------------------------------------------------------------
+// put_bit() appends one element time to the msg bit stream (MSb first)
+//-----------------------------------------------------------------------------
+void put_bit(int b){
+
+	if(nbit == 8){
+		if(nbyte >= MSG_MAX){
+			if(!err++) fprintf(stderr, "%s: msg too long (%d bytes max)\n", fname, MSG_MAX);
+			return;
+		}
+		img[nbyte++] = 0;
+		nbit = 0;
+	}
+	if(b){
+		img[nbyte-1] |= 0x80 >> nbit;
+	}
+	nbit++;
+	units++;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// put_gap() appends n "0" element times
+//-----------------------------------------------------------------------------
+void put_gap(int n){
+
+	while(n-- > 0){
+		put_bit(0);
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// put_cmd() pads to a byte boundary (the firmware only looks for CW_STOP in whole
+//	bytes) and appends an embedded cmd.  Each cmd takes one element time.
+//-----------------------------------------------------------------------------
+void put_cmd(unsigned char p){
+
+	put_gap(8 - nbit);
+	put_gap(8);										// CW_STOP byte
+	img[nbyte-1] = CW_STOP;
+	put_gap(8);
+	img[nbyte-1] = p;
+	units -= 16 - 1;								// the pair is one element time
+	ncmd++;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// put_morse() appends the elements of one chr (dit = 1, dah = 111, 0 after each)
+//-----------------------------------------------------------------------------
+int put_morse(int c){
+	int	i;
+	const char*	p;
+
+	c = toupper(c);
+	for(i = 0; morse[i].c && (morse[i].c != c); i++);
+	if(!morse[i].c){
+		fprintf(stderr, "%s:%d: no code for '%c'\n", fname, lnum, c);
+		err++;
+		return 1;
+	}
+	for(p = morse[i].m; *p; p++){
+		put_bit(1);
+		if(*p == '-'){
+			put_bit(1);
+			put_bit(1);
+		}
+		put_bit(0);
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// ch_arg() converts a channel letter (a-p) to 0-15, or -1
+//-----------------------------------------------------------------------------
+int ch_arg(int c){
+
+	c = tolower(c);
+	if((c >= 'a') && (c <= 'p')){
+		return c - 'a';
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// put_text() compiles one line of msg text.  returns 1 at EOM ("]%")
+//-----------------------------------------------------------------------------
+int put_text(const char* s){
+	int	c;
+	int	x;
+
+	while((c = *s++) != 0){
+		if((c == '\n') || (c == '\r')){
+			continue;
+		}
+		if(isspace(c)){
+			put_gap(wgap);
+		}else if(c == '<'){
+			while(*s && (*s != '>')){				// prosign, no chr gaps
+				put_morse(*s++);
+			}
+			if(*s != '>'){
+				fprintf(stderr, "%s:%d: no closing '>'\n", fname, lnum);
+				err++;
+				return 0;
+			}
+			s++;
+			put_gap(cgap);
+		}else if(c == ']'){
+			c = *s++;
+			x = -1;
+			switch(c){
+				case '%':
+					return 1;
+
+				case '>':
+					put_cmd(CW_IOP);
+					break;
+
+				case '<':
+					put_cmd(CW_IOM);
+					break;
+
+				case 'c':
+				case 'C':
+				case '+':
+				case '-':
+					if(*s){
+						x = ch_arg(*s++);
+					}
+					if(x < 0){
+						fprintf(stderr, "%s:%d: bad ch in ]%c\n", fname, lnum, c);
+						err++;
+						return 0;
+					}
+					if(c == '+'){
+						put_cmd(CW_CHADD | x);
+					}else if(c == '-'){
+						put_cmd(CW_CHCLR | x);
+					}else{
+						put_cmd(CW_CHSET | x);
+					}
+					break;
+
+				default:
+					if((c >= '0') && (c <= '7')){
+						put_cmd(CW_IOSET | (c - '0'));
+					}else if(c == '8'){
+						put_cmd(CW_NOP);
+					}else{
+						fprintf(stderr, "%s:%d: bad cmd ]%c\n", fname, lnum, c ? c : ' ');
+						err++;
+						return 0;
+					}
+					break;
+			}
+		}else{
+			if(!put_morse(c)){
+				put_gap(cgap);
+			}
+		}
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// msg_crc() is the firmware "cm" CRC: CRC16 (0x1021) from SECTCW_ADDR up to and
+//	including the 1st 0x18 0xff byte pair
+//-----------------------------------------------------------------------------
+unsigned int msg_crc(int* n){
+	unsigned int	crc = 0;
+	unsigned int	w = 0;
+	int		i;
+	int		j;
+
+	for(i = 0; i < nbyte; i++){
+		w = ((w << 8) | img[i]) & 0xffff;
+		crc ^= (unsigned int)img[i] << 8;
+		for(j = 0; j < 8; j++){
+			crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+			crc &= 0xffff;
+		}
+		if(w == ((CW_STOP << 8) | CW_EOM)){
+			break;
+		}
+	}
+	*n = i + 1;
+	return crc;
+}
+
+//-----------------------------------------------------------------------------
+// out_name() builds <src>.<ext> (replaces the source extension)
+//-----------------------------------------------------------------------------
+void out_name(char* buf, const char* src, const char* ext){
+	char*	p;
+
+	strcpy(buf, src);
+	p = strrchr(buf, '.');
+	if(p && !strchr(p, '/')){
+		*p = '\0';
+	}
+	strcat(buf, ".");
+	strcat(buf, ext);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// write_out() writes the .c, .cmd, and .hex files
+//-----------------------------------------------------------------------------
+int write_out(const char* src, unsigned int crc){
+	char	buf[SRC_LINE + 8];
+	FILE*	fp;
+	int		i;
+	int		j;
+	int		n;
+	unsigned int	a;
+	unsigned int	sum;
+
+	out_name(buf, src, "c");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return 1;
+	}
+	fprintf(fp, "\t// %s\n\tU8 code diode_matrix[] = {\n", src);
+	for(i = 0; i < nbyte; i++){
+		if(i % 14 == 0){
+			fprintf(fp, "\t\t");
+		}
+		fprintf(fp, "0x%02X", img[i]);
+		if(i != nbyte - 1){
+			fprintf(fp, ",");
+		}
+		if((i % 14 == 13) || (i == nbyte - 1)){
+			fprintf(fp, "\n");
+		}
+	}
+	fprintf(fp, "\t};\n");
+	fclose(fp);
+
+	out_name(buf, src, "cmd");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return 1;
+	}
+	fprintf(fp, "EM\nY\n");							// erase msg sector, confirm
+	for(i = 0; i < nbyte; i += C_LINE){
+		fprintf(fp, "C%04X ", i);
+		for(j = i; (j < nbyte) && (j < i + C_LINE); j++){
+			fprintf(fp, "%02X", img[j]);
+		}
+		fprintf(fp, "\n");
+	}
+	fprintf(fp, "zm %04X\n", crc);
+	fclose(fp);
+
+	out_name(buf, src, "hex");
+	if((fp = fopen(buf, "w")) == NULL){
+		perror(buf);
+		return 1;
+	}
+	for(i = 0; i < nbyte; i += HEX_LINE){
+		n = (nbyte - i < HEX_LINE) ? (nbyte - i) : HEX_LINE;
+		a = SECTCW_ADDR + i;
+		fprintf(fp, ":%02X%04X00", n, a);
+		sum = n + (a >> 8) + (a & 0xff);
+		for(j = i; j < i + n; j++){
+			fprintf(fp, "%02X", img[j]);
+			sum += img[j];
+		}
+		fprintf(fp, "%02X\n", (-sum) & 0xff);
+	}
+	fprintf(fp, ":00000001FF\n");
+	fclose(fp);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// compile() compiles one source file.  returns 0 if OK
+//-----------------------------------------------------------------------------
+int compile(const char* src){
+	char	line[SRC_LINE];
+	char	word[32];
+	FILE*	fp;
+	int		i;
+	int		n;
+	int		v[8];
+	int		eom = 0;
+	int		text = 0;
+	long	dit = -1;
+	long	dly = 0;
+	unsigned int	crc;
+	double	t;
+
+	fname = src;
+	lnum = 0;
+	err = 0;
+	units = 0;
+	ncmd = 0;
+	cgap = 3;
+	wgap = 10;
+	memset(img, 0, sizeof(img));
+	img[RMP_IDX] = 5;
+	img[RTBL_IDX+0] = 25;							// 0.6V offset ramp (main.c)
+	img[RTBL_IDX+1] = 37;
+	img[RTBL_IDX+2] = 61;
+	img[RTBL_IDX+3] = 110;
+	img[RTBL_IDX+4] = 170;
+	img[RTBL_IDX+5] = 219;
+	img[RTBL_IDX+6] = 243;
+	img[RTBL_IDX+7] = 255;
+	nbyte = MSG_IDX;
+	nbit = 8;
+	if((fp = fopen(src, "r")) == NULL){
+		perror(src);
+		return 1;
+	}
+	while(!eom && fgets(line, sizeof(line), fp)){
+		lnum++;
+		if(line[0] == '#'){
+			continue;
+		}
+		if((line[0] == '.') && isalpha((unsigned char)line[1])){
+			word[0] = '\0';
+			sscanf(line + 1, "%31s", word);
+			n = sscanf(line + 1, "%*s %d %d %d %d %d %d %d %d",
+				&v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+			if(!strcmp(word, "dit") && (n == 1)){
+				dit = v[0];
+			}else if(!strcmp(word, "wpm") && (n == 1) && (v[0] > 0)){
+				dit = 1200 / v[0];
+			}else if(!strcmp(word, "delay") && (n == 1)){
+				dly = v[0];
+			}else if(!strcmp(word, "ramp") && (n == 1)){
+				img[RMP_IDX] = (unsigned char)v[0];
+			}else if(!strcmp(word, "table") && (n == 8)){
+				for(i = 0; i < 8; i++){
+					img[RTBL_IDX+i] = (unsigned char)v[i];
+				}
+			}else if(!strcmp(word, "cgap") && (n == 1)){
+				cgap = v[0];
+			}else if(!strcmp(word, "wgap") && (n == 1)){
+				wgap = v[0];
+			}else if(!strcmp(word, "key")){
+				if(strstr(line, "hi")){
+					img[KEY_IDX] |= KEY_MASK;
+				}else{
+					img[KEY_IDX] &= ~KEY_MASK;
+				}
+			}else if(!strcmp(word, "dac")){
+				img[KEY_IDX] |= DAC_MASK;
+			}else if(!strcmp(word, "fsk")){
+				img[KEY_IDX] |= FSK_MASK;
+			}else if(!strcmp(word, "dfcw")){
+				img[KEY_IDX] |= DFCW_MASK;
+			}else if(!strcmp(word, "qrss")){
+				img[KEY_IDX] |= QRSS_MASK;
+			}else{
+				fprintf(stderr, "%s:%d: bad directive\n", src, lnum);
+				err++;
+			}
+			continue;
+		}
+		i = strlen(line);
+		while((i > 0) && isspace((unsigned char)line[i-1])){
+			line[--i] = '\0';						// no trailing word gaps
+		}
+		if(i == 0){
+			continue;
+		}
+		if(text){
+			put_gap(wgap);							// line break = space
+		}
+		eom = put_text(line);
+		text = 1;
+	}
+	fclose(fp);
+	if(dit < 0){
+		fprintf(stderr, "%s: no .dit or .wpm\n", src);
+		err++;
+	}
+	if(img[KEY_IDX] & QRSS_MASK){
+		dit /= QRSS_SCALE;							// stored in QRSS_SCALE ms units
+		dly /= QRSS_SCALE;
+	}
+	if((dit > 0xfffe) || (dly > 0xffff)){
+		fprintf(stderr, "%s: .dit/.delay out of range\n", src);
+		err++;
+	}
+	img[DIT_IDX] = (unsigned char)(dit >> 8);
+	img[DIT_IDX+1] = (unsigned char)dit;
+	img[DLY_IDX] = (unsigned char)(dly >> 8);
+	img[DLY_IDX+1] = (unsigned char)dly;
+	put_cmd(CW_EOM);
+	if(err){
+		return 1;
+	}
+	crc = msg_crc(&n);
+	if(n != nbyte){
+		fprintf(stderr, "%s: 0x18 0xff in the msg header, \"cm\" stops at byte %d\n", src, n);
+	}
+	if(write_out(src, crc)){
+		return 1;
+	}
+	if(img[KEY_IDX] & QRSS_MASK){
+		dit *= QRSS_SCALE;
+		dly *= QRSS_SCALE;
+	}
+	t = ((double)units * (double)dit + (double)dly) / 1000.0;
+	printf("%s: %d bytes (%d free), %d cmds, crc %04X, %ld elements, on-air %.1f s + %.1f s pause\n",
+		src, nbyte, MSG_MAX - nbyte, ncmd, crc, units, t - (dly / 1000.0), dly / 1000.0);
+	fflush(stdout);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// main() compiles each file, up to -j n at a time
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	int		i = 1;
+	int		nj = 1;
+	int		run = 0;
+	int		rc = 0;
+	int		st;
+	pid_t	pid;
+
+	if((argc > 2) && !strcmp(argv[1], "-j")){
+		nj = atoi(argv[2]);
+		if(nj < 1) nj = 1;
+		i = 3;
+	}
+	if(i >= argc){
+		fprintf(stderr, "usage: msgc [-j n] file.msg [file.msg ..]\n");
+		return 2;
+	}
+	if(nj == 1){
+		for(; i < argc; i++){
+			rc |= compile(argv[i]);
+		}
+		return rc;
+	}
+	for(; i < argc; i++){
+		if(run == nj){
+			wait(&st);								// wait for a free slot
+			run--;
+			if(!WIFEXITED(st) || WEXITSTATUS(st)) rc = 1;
+		}
+		pid = fork();
+		if(pid == 0){
+			exit(compile(argv[i]));
+		}
+		if(pid < 0){
+			perror("fork");
+			rc |= compile(argv[i]);					// no process, do it here
+		}else{
+			run++;
+		}
+	}
+	while(run--){
+		wait(&st);
+		if(!WIFEXITED(st) || WEXITSTATUS(st)) rc = 1;
+	}
+	return rc;
+}
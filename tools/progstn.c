@@ -0,0 +1,937 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: progstn.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Orion beacon production programming station.  Runs upload scripts
+ *				(msgc/chplan ".cmd" files, or any "EC", "EM", "Y", "M..", "C..", "z/zm"
+ *				lines, and ':' Intel HEX records such as the ".hex" files) on several serial ports at once, one worker process per port,
+ *				then "i" to re-init the unit.  Each line is sent in one write and paced
+ *				on the "bkn>" prompt.  Only one line is in flight per port: the CLI
+ *				parses one line at a time and a cmd that reads its own CR leaves
+ *				cleanline() to discard whatever follows it in the 64 byte rx buffer,
+ *				so throughput comes from running the ports in parallel.
+ *				"EC"/"EM" wait for the erase prompt and the following "Y" line is sent
+ *				without a CR (the CLI reads the "Y" itself, a CR would post an extra
+ *				prompt).  "z"/"zm" must answer PASS.  A line that answers "ERROR!",
+ *				"msg invalid", or times out fails the unit.
+ *				Each port logs its transcript (ms time stamps) to <dir>/<port>.log and
+ *				prints one result line per unit.  The totals line gives units/hour.
+ *				With -A the port is a multi-drop bus of units with IDs 01..n ("A" cmd,
+ *				main.c).  Each ID is pinged ("@hh"), then "QC" and the scripts are
+ *				broadcast once ("@00" lines, no reply, paced at BC_GAP ms after the
+ *				line is on the wire, BC_ERASE ms for an erase, BC_ZDLY ms for "z").
+ *				A bad line or a "z" FAIL sets the unit's load error, so each unit is
+ *				then polled with "Q" (must answer "NO errors") and "i".  The bus time
+ *				is about one upload plus two short lines per unit, not n uploads.
+ *
+ *  Build:     cc -O2 -o progstn progstn.c
+ *  Usage:     progstn [-b baud] [-l dir] [-r n] [-t s] [-n] -p port [-p port ..] script [script ..]
+ *             progstn [opts] -S n script [script ..]
+ *             progstn [opts] -A n -p port script [script ..]
+ *				-b baud	  port speed (default 9600)
+ *				-l dir	  log directory (default ".")
+ *				-r n	  units per port (default 1).  Between units the port is polled
+ *						  with CR until the old unit stops answering and a new one
+ *						  posts a prompt (no wait with -S)
+ *				-t s	  prompt timeout per line (default 5 s, erase/CRC lines add 10 s)
+ *				-n		  don't send "i" after the scripts
+ *				-S n	  test against n simulated beacons on pseudo-terminals (CLI
+ *						  subset: E, Y, M, C, :, z, c, Q, i; rx buffer, erase, and line
+ *						  time at the -b speed are modeled).  With -A each pty is a
+ *						  bus of n units (@hh addressing, only the addressed unit
+ *						  answers)
+ *				-A n	  multi-drop bus of n units (IDs 01..n hex) on each port
+ *						  (-r is ignored)
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *					Added multi-drop bus mode (-A).
+ *
+ *******************************************************************/
+
+#define	_XOPEN_SOURCE	600
+#define	_DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	MAX_PORT	32
+#define	MAX_SCRIPT	8
+#define	MAX_LINE	256
+#define	CLI_LINE	62				// CLI line limit, incl. the cmd chr (main.c)
+#define	RXD_BUFF	64				// CLI rx buffer (serial.c)
+#define	PROMPT		"bkn>"
+#define	ESC			0x1b
+#define	ERASE_TMO	10000			// extra ms for erase and "z" lines
+#define	MAX_ID		32				// max units on a bus (-A)
+#define	ID_NONE		0xff			// sim unit with no ID (main.c)
+#define	BC_GAP		50				// ms after a broadcast line is on the wire (parse + flash write)
+#define	BC_ERASE	1000			// ms after a broadcast "Y" (3 sector erase)
+#define	BC_ZDLY		1100			// ms after a broadcast "z" (1 s result delay, main.c)
+
+#define	NUM_CHAN	16				// sim flash image (flash.h, main.h)
+#define	SECTCH_ADDR	0x1600
+#define	CHAN_ADDR	(SECTCH_ADDR + 0x80)
+#define	SECTCW_ADDR	0x1800
+#define	FLASH_END	0x1dfe
+#define	MSG_MAX		(FLASH_END - SECTCW_ADDR)
+#define	CW_STOPW	0x18ff
+#define	SECT_MS		20				// sim sector erase time
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+char*	port[MAX_PORT];
+int		nport;
+char*	script[MAX_SCRIPT];
+int		nscript;
+speed_t	baud = B9600;
+long	bps = 9600;
+const char*	logdir = ".";
+int		nunit = 1;
+long	tmo = 5000;
+int		no_init;
+int		nsim;
+int		nid;						// -A: # units per bus
+pid_t	sim_pid[MAX_PORT];
+int		sim_fd[MAX_PORT];			// slave fds held open so a worker close doesn't hang up the sim
+FILE*	lf;							// worker log
+
+typedef struct{						// sim unit
+	int		id;						// unit ID (ID_NONE = not addressed)
+	int		eyes;					// # sectors of a pending erase ("Y" expected)
+	int		err;					// load error ("Q")
+	unsigned char	ch[NUM_CHAN * 24];
+	unsigned char	msg[MSG_MAX];
+} SIMU;
+double	t_unit;						// unit start (s)
+
+//-----------------------------------------------------------------------------
+// now() returns the monotonic time (s)
+//-----------------------------------------------------------------------------
+double now(void){
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+//-----------------------------------------------------------------------------
+// calcrc() is the firmware CRC16 (xmodem poly 0x1021)
+//-----------------------------------------------------------------------------
+unsigned int calcrc(unsigned char c, unsigned int crc){
+	int	i;
+
+	crc ^= (unsigned int)c << 8;
+	for(i = 0; i < 8; i++){
+		crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+	}
+	return crc & 0xffff;
+}
+
+//-----------------------------------------------------------------------------
+// port_open() opens a port raw, 8N1, at the -b speed
+//-----------------------------------------------------------------------------
+int port_open(const char* name){
+	int				fd;
+	struct termios	t;
+
+	fd = open(name, O_RDWR | O_NOCTTY);
+	if(fd < 0){
+		return -1;
+	}
+	if(tcgetattr(fd, &t) == 0){
+		cfmakeraw(&t);
+		t.c_cflag |= CLOCAL | CREAD;
+		t.c_cflag &= ~(CSTOPB | CRTSCTS);
+		cfsetispeed(&t, baud);
+		cfsetospeed(&t, baud);
+		tcsetattr(fd, TCSANOW, &t);
+	}
+	tcflush(fd, TCIOFLUSH);
+	return fd;
+}
+
+//-----------------------------------------------------------------------------
+// tx() sends a line (one write) and logs it
+//-----------------------------------------------------------------------------
+int tx(int fd, const char* s, int cr){
+	char	b[MAX_LINE + 2];
+	int		n;
+
+	n = snprintf(b, sizeof(b), "%s%s", s, cr ? "\r" : "");
+	fprintf(lf, "%9.3f > %s\n", now() - t_unit, (*s == ESC) ? "<ESC>" : s);
+	return (write(fd, b, n) == n) ? 0 : -1;
+}
+
+//-----------------------------------------------------------------------------
+// rx() reads until one of the strings a/b shows up (b may be NULL) or ms passes.
+//	returns 1 for a, 2 for b, 0 for timeout/error.  The response is in r[].
+//-----------------------------------------------------------------------------
+int rx(int fd, const char* a, const char* b, long ms, char* r, int rlen){
+	struct pollfd	p;
+	double	tend;
+	int		n = 0;
+	int		j, k;
+	int		hit = 0;
+
+	tend = now() + ms / 1000.0;
+	r[0] = '\0';
+	p.fd = fd;
+	p.events = POLLIN;
+	while(!hit){
+		k = (int)((tend - now()) * 1000.0);
+		if((k <= 0) || (poll(&p, 1, k) <= 0)){
+			break;
+		}
+		if(n >= rlen - 1){
+			memmove(r, r + rlen / 2, n - rlen / 2);		// keep the tail
+			n -= rlen / 2;
+		}
+		k = read(fd, r + n, rlen - 1 - n);
+		if(k <= 0){
+			break;
+		}
+		for(j = n, k += n; j < k; j++){
+			if(r[j] != '\0') r[n++] = r[j];		// drop NULs (the CLI echoes one for an empty line)
+		}
+		r[n] = '\0';
+		if(strstr(r, a)){
+			hit = 1;
+		}else{
+			if(b && strstr(r, b)) hit = 2;
+		}
+	}
+	for(k = 0; k < n; k++){
+		if((r[k] == '\r') || (r[k] == '\n') || (r[k] == '\0')) r[k] = ' ';
+	}
+	fprintf(lf, "%9.3f < %s%s\n", now() - t_unit, r, hit ? "" : " (TIMEOUT)");
+	return hit;
+}
+
+//-----------------------------------------------------------------------------
+// drain() discards rx until the port is quiet for ms
+//-----------------------------------------------------------------------------
+void drain(int fd, int ms){
+	struct pollfd	p;
+	char	b[256];
+
+	p.fd = fd;
+	p.events = POLLIN;
+	while((poll(&p, 1, ms) > 0) && (read(fd, b, sizeof(b)) > 0));
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// swap_wait() polls the port with CR until the unit stops answering (removed),
+//	then until a prompt comes back (the next unit)
+//-----------------------------------------------------------------------------
+void swap_wait(const char* name){
+	char	r[256];
+	int		fd;
+	int		gone = 0;
+
+	printf("%s: swap unit\n", name);
+	fflush(stdout);
+	for(;;){
+		fd = port_open(name);
+		if(fd >= 0){
+			tx(fd, "", 1);
+			if(rx(fd, PROMPT, NULL, 500, r, sizeof(r))){
+				if(gone){
+					close(fd);
+					return;
+				}
+			}else{
+				gone = 1;
+			}
+			close(fd);
+		}else{
+			gone = 1;
+		}
+		usleep(500000);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// unit() programs one unit on fd.  returns 0 = PASS.  *nl/*nb = lines/bytes sent
+//-----------------------------------------------------------------------------
+int unit(int fd, int* nl, int* nb){
+	FILE*	f;
+	char	line[MAX_LINE];
+	char	r[1024];
+	char*	s;
+	int		i;
+	int		n;
+	int		ers = 0;						// 1 = "Y" expected (after "EC"/"EM")
+	int		err = 0;
+
+	*nl = 0;
+	*nb = 0;
+	tx(fd, "\x1b", 0);						// ESC re-inits the CLI rx buffer
+	tx(fd, "", 1);
+	if(!rx(fd, PROMPT, NULL, tmo, r, sizeof(r))){
+		fprintf(lf, "no prompt\n");
+		return 1;
+	}
+	drain(fd, 200);							// boot banner or extra prompts
+	for(i = 0; !err && (i < nscript); i++){
+		f = fopen(script[i], "r");
+		if(!f){
+			fprintf(lf, "%s: can't open\n", script[i]);
+			return 1;
+		}
+		while(!err && fgets(line, sizeof(line), f)){
+			s = line;
+			while(isspace((unsigned char)*s)) s++;
+			n = strlen(s);
+			while(n && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+			if((n == 0) || (*s == '#')){
+				continue;
+			}
+			if(n > CLI_LINE){
+				fprintf(lf, "%s: line > %d chrs: %s\n", script[i], CLI_LINE, s);
+				err = 1;
+				break;
+			}
+			(*nl)++;
+			*nb += n + 1;
+			if(ers){
+				ers = 0;
+				if(strcmp(s, "Y")){
+					fprintf(lf, "%s: \"Y\" expected after erase\n", script[i]);
+					err = 1;
+					break;
+				}
+				tx(fd, s, 0);
+				if(!rx(fd, PROMPT, NULL, tmo + ERASE_TMO, r, sizeof(r)) || !strstr(r, "Erased!")){
+					err = 1;
+				}
+				continue;
+			}
+			tx(fd, s, 1);
+			if((s[0] == 'E') && ((s[1] == 'C') || (s[1] == 'M'))){
+				if(rx(fd, "cont...", NULL, tmo, r, sizeof(r))){
+					ers = 1;
+				}else{
+					err = 1;
+				}
+				continue;
+			}
+			if(!rx(fd, PROMPT, NULL, (s[0] == 'z') ? tmo + ERASE_TMO : tmo, r, sizeof(r))){
+				err = 1;
+				break;
+			}
+			if(strstr(r, "ERROR") || strstr(r, "FAIL") || strstr(r, "invalid")){
+				err = 1;
+			}
+			if((s[0] == 'z') && !strstr(r, "PASS")){
+				err = 1;
+			}
+		}
+		fclose(f);
+	}
+	if(!err && !no_init){
+		tx(fd, "i", 1);
+		if(!rx(fd, PROMPT, NULL, tmo, r, sizeof(r)) || !strstr(r, "Re-init")){
+			err = 1;
+		}
+	}
+	return err;
+}
+
+//-----------------------------------------------------------------------------
+// bc() broadcasts a line to a bus ("@00", no reply) and waits until every unit
+//	has had time to run it
+//-----------------------------------------------------------------------------
+int bc(int fd, const char* s, int cr, long ms){
+	char	b[MAX_LINE + 8];
+
+	snprintf(b, sizeof(b), "@00%s%s", (strlen(s) + 4 <= CLI_LINE) ? " " : "", s);
+	if(tx(fd, b, cr)){
+		return -1;
+	}
+	tcdrain(fd);							// on the wire
+	usleep(ms * 1000L);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// bus() programs the nid units on a multi-drop port: ping, broadcast the scripts,
+//	then poll each unit's error status.  ok[id] = 1 for a unit that passed.  returns the # failed.
+//	*nl/*nb = lines/bytes sent
+//-----------------------------------------------------------------------------
+int bus(int fd, const char* name, int* ok, int* nl, int* nb){
+	FILE*	f;
+	char	line[MAX_LINE];
+	char	b[MAX_LINE + 8];
+	char	r[1024];
+	char*	s;
+	int		i;
+	int		n;
+	int		id;
+	int		ers = 0;
+	int		err = 0;
+	int		fail = 0;
+
+	*nl = 0;
+	*nb = 0;
+	tx(fd, "\x1b", 0);						// ESC re-inits every rx buffer on the bus
+	drain(fd, 200);
+	for(id = 1; id <= nid; id++){
+		snprintf(b, sizeof(b), "@%02X", id);
+		tx(fd, b, 1);
+		ok[id] = rx(fd, PROMPT, NULL, tmo, r, sizeof(r));
+		if(!ok[id]){
+			fprintf(lf, "unit %02X: no prompt\n", id);
+		}
+	}
+	bc(fd, "QC", 1, BC_GAP);				// clear the load errors
+	for(i = 0; !err && (i < nscript); i++){
+		f = fopen(script[i], "r");
+		if(!f){
+			fprintf(lf, "%s: can't open\n", script[i]);
+			err = 1;
+			break;
+		}
+		while(!err && fgets(line, sizeof(line), f)){
+			s = line;
+			while(isspace((unsigned char)*s)) s++;
+			n = strlen(s);
+			while(n && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+			if((n == 0) || (*s == '#')){
+				continue;
+			}
+			if(n + 3 > CLI_LINE){
+				fprintf(lf, "%s: line > %d chrs with \"@00\": %s\n", script[i], CLI_LINE, s);
+				err = 1;
+				break;
+			}
+			if(ers){
+				ers = 0;
+				if(strcmp(s, "Y")){
+					fprintf(lf, "%s: \"Y\" expected after erase\n", script[i]);
+					err = 1;
+					break;
+				}
+				bc(fd, s, 1, BC_ERASE);			// the confirm is a line in addressed mode
+			}else{
+				bc(fd, s, 1, (s[0] == 'z') ? BC_ZDLY : BC_GAP);
+				ers = (s[0] == 'E') && ((s[1] == 'C') || (s[1] == 'M'));
+			}
+			(*nl)++;
+			*nb += n + 5;
+		}
+		fclose(f);
+	}
+	if(err){
+		return nid;
+	}
+	for(id = 1; id <= nid; id++){
+		if(ok[id]){
+			snprintf(b, sizeof(b), "@%02X Q", id);
+			tx(fd, b, 1);
+			(*nl)++;
+			*nb += strlen(b) + 1;
+			if(!rx(fd, PROMPT, NULL, tmo, r, sizeof(r)) || !strstr(r, "NO errors")){
+				ok[id] = 0;						// a bad line or "z" FAIL
+			}
+		}
+		if(ok[id] && !no_init){
+			snprintf(b, sizeof(b), "@%02X i", id);
+			tx(fd, b, 1);
+			(*nl)++;
+			*nb += strlen(b) + 1;
+			if(!rx(fd, PROMPT, NULL, tmo, r, sizeof(r)) || !strstr(r, "Re-init")){
+				ok[id] = 0;
+			}
+		}
+		fprintf(lf, "---- %s unit %02X %s\n", name, id, ok[id] ? "PASS" : "FAIL");
+		printf("%s: unit %02X %s\n", name, id, ok[id] ? "PASS" : "FAIL");
+		if(!ok[id]) fail++;
+	}
+	return fail;
+}
+
+//-----------------------------------------------------------------------------
+// worker() programs nunit units on one port.  returns the # failed (max 255)
+//-----------------------------------------------------------------------------
+int worker(const char* name){
+	char	lname[MAX_LINE];
+	const char*	base;
+	int		fd;
+	int		u;
+	int		nl;
+	int		nb;
+	int		fail = 0;
+	int		rc;
+	int		ok[MAX_ID + 1];
+	double	t;
+
+	base = strrchr(name, '/');
+	base = base ? base + 1 : name;
+	snprintf(lname, sizeof(lname), "%s/%s.log", logdir, base);
+	lf = fopen(lname, "a");
+	if(!lf){
+		perror(lname);
+		return 255;
+	}
+	setvbuf(lf, NULL, _IOLBF, 0);
+	if(nid){
+		t_unit = now();
+		fprintf(lf, "---- %s bus %d units\n", name, nid);
+		fd = port_open(name);
+		if(fd < 0){
+			fprintf(lf, "can't open: %s\n", strerror(errno));
+			fail = nid;
+			nl = nb = 0;
+		}else{
+			fail = bus(fd, name, ok, &nl, &nb);
+			close(fd);
+		}
+		t = now() - t_unit;
+		fprintf(lf, "---- %s bus %d units, %d FAIL, %.1f s, %d lines, %d bytes\n", name, nid, fail, t, nl, nb);
+		printf("%s: bus %d units, %d FAIL, %.1f s, %d lines, %d bytes\n", name, nid, fail, t, nl, nb);
+		fflush(stdout);
+		fclose(lf);
+		return fail;
+	}
+	for(u = 1; u <= nunit; u++){
+		if((u > 1) && !nsim){
+			swap_wait(name);
+		}
+		t_unit = now();
+		fprintf(lf, "---- %s unit %d\n", name, u);
+		fd = port_open(name);
+		if(fd < 0){
+			fprintf(lf, "can't open: %s\n", strerror(errno));
+			rc = 1;
+			nl = nb = 0;
+		}else{
+			rc = unit(fd, &nl, &nb);
+			close(fd);
+		}
+		t = now() - t_unit;
+		fprintf(lf, "---- %s unit %d %s %.1f s, %d lines, %d bytes\n", name, u, rc ? "FAIL" : "PASS", t, nl, nb);
+		printf("%s: unit %d %s %.1f s, %d lines, %d bytes\n", name, u, rc ? "FAIL" : "PASS", t, nl, nb);
+		fflush(stdout);
+		if(rc && (fail < 255)) fail++;
+	}
+	fclose(lf);
+	return fail;
+}
+
+//-----------------------------------------------------------------------------
+// sim_out() sends a sim response, '\n' as CR LF (putss()).  fd < 0 = muted
+//-----------------------------------------------------------------------------
+void sim_out(int fd, const char* s){
+	char	b[MAX_LINE * 2];
+	int		n = 0;
+
+	if(fd < 0){
+		return;									// muted
+	}
+	while(*s && (n < (int)sizeof(b) - 2)){
+		if(*s == '\n') b[n++] = '\r';
+		b[n++] = *s++;
+	}
+	if(write(fd, b, n) != n) exit(0);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// sim_hex() reads hex byte pairs (spaces, commas, tabs skipped).  returns the #
+//	read, -1 on bad data
+//-----------------------------------------------------------------------------
+int sim_hex(const char* s, unsigned char* d, int max){
+	int		n = 0;
+	int		v;
+
+	while(*s && (n < max)){
+		if((*s == ' ') || (*s == ',') || (*s == '\t')){
+			s++;
+			continue;
+		}
+		if(!isxdigit((unsigned char)s[0]) || !isxdigit((unsigned char)s[1])) return -1;
+		sscanf(s, "%2x", &v);
+		d[n++] = (unsigned char)v;
+		s += 2;
+	}
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+// sim_eyes() ends a pending sim erase ("Y" = 1 confirms)
+//-----------------------------------------------------------------------------
+void sim_eyes(int fd, SIMU* u, int y){
+	int		i;
+
+	if(y){
+		sim_out(fd, "\nerasing:");
+		for(i = 0; i < u->eyes; i++){
+			if(fd >= 0) usleep(SECT_MS * 1000);	// muted units erase at once (in parallel on a bus)
+			sim_out(fd, ".");
+		}
+		sim_out(fd, "Erased!\n\n" PROMPT);
+	}else{
+		sim_out(fd, "Aborted.\n\n" PROMPT);
+	}
+	u->eyes = 0;
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// sim_cmd() runs one cmd line (address removed) on a sim unit.  fd < 0 = muted
+//-----------------------------------------------------------------------------
+void sim_cmd(int fd, SIMU* u, const char* line){
+	unsigned char	d[MAX_LINE];
+	char	o[64];
+	int		i;
+	int		k;
+	unsigned int	crc;
+	unsigned int	w;
+
+	o[0] = line[0];
+	o[1] = '\0';
+	sim_out(fd, o);
+	switch(line[0]){
+		default:
+		case '\0':
+			break;
+
+		case 'E':
+			if((line[1] != 'C') && (line[1] != 'M')){
+				sim_out(fd, "ERROR!\n");
+				u->err = 1;
+				break;
+			}
+			if(line[1] == 'C'){
+				memset(u->ch, 0xff, sizeof(u->ch));
+				sim_out(fd, "\nErase All PLL data, Press \"Y\" to cont...");
+				u->eyes = 1;
+			}else{
+				memset(u->msg, 0xff, sizeof(u->msg));
+				sim_out(fd, "\nErase CW Message, Press \"Y\" to cont...");
+				u->eyes = 3;
+			}
+			return;
+
+		case 'M':
+			k = (line[1] - '0') * 10 + (line[2] - '0');
+			if((k < 0) || (k >= NUM_CHAN) || (sim_hex(line + 3, d, 24) != 24)){
+				sim_out(fd, "ERROR!\n");
+				u->err = 1;
+				break;
+			}
+			for(i = 0; i < 24; i++) u->ch[k * 24 + i] &= d[i];		// flash only clears bits
+			sim_out(fd, "Chan pgmd!\n");
+			break;
+
+		case 'C':
+			k = sim_hex(line + 1, d, sizeof(d));
+			w = (k >= 2) ? ((unsigned int)d[0] << 8) | d[1] : MSG_MAX;
+			if((k < 2) || (w + k - 2 > MSG_MAX)){
+				sim_out(fd, "ERROR!\n");
+				u->err = 1;
+				break;
+			}
+			for(i = 2; i < k; i++) u->msg[w + i - 2] &= d[i];
+			sim_out(fd, "Chan pgmd!\n");
+			break;
+
+		case 'c':
+		case 'z':
+			crc = 0;
+			if(line[1] == 'm'){
+				w = 0;
+				i = 0;
+				do{
+					w = ((w << 8) | u->msg[i]) & 0xffff;
+					crc = calcrc(u->msg[i++], crc);
+				}while((w != CW_STOPW) && (i < MSG_MAX - 1));
+			}else{
+				for(i = 0; i < NUM_CHAN * 24; i++) crc = calcrc(u->ch[i], crc);
+			}
+			if(line[0] == 'c'){
+				snprintf(o, sizeof(o), "\n%s = 0x%04X\n", (line[1] == 'm') ? "CW CRC" : "CRC16", crc);
+				sim_out(fd, o);
+				break;
+			}
+			sim_out(fd, (line[1] == 'm') ? " CMP CW CRC..." : " CMP CRC16...");
+			k = sim_hex(line + ((line[1] == 'm') ? 2 : 1), d, 2);
+			if(fd >= 0) sleep(1);				// result delay (muted: in parallel, host paced)
+			if((k == 2) && ((((unsigned int)d[0] << 8) | d[1]) == crc)){
+				sim_out(fd, "\nPASS\n");
+			}else{
+				sim_out(fd, "\nFAIL\n");
+				u->err = 1;
+			}
+			break;
+
+		case 'Q':
+			sim_out(fd, u->err ? "\nLoad errors\n" : "\nNO errors\n");
+			if(line[1] == 'C'){
+				sim_out(fd, "Err status cleared\n");
+				u->err = 0;
+			}
+			sim_out(fd, "\n");
+			break;
+
+		case ':':
+			k = sim_hex(line + 1, d, sizeof(d));
+			crc = 0;
+			for(i = 0; i < k; i++) crc += d[i];
+			w = (k >= 5) ? ((unsigned int)d[1] << 8) | d[2] : 0;
+			if((k < 5) || (crc & 0xff) || (k != d[0] + 5) || ((d[3] == 0) && ((w < SECTCH_ADDR) || (w + d[0] > FLASH_END)))){
+				sim_out(fd, "ERROR!\n");
+				u->err = 1;
+				break;
+			}
+			for(i = 0; (d[3] == 0) && (i < d[0]); i++, w++){
+				if((w >= CHAN_ADDR) && (w < SECTCW_ADDR)){
+					u->ch[w - CHAN_ADDR] &= d[i + 4];
+				}
+				if(w >= SECTCW_ADDR){
+					u->msg[w - SECTCW_ADDR] &= d[i + 4];
+				}
+			}
+			break;
+
+		case 'i':
+			sim_out(fd, "\nRe-init");
+			break;
+	}
+	sim_out(fd, "\n" PROMPT);
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// sim() is a simulated beacon CLI on pty master fd, or a bus of nu units (IDs
+//	01..nu) that all see the same rx.  Lines are processed from a 64 byte rx
+//	buffer (an overrun empties it, as serial.c), and each line takes its serial
+//	time at bps before the reply.  On a bus, "@hh" lines run on unit hh (the
+//	only one that answers) and "@00" lines run muted on every unit.
+//-----------------------------------------------------------------------------
+void sim(int fd, int nu){
+	SIMU*	u;
+	char	buf[RXD_BUFF];
+	char	line[RXD_BUFF + 1];
+	char*	p;
+	char	c;
+	int		n = 0;
+	int		k;
+	int		id;
+	int		nn;
+
+	nn = nu ? nu : 1;
+	u = calloc(nn, sizeof(SIMU));
+	if(!u) exit(0);
+	for(k = 0; k < nn; k++){
+		u[k].id = nu ? k + 1 : ID_NONE;
+		memset(u[k].ch, 0x5a, sizeof(u[k].ch));		// not erased
+		memset(u[k].msg, 0x5a, sizeof(u[k].msg));
+	}
+	if(!nu){
+		sim_out(fd, "\nORION sim\n" PROMPT);			// addressed units boot muted
+	}
+	for(;;){
+		if(read(fd, &c, 1) != 1) exit(0);
+		if(c == ESC){
+			n = 0;
+			continue;
+		}
+		if(c == '\n') continue;
+		if(!nu && u[0].eyes){
+			sim_eyes(fd, &u[0], c == 'Y');		// no ID: the CLI reads the "Y" chr
+			continue;
+		}
+		buf[n++] = c;
+		if(n == RXD_BUFF){
+			n = 0;								// overrun: head meets tail, buffer reads empty
+			continue;
+		}
+		if(c != '\r') continue;
+		memcpy(line, buf, n - 1);
+		line[n - 1] = '\0';
+		usleep((useconds_t)(n * 10000000L / bps));	// line time on the wire
+		n = 0;
+		id = -1;								// no address
+		p = line;
+		if(line[0] == '@'){
+			if(!isxdigit((unsigned char)line[1]) || !isxdigit((unsigned char)line[2])){
+				continue;
+			}
+			sscanf(line + 1, "%2x", &id);
+			for(p = line + 3; (*p == ' ') || (*p == ',') || (*p == '\t'); p++);
+		}
+		for(k = 0; k < nn; k++){
+			if((id != 0) && (id != u[k].id) && !((id < 0) && (u[k].id == ID_NONE))){
+				continue;						// not for this unit
+			}
+			if(u[k].eyes){
+				sim_eyes(id ? fd : -1, &u[k], p[0] == 'Y');
+			}else{
+				sim_cmd(id ? fd : -1, &u[k], p);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// sim_start() opens a pty, forks a sim beacon on the master, and returns the
+//	slave name (the port for a worker)
+//-----------------------------------------------------------------------------
+char* sim_start(int k){
+	int				m;
+	char*			s;
+	struct termios	t;
+
+	m = posix_openpt(O_RDWR | O_NOCTTY);
+	if((m < 0) || grantpt(m) || unlockpt(m) || !(s = ptsname(m))){
+		perror("pty");
+		exit(2);
+	}
+	s = strdup(s);
+	if(tcgetattr(m, &t) == 0){
+		cfmakeraw(&t);
+		tcsetattr(m, TCSANOW, &t);
+	}
+	sim_pid[k] = fork();
+	if(sim_pid[k] == 0){
+		sim(m, nid);
+		exit(0);
+	}
+	close(m);
+	sim_fd[k] = open(s, O_RDWR | O_NOCTTY);
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+// main() starts one worker per port, then reports the totals
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	int		i;
+	int		st;
+	int		fail = 0;
+	int		nw = 0;
+	double	t0;
+	double	t;
+	pid_t	pid;
+
+	for(i = 1; i < argc; i++){
+		if((argv[i][0] != '-') || !argv[i][1]){
+			if(nscript < MAX_SCRIPT) script[nscript++] = argv[i];
+			continue;
+		}
+		if(argv[i][1] == 'n'){
+			no_init = 1;
+			continue;
+		}
+		if(i + 1 >= argc) break;
+		switch(argv[i][1]){
+			case 'p':
+				if(nport < MAX_PORT) port[nport++] = argv[++i];
+				break;
+			case 'b':
+				bps = atol(argv[++i]);
+				switch(bps){
+					case 1200:	baud = B1200; break;
+					case 2400:	baud = B2400; break;
+					case 4800:	baud = B4800; break;
+					case 19200:	baud = B19200; break;
+					case 38400:	baud = B38400; break;
+					case 57600:	baud = B57600; break;
+					case 115200: baud = B115200; break;
+					default:	bps = 9600; baud = B9600; break;
+				}
+				break;
+			case 'l':
+				logdir = argv[++i];
+				break;
+			case 'r':
+				nunit = atoi(argv[++i]);
+				if(nunit < 1) nunit = 1;
+				break;
+			case 't':
+				tmo = atol(argv[++i]) * 1000L;
+				if(tmo < 1000) tmo = 1000;
+				break;
+			case 'S':
+				nsim = atoi(argv[++i]);
+				if(nsim > MAX_PORT) nsim = MAX_PORT;
+				break;
+			case 'A':
+				nid = atoi(argv[++i]);
+				if(nid < 0) nid = 0;
+				if(nid > MAX_ID) nid = MAX_ID;
+				break;
+			default:
+				i = argc;
+				nscript = 0;
+				break;
+		}
+	}
+	for(i = 0; (i < nsim) && (nport < MAX_PORT); i++){
+		port[nport++] = sim_start(i);
+	}
+	if(!nport || !nscript){
+		fprintf(stderr, "usage: progstn [-b baud] [-l dir] [-r n] [-t s] [-n] -p port [-p port ..] script [script ..]\n"
+						"       progstn [opts] -S n script [script ..]\n"
+						"       progstn [opts] -A n -p port script [script ..]\n");
+		return 2;
+	}
+	if(nid){
+		nunit = nid;							// units per port (for the totals)
+	}
+	t0 = now();
+	for(i = 0; i < nport; i++){
+		pid = fork();
+		if(pid == 0){
+			exit(worker(port[i]));
+		}
+		if(pid < 0){
+			perror("fork");
+			fail += worker(port[i]);				// no process, do it here
+		}else{
+			nw++;
+		}
+	}
+	while(nw && (wait(&st) > 0)){
+		nw--;
+		if(WIFEXITED(st)){
+			fail += WEXITSTATUS(st);
+		}else{
+			fail++;
+		}
+	}
+	for(i = 0; i < nsim; i++){
+		kill(sim_pid[i], SIGTERM);
+		waitpid(sim_pid[i], &st, 0);
+	}
+	t = now() - t0;
+	printf("%d ports, %d units, %d FAIL, %.1f s, %.0f units/hour\n", nport, nport * nunit, fail, t,
+		(t > 0) ? (nport * nunit - fail) * 3600.0 / t : 0.0);
+	return fail ? 1 : 0;
+}
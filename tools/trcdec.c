@@ -0,0 +1,197 @@
+/*************************************************************************
+ *********** COPYRIGHT (c) 2026 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: trcdec.c
+ *
+ *  Module:    Host tool
+ *
+ *  Summary:   Decodes the Orion beacon event trace ("T" or "TB" cmd output) into
+ *				a timing chart.
+ *
+ *  Build:     cc -o trcdec trcdec.c
+ *  Usage:     trcdec [-b] < capture
+ *				-b = capture is the binary "TB" output, else the hex "T" output
+ *				(one "ee mm tttt" record per line, other lines are ignored).
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    10-19-26:      creation date
+ *
+ *******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// local defines
+//------------------------------------------------------------------------------
+
+#define	PCA_US		(12.0 / 24.5)	// PCA tic (us) at the full SYSCLK (24.5 MHz / 12)
+#define	CLK_DIV		8.0				// SYSCLK divider when throttled
+#define	MAX_REC		256
+
+// event types (bits 7-5), see main.c
+#define	TRC_KEY		0x00
+#define	TRC_SPI		0x20
+#define	TRC_CH		0x40
+#define	TRC_LOCK	0x60
+#define	TRC_PTT		0x80
+#define	TRC_CMD		0xa0
+#define	TRC_FSEL	0xc0
+#define	TRC_CLK		0xe0
+
+//-----------------------------------------------------------------------------
+// Local Variable Declarations
+//-----------------------------------------------------------------------------
+
+unsigned char	ev[MAX_REC];		// records
+unsigned char	ms[MAX_REC];
+unsigned int	pca[MAX_REC];
+
+//-----------------------------------------------------------------------------
+// ev_text() describes an event
+//-----------------------------------------------------------------------------
+void ev_text(unsigned char e, char* s){
+	unsigned char	d = e & 0x1f;
+
+	switch(e & 0xe0){
+		case TRC_KEY:
+			sprintf(s, "keyout %s", d ? "dn" : "up");
+			break;
+
+		case TRC_SPI:
+			if((d & 0x07) == 4){
+				sprintf(s, "SPI R4  VCO %s RF %s", (d & 0x08) ? "on " : "off", (d & 0x10) ? "on" : "off");
+			}else{
+				sprintf(s, "SPI R%d", d & 0x07);
+			}
+			break;
+
+		case TRC_CH:
+			if(d == 0x0f){
+				sprintf(s, "ch load temp reg");
+			}else{
+				sprintf(s, "ch load %02d", d);
+			}
+			break;
+
+		case TRC_LOCK:
+			sprintf(s, "lock %s", d ? "yes" : "NO");
+			break;
+
+		case TRC_PTT:
+			sprintf(s, "PTT %s", d ? "dn" : "up");
+			break;
+
+		case TRC_CMD:
+			sprintf(s, "cmd '%c'", d | 0x40);
+			break;
+
+		case TRC_FSEL:
+			sprintf(s, "FSEL edge %x", d & 0x0f);
+			break;
+
+		case TRC_CLK:
+			sprintf(s, "SYSCLK %s", d ? "/8" : "full");
+			break;
+	}
+	return;
+}
+
+//-----------------------------------------------------------------------------
+// main() reads the capture and prints one chart line per event:
+//	time from the 1st event (us), time from the last event (us), keyout and RF
+//	state columns, and the event.  Times under 30 ms apart use the PCA count
+//	(0.49 us), longer gaps use the 1 ms count (mod 256 ms).
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[]){
+	char	buf[128];
+	char	txt[64];
+	unsigned int	e, m, t;
+	int		n = 0;
+	int		i;
+	int		c;
+	int		bin = 0;
+	int		key = 0;
+	int		rf = 0;
+	int		lo = 0;
+	double	tic;
+	double	dt;
+	double	tabs = 0.0;
+	unsigned int	dms, dpca;
+
+	if((argc > 1) && !strcmp(argv[1], "-b")){
+		bin = 1;
+	}
+	if(bin){
+		i = 0;
+		while(((c = getchar()) != EOF) && !((i == 'T') && (c == 'B'))){
+			i = c;									// find the "TB" header
+		}
+		if((c == EOF) || ((c = getchar()) == EOF)){
+			fprintf(stderr, "no trace\n");
+			return 1;
+		}
+		for(i = c; (i > 0) && (n < MAX_REC); i--){
+			e = getchar();
+			m = getchar();
+			t = getchar() << 8;
+			c = getchar();
+			if(c == EOF) break;
+			t |= c;
+			ev[n] = e;
+			ms[n] = m;
+			pca[n++] = t;
+		}
+	}else{
+		while(fgets(buf, sizeof(buf), stdin) && (n < MAX_REC)){
+			if((sscanf(buf, "%2x %2x %4x", &e, &m, &t) == 3) && (strlen(buf) >= 10)){
+				ev[n] = e;
+				ms[n] = m;
+				pca[n++] = t;
+			}
+		}
+	}
+	if(n == 0){
+		fprintf(stderr, "no trace\n");
+		return 1;
+	}
+	printf("     t (us)     dt (us)  KEY RF  event\n");
+	for(i = 0; i < n; i++){
+		dt = 0.0;
+		if(i){
+			tic = lo ? (PCA_US * CLK_DIV) : PCA_US;
+			dms = (ms[i] - ms[i-1]) & 0xff;
+			dpca = (pca[i] - pca[i-1]) & 0xffff;
+			if((double)dms * 1000.0 < (65536.0 * tic) - 2000.0){
+				dt = (double)dpca * tic;			// PCA has not wrapped
+			}else{
+				dt = (double)dms * 1000.0;			// long gap, 1 ms resolution
+			}
+		}
+		tabs += dt;
+		switch(ev[i] & 0xe0){
+			case TRC_KEY:
+				key = ev[i] & 0x01;
+				break;
+
+			case TRC_SPI:
+				if((ev[i] & 0x07) == 4){
+					rf = ((ev[i] & 0x18) == 0x18);
+				}
+				break;
+
+			case TRC_PTT:
+				break;
+
+			case TRC_CLK:
+				lo = ev[i] & 0x01;
+				break;
+		}
+		ev_text(ev[i], txt);
+		printf("%11.1f %11.1f  %s %s  %s\n", tabs, dt, key ? "###" : " | ", rf ? "##" : "| ", txt);
+	}
+	return 0;
+}
@@ -1,44 +1,104 @@
-/*************************************************************************
- *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
- *
- *  File name: typedef.h
- *
- *  Module:    Control
- *
- *  Summary:   This header contains the variable declaration definitions
- *       used by all modules of the system.  Maintains consistent type
- *		 syntax across various platforms.
- *
- *
- *******************************************************************/
-
-/********************************************************************
- *  File Version History:
- *    Ver 1  :  05-10-13 jmh : Initial Release
- *
- ********************************************************************/
-
-/********************************************************************
- *  File scope declarations revision history:
- *    05-10-13   jmh:  creation date
- *
- *******************************************************************/
-
-
-/* data definitions */
-
-#define U8                 unsigned char
-#define S8                 signed char
-#define U16                unsigned int
-#define S16                signed int
-#define U32                unsigned long
-#define S32                signed long
-#define F32                float
-#define F64                double
-#define BOOL               unsigned char
-
-#define TRUE               1
-#define FALSE              0
-
-
-#define TYPEDEF_INCLUDED
+/*************************************************************************
+ *********** COPYRIGHT (c) 2016 by Joseph Haas (DBA FF Systems)  *********
+ *
+ *  File name: typedef.h
+ *
+ *  Module:    Control
+ *
+ *  Summary:   This header contains the variable declaration definitions
+ *       used by all modules of the system.  Maintains consistent type
+ *		 syntax across various platforms.
+ *
+ *
+ *******************************************************************/
+
+/********************************************************************
+ *  File Version History:
+ *    Ver 1  :  05-10-13 jmh : Initial Release
+ *
+ ********************************************************************/
+
+/********************************************************************
+ *  File scope declarations revision history:
+ *    05-10-13   jmh:  creation date
+ *    10-19-26:        exact width types for host builds
+ *    10-19-26:        HOST_SIM: memory qualifiers, bit, and ISR macros for the host simulator (sim/)
+ *
+ *******************************************************************/
+
+
+/* data definitions.  C51 and SDCC have a 16 bit int and a 32 bit long.  Host builds
+ *	(tools/, sim/) use the exact width types so that U16/U32 math wraps as it does on
+ *	the target (a 64 bit host long would hide a U32 overflow). */
+
+#if defined __C51__ || defined SDCC
+#define U8                 unsigned char
+#define S8                 signed char
+#define U16                unsigned int
+#define S16                signed int
+#define U32                unsigned long
+#define S32                signed long
+#else
+#include <stdint.h>
+#define U8                 uint8_t
+#define S8                 int8_t
+#define U16                uint16_t
+#define S16                int16_t
+#define U32                uint32_t
+#define S32                int32_t
+#endif
+#define F32                float
+#define F64                double
+#define BOOL               unsigned char
+
+#define TRUE               1
+#define FALSE              0
+
+/* compiler portability.  Keil C51 is the reference build, SDCC (--model-small) is also
+ *	accepted.  Names match compiler_defs.h, so files that include it get the same macros. */
+
+#ifndef INTERRUPT
+#if defined HOST_SIM
+#define INTERRUPT(name, vector)							void name (void)
+#define INTERRUPT_USING(name, vector, regnum)			void name (void)
+#define INTERRUPT_PROTO(name, vector)					void name (void)
+#define INTERRUPT_PROTO_USING(name, vector, regnum)	void name (void)
+#define LOCATED_VARIABLE_NO_INIT(name, vartype, locsegment, addr) vartype name __attribute__((section("noinit")))
+#elif defined SDCC
+#define INTERRUPT(name, vector)							void name (void) __interrupt (vector)
+#define INTERRUPT_USING(name, vector, regnum)			void name (void) __interrupt (vector) __using (regnum)
+#define INTERRUPT_PROTO(name, vector)					void name (void) __interrupt (vector)
+#define INTERRUPT_PROTO_USING(name, vector, regnum)	void name (void) __interrupt (vector) __using (regnum)
+#define LOCATED_VARIABLE_NO_INIT(name, vartype, locsegment, addr) locsegment __at (addr) vartype name
+#else
+#define INTERRUPT(name, vector)							void name (void) interrupt vector
+#define INTERRUPT_USING(name, vector, regnum)			void name (void) interrupt vector using regnum
+#define INTERRUPT_PROTO(name, vector)					void name (void)
+#define INTERRUPT_PROTO_USING(name, vector, regnum)	void name (void)
+#define LOCATED_VARIABLE_NO_INIT(name, vartype, locsegment, addr) vartype locsegment name _at_ addr
+#endif
+#endif
+
+/* host simulator build (sim/).  The 8051 memory space qualifiers drop out, bit is a C bool,
+ *	and the ISRs are plain fns that the simulator calls.  The "noinit" section stands in for
+ *	upper idata: the simulator carries it over a (non power-on) reset. */
+#if defined HOST_SIM
+#define bit                _Bool
+#define code
+#define data
+#define idata
+#define xdata
+#define pdata
+#define bdata
+#endif
+
+/* byte index of the MS byte when a U32 is overlaid with U8[4].  C51 is big-endian,
+ *	SDCC (and the x86/ARM hosts) little-endian.  Use b[i ^ U32_MSB] to walk the bytes MS first. */
+#if defined __C51__
+#define U32_MSB            0
+#else
+#define U32_MSB            3
+#endif
+
+
+#define TYPEDEF_INCLUDED